@@ -0,0 +1,40 @@
+#pragma once
+#include <G3D/G3D.h>
+
+/** Simple name=value command line parameters */
+class BenchArgs {
+protected:
+	Table<String, String> m_values;
+public:
+	BenchArgs(int argc, const char** argv) {
+		for (int i = 1; i < argc; i++) {
+			const String arg = argv[i];
+			const size_t eq = arg.find('=');
+			if (eq == String::npos) {
+				logPrintf("Ignoring argument \"%s\" (expected name=value)\n", arg.c_str());
+				continue;
+			}
+			m_values.set(arg.substr(0, eq), arg.substr(eq + 1));
+		}
+	}
+
+	String get(const String& name, const String& defaultValue) const {
+		const String* value = m_values.getPointer(name);
+		return isNull(value) ? defaultValue : *value;
+	}
+	int getInt(const String& name, int defaultValue) const {
+		const String* value = m_values.getPointer(name);
+		return isNull(value) ? defaultValue : std::stoi(value->c_str());
+	}
+	float getFloat(const String& name, float defaultValue) const {
+		const String* value = m_values.getPointer(name);
+		return isNull(value) ? defaultValue : std::stof(value->c_str());
+	}
+};
+
+/** Get the value at a given percentile (0-1) of a set of samples (sorts the samples) */
+inline float percentile(Array<float>& samples, float p) {
+	if (samples.size() == 0) return 0.0f;
+	samples.sort();
+	return samples[min(samples.size() - 1, (int)(p * samples.size()))];
+}
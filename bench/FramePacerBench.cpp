@@ -0,0 +1,110 @@
+/** Frame pacer benchmark
+
+	Runs each frame pacer (see the "framePacer" render setting) against a set of frame time schedules with synthetic
+	per-frame work, then reports the achieved frame time error percentiles (actual - target frame time) for each.
+
+	Usage: FPSci.pacerbench [name=value ...] where the (optional) parameters are:
+		config=					Experiment config file to take the schedules from (one per session w/ its frameTimeArray and
+								frameTimeRandomize, or frameRate if the array is empty, always as if in the task state),
+								uses 240, 360, 500, and 1000 Hz and a cycle of these if not set
+		frames=2000				Number of frames to run for each schedule and pacer
+		workMs=0.5				Maximum synthetic work (busy CPU time) per frame, each frame does 50-100% of this
+		spinMarginMs=1.0		Value for the "framePacerSpinMarginMs" render setting
+*/
+#include <G3D/G3D.h>
+#include "FramePacer.h"
+#include "FrameTimeSchedule.h"
+#include "ExperimentConfig.h"
+#include "BenchArgs.h"
+
+G3D_START_AT_MAIN();
+
+using BenchClock = FramePacer::Clock;
+
+/** A named frame time schedule (always in the task state) */
+struct Schedule {
+	String				name;
+	FrameTimeSchedule	frameTimes;
+};
+
+/** A pacer configuration to benchmark */
+struct PacerMode {
+	String	name;
+	String	framePacer;
+	bool	timingThread;
+};
+
+/** Busy the CPU for a duration (standing in for a frame's input, simulation, and rendering) */
+static void doWork(double seconds) {
+	const auto end = BenchClock::now() + std::chrono::duration_cast<BenchClock::duration>(std::chrono::duration<double>(seconds));
+	while (BenchClock::now() < end) {}
+}
+
+static Array<Schedule> loadSchedules(const String& configFilename) {
+	Array<Schedule> schedules;
+	if (configFilename.empty()) {
+		for (float rate : { 240.0f, 360.0f, 500.0f, 1000.0f }) {
+			schedules.append(Schedule{ format("%.0f Hz", rate), FrameTimeSchedule(Array<float>(), false, FrameTimeMode::Always, 1.0f / rate, 0) });
+		}
+		const Array<float> mixed = { 1.0f / 240.0f, 1.0f / 360.0f, 1.0f / 500.0f, 1.0f / 1000.0f };
+		schedules.append(Schedule{ "mixed", FrameTimeSchedule(mixed, false, FrameTimeMode::Always, 1.0f / 240.0f, 0) });
+		return schedules;
+	}
+
+	ExperimentConfig experimentConfig = ExperimentConfig::load(configFilename);
+	Array<String> ids;
+	experimentConfig.getSessionIds(ids);
+	for (const String& id : ids) {
+		const RenderConfig& render = experimentConfig.getSharedSessionConfigById(id)->render;
+		if (render.frameTimeArray.size() == 0 && render.frameRate <= 0.0f) continue;		// Not paced
+		const uint32 seed = render.frameTimeSeed >= 0 ? (uint32)render.frameTimeSeed : 0;
+		schedules.append(Schedule{ id, FrameTimeSchedule(render.frameTimeArray, render.frameTimeRandomize, FrameTimeMode::Always, 1.0f / render.frameRate, seed) });
+	}
+	return schedules;
+}
+
+int main(int argc, const char** argv) {
+	initG3D();
+
+	const BenchArgs args(argc, argv);
+	const int frameCount = args.getInt("frames", 2000);
+	const float workMs = args.getFloat("workMs", 0.5f);
+	const float spinMarginMs = args.getFloat("spinMarginMs", 1.0f);
+	const Array<Schedule> schedules = loadSchedules(args.get("config", ""));
+	const Array<PacerMode> modes = {
+		{ "sleep", "sleep", false },
+		{ "hybrid", "hybrid", false },
+		{ "hybrid+thread", "hybrid", true },
+	};
+
+	logPrintf("Frame pacer benchmark: %d frames per schedule, %.3f ms max work/frame, %.3f ms spin margin\n", frameCount, workMs, spinMarginMs);
+	logPrintf("Frame time error (actual - target) in us:\n");
+	logPrintf("%-24s %-14s %10s %10s %10s %10s %10s %10s\n", "Schedule", "Pacer", "p1", "p50", "p90", "p99", "p99.9", "max |err|");
+
+	Random rng(0xF5C1, false);
+	for (const Schedule& schedule : schedules) {
+		for (const PacerMode& mode : modes) {
+			FrameTimeSchedule frameTimes = schedule.frameTimes;
+			shared_ptr<FramePacer> pacer = FramePacer::create(mode.framePacer, spinMarginMs, mode.timingThread);
+			Array<float> errorUs, absErrorUs;
+			errorUs.reserve(frameCount);
+
+			pacer->wait(0.0);		// Start the schedule now
+			BenchClock::time_point lastFrameEnd = BenchClock::now();
+			for (int f = 0; f < frameCount; f++) {
+				const float target = frameTimes.next(true);
+				doWork(rng.uniform(0.5f, 1.0f) * workMs / 1000.0);
+				pacer->wait(target);
+				const BenchClock::time_point frameEnd = BenchClock::now();
+				errorUs.append(std::chrono::duration<float, std::micro>(frameEnd - lastFrameEnd).count() - target * 1e6f);
+				absErrorUs.append(fabs(errorUs.last()));
+				lastFrameEnd = frameEnd;
+			}
+
+			logPrintf("%-24s %-14s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", schedule.name.c_str(), mode.name.c_str(),
+				percentile(errorUs, 0.01f), percentile(errorUs, 0.50f), percentile(errorUs, 0.90f), percentile(errorUs, 0.99f),
+				percentile(errorUs, 0.999f), percentile(absErrorUs, 1.0f));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,283 @@
+/** Headless FPSciLogger benchmark
+
+	Drives an FPSciLogger (no G3D window/app) with synthetic frame info, player action (aim), target trajectory and
+	trial streams, then reports sustained rows/s, producer-side enqueue latency, flush latency, and results file size.
+
+	Usage: FPSci.bench [name=value ...] where the (optional) parameters are:
+		frameRate=1000			Frames per second to produce (0 to produce as fast as possible)
+		targets=50				Number of targets (trajectory rows) per frame
+		seconds=10				Duration of the (synthetic) session
+		trialSeconds=5			Duration of each (synthetic) trial
+		out=loggerbench.db		Results file to write (deleted before the run)
+		journalMode=delete		Value for the "logJournalMode" logger setting
+		synchronous=full		Value for the "logSynchronousMode" logger setting
+		timestampFormat=text	Value for the "logTimestampFormat" logger setting
+		queueCapacity=16384		Value for the "logQueueCapacity" logger setting
+		overflowPolicy=spill	Value for the "logQueueOverflowPolicy" logger setting
+		columnar=0				Value for the "logToColumnarFile" logger setting (0 or 1)
+		trajectoryEncoding=float	Value for the "logTrajectoryEncoding" logger setting
+		journal=0				Value for the "logRecoveryJournal" logger setting (0 or 1)
+
+	Passing insertPath=string|prepared|both runs the insert path benchmark instead (no logger): synthetic Player_Action rows
+	are written straight to the results file, one transaction per (simulated) flush, either as string-built multi-row
+	inserts (insertRowsIntoDB, what FPSciLogger used to do) or through a PreparedInsert (what it does now), reporting rows/s
+	for each path. Its parameters (along w/ out, journalMode and synchronous above) are:
+		flushes=20				Number of flushes to write
+		rowsPerFlush=5000		Rows written per flush
+*/
+#include <G3D/G3D.h>
+#include "Logger.h"
+#include "FPSciApp.h"
+#include "BenchArgs.h"
+#include "sqlHelpers.h"
+#include <chrono>
+#include <thread>
+
+G3D_START_AT_MAIN();
+
+using BenchClock = std::chrono::steady_clock;
+
+/** Time a single enqueue call (in usec) */
+template<typename Fn> static inline void timeEnqueue(Array<float>& latencies, Fn enqueue) {
+	const auto start = BenchClock::now();
+	enqueue();
+	latencies.append(std::chrono::duration<float, std::micro>(BenchClock::now() - start).count());
+}
+
+/** Columns matching the Player_Action table (written by the insert path benchmark) */
+static const Array<Array<String>> s_playerActionColumns = {
+	{ "time", "text" },
+	{ "position_az", "real" },
+	{ "position_el", "real" },
+	{ "position_x", "real"},
+	{ "position_y", "real"},
+	{ "position_z", "real"},
+	{ "state", "text"},
+	{ "event", "text" },
+	{ "target_id", "text" },
+};
+
+/** Write flushCount * rowsPerFlush synthetic Player_Action rows to a fresh results file through the string-built or prepared
+	insert path (one transaction per flush), returns the rows/s written (or 0 if the rows weren't all written) */
+static double benchInsertPath(bool prepared, const String& filename, const String& journalMode, const String& synchronous, int flushCount, int rowsPerFlush) {
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+	sqlite3* db = nullptr;
+	if (sqlite3_open(filename.c_str(), &db) != SQLITE_OK) {
+		logPrintf("Could not open %s: %s\n", filename.c_str(), sqlite3_errmsg(db));
+		sqlite3_close(db);
+		return 0.0;
+	}
+	execStatementInDB(db, "PRAGMA journal_mode = " + journalMode + ";");
+	execStatementInDB(db, "PRAGMA synchronous = " + synchronous + ";");
+	createTableInDB(db, "Player_Action", s_playerActionColumns);
+
+	const auto start = BenchClock::now();
+	{
+		shared_ptr<PreparedInsert> insert = prepared ? PreparedInsert::create(db, "Player_Action", s_playerActionColumns.size()) : nullptr;
+		Array<Array<String>> rows;
+		for (int f = 0; f < flushCount; f++) {
+			beginTransactionInDB(db);
+			if (prepared) {
+				for (int i = 0; i < rowsPerFlush; i++) {
+					insert->bindText(format("2020-01-01 00:00:%02d.%06d", f % 60, i))
+						.bindReal(0.1f * i)
+						.bindReal(0.2f * i)
+						.bindReal(1.0f)
+						.bindReal(2.0f)
+						.bindReal(3.0f)
+						.bindText("trialTask")
+						.bindText("aim")
+						.bindText(format("target%d", i))
+						.insert();
+				}
+			}
+			else {
+				// Values are formatted (and quoted) for each row, as the string path did
+				rows.fastClear();
+				for (int i = 0; i < rowsPerFlush; i++) {
+					rows.append({
+						format("'2020-01-01 00:00:%02d.%06d'", f % 60, i),
+						format("%.9g", 0.1f * i),
+						format("%.9g", 0.2f * i),
+						format("%.9g", 1.0f),
+						format("%.9g", 2.0f),
+						format("%.9g", 3.0f),
+						"'trialTask'",
+						"'aim'",
+						format("'target%d'", i)
+					});
+				}
+				insertRowsIntoDB(db, "Player_Action", rows);
+			}
+			commitTransactionInDB(db);
+		}
+	}
+	const double secs = std::chrono::duration<double>(BenchClock::now() - start).count();
+
+	int64 rowCount = 0;
+	{
+		shared_ptr<PreparedQuery> count = PreparedQuery::create(db, "SELECT COUNT(*) FROM Player_Action;");
+		if (count->step()) rowCount = count->columnInt(0);
+	}
+	sqlite3_close(db);
+
+	const int64 totalRows = (int64)flushCount * rowsPerFlush;
+	int64 dbBytes = FileSystem::size(filename);
+	if (FileSystem::exists(filename + "-wal")) dbBytes += FileSystem::size(filename + "-wal");
+	logPrintf("%s %10.0f rows/s (%lld rows in %.3f s, %.2f MB)\n", prepared ? "Prepared insert:" : "String insert:  ", totalRows / secs,
+		(long long)rowCount, secs, dbBytes / (1024.0 * 1024.0));
+	if (rowCount != totalRows) {
+		logPrintf("\tExpected %lld rows!\n", (long long)totalRows);
+		return 0.0;
+	}
+	return totalRows / secs;
+}
+
+/** Compare rows/s of the string-built and prepared insert paths (see insertPath above) */
+static int runInsertBench(const BenchArgs& args, const String& insertPath) {
+	const int flushCount = args.getInt("flushes", 20);
+	const int rowsPerFlush = args.getInt("rowsPerFlush", 5000);
+	const String filename = args.get("out", "loggerbench.db");
+	const String journalMode = toLower(args.get("journalMode", "delete"));
+	const String synchronous = toLower(args.get("synchronous", "full"));
+	const String base = endsWith(filename, ".db") ? filename.substr(0, filename.size() - 3) : filename;
+
+	logPrintf("Insert path benchmark: %d flushes of %d rows, journalMode = %s, synchronous = %s\n", flushCount, rowsPerFlush,
+		journalMode.c_str(), synchronous.c_str());
+	double stringRate = -1.0, preparedRate = -1.0;
+	if (insertPath == "string" || insertPath == "both") {
+		stringRate = benchInsertPath(false, base + "_string.db", journalMode, synchronous, flushCount, rowsPerFlush);
+	}
+	if (insertPath == "prepared" || insertPath == "both") {
+		preparedRate = benchInsertPath(true, base + "_prepared.db", journalMode, synchronous, flushCount, rowsPerFlush);
+	}
+	if (stringRate > 0.0 && preparedRate > 0.0) logPrintf("Prepared/string: %.2fx\n", preparedRate / stringRate);
+	return (stringRate != 0.0 && preparedRate != 0.0) ? 0 : 1;
+}
+
+int main(int argc, const char** argv) {
+	initG3D();
+
+	const BenchArgs args(argc, argv);
+	const String insertPath = toLower(args.get("insertPath", ""));
+	if (!insertPath.empty()) {
+		if (insertPath != "string" && insertPath != "prepared" && insertPath != "both") {
+			logPrintf("Unknown insertPath \"%s\" (expected string, prepared, or both)\n", insertPath.c_str());
+			return 1;
+		}
+		return runInsertBench(args, insertPath);
+	}
+
+	const int frameRate = args.getInt("frameRate", 1000);
+	const int targetCount = args.getInt("targets", 50);
+	const float durationS = args.getFloat("seconds", 10.0f);
+	const float trialS = args.getFloat("trialSeconds", 5.0f);
+	const String filename = args.get("out", "loggerbench.db");
+
+	// Set up a session config w/ the requested logger settings
+	shared_ptr<SessionConfig> sessConfig = createShared<SessionConfig>();
+	sessConfig->id = "bench";
+	sessConfig->logger.journalMode = toLower(args.get("journalMode", sessConfig->logger.journalMode));
+	sessConfig->logger.synchronous = toLower(args.get("synchronous", sessConfig->logger.synchronous));
+	sessConfig->logger.timestampFormat = toLower(args.get("timestampFormat", sessConfig->logger.timestampFormat));
+	sessConfig->logger.queueCapacity = args.getInt("queueCapacity", sessConfig->logger.queueCapacity);
+	sessConfig->logger.queueOverflowPolicy = args.get("overflowPolicy", sessConfig->logger.queueOverflowPolicy);
+	sessConfig->logger.logToColumnarFile = args.getInt("columnar", 0) != 0;
+	sessConfig->logger.trajectoryEncoding = toLower(args.get("trajectoryEncoding", sessConfig->logger.trajectoryEncoding));
+	sessConfig->logger.logRecoveryJournal = args.getInt("journal", 0) != 0;
+
+	const String columnarFilename = (endsWith(filename, ".db") ? filename.substr(0, filename.size() - 3) : filename) + "_bench.fpcol";
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+	if (FileSystem::exists(columnarFilename)) FileSystem::removeFile(columnarFilename);
+	const int frameCount = (frameRate > 0) ? (int)(durationS * frameRate) : (int)(durationS * 1000);
+	const float frameDt = 1.0f / ((frameRate > 0) ? frameRate : 1000);
+	const int framesPerTrial = max(1, (int)(trialS / frameDt));
+
+	logPrintf("Logger benchmark: %d frames @ %d Hz (%s), %d targets, %d frames/trial -> %s\n", frameCount, frameRate,
+		frameRate > 0 ? "paced" : "unpaced", targetCount, framesPerTrial, filename.c_str());
+	logPrintf("\tjournalMode = %s, synchronous = %s, timestampFormat = %s, queueCapacity = %d, overflowPolicy = %s, trajectoryEncoding = %s\n",
+		sessConfig->logger.journalMode.c_str(), sessConfig->logger.synchronous.c_str(), sessConfig->logger.timestampFormat.c_str(),
+		sessConfig->logger.queueCapacity, sessConfig->logger.queueOverflowPolicy.c_str(), sessConfig->logger.trajectoryEncoding.c_str());
+
+	const String expConfigFilename = "loggerbench_experimentconfig.Any";
+	const ExperimentConfig expConfig = ExperimentConfig::load(expConfigFilename);		// Creates a default config (if needed)
+	const ExperimentInfo experiment = { expConfigFilename, expConfig.description, expConfig.hash() };
+	shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "bench", experiment, sessConfig, "Logger benchmark");
+
+	// Synthetic target names (so string construction isn't measured as part of the enqueue)
+	Array<String> targetNames;
+	for (int t = 0; t < targetCount; t++) targetNames.append(format("target%d", t));
+
+	Array<float> enqueueUs;
+	enqueueUs.reserve(frameCount * (targetCount + 2));
+	int64 expectedRows = 0;
+	int trialIdx = 0;
+	FPSciTimestamp trialStart = FPSciClock::now();
+
+	const auto start = BenchClock::now();
+	auto nextFrame = start;
+	for (int f = 0; f < frameCount; f++) {
+		if (frameRate > 0) {
+			// Pace the producer w/ absolute deadlines (so late frames are caught up on)
+			std::this_thread::sleep_until(nextFrame);
+			nextFrame += std::chrono::duration_cast<BenchClock::duration>(std::chrono::duration<double>(frameDt));
+		}
+		const float simT = f * frameDt;
+		const FPSciTimestamp now = FPSciClock::now();
+
+		timeEnqueue(enqueueUs, [&] { logger->logFrameInfo(FrameInfo(now, frameDt)); });
+		const Point2 view = Point2(sin(simT) * 30.0f, cos(simT) * 10.0f);
+		timeEnqueue(enqueueUs, [&] { logger->logPlayerAction(PlayerAction(now, view, Point3(0, 1.5f, 0), PresentationState::trialTask, PlayerActionType::Aim, "")); });
+		for (int t = 0; t < targetCount; t++) {
+			const Point3 pos = Point3(10.0f * cos(simT + t), 2.0f + sin(simT * 2.0f + t), 10.0f * sin(simT + t));
+			timeEnqueue(enqueueUs, [&] { logger->logTargetLocation(TargetLocation(now, targetNames[t], PresentationState::trialTask, pos)); });
+		}
+		expectedRows += targetCount + 2;
+
+		if ((f + 1) % framesPerTrial == 0) {
+			TrialValues trial;
+			trial.trialId = 0;
+			trial.trialIndex = trialIdx++;
+			trial.block = 1;
+			trial.startTime = trialStart;
+			trial.endTime = now;
+			trial.taskExecutionTime = trialS;
+			trial.destroyedTargets = targetCount;
+			trial.totalTargets = targetCount;
+			timeEnqueue(enqueueUs, [&] { logger->logTrial(trial); });
+			expectedRows++;
+			trialStart = now;
+		}
+	}
+	const double produceSecs = std::chrono::duration<double>(BenchClock::now() - start).count();
+
+	// Wait (up to a minute) for the logger thread to write everything out
+	std::future<void> flushed = logger->flushAsync();
+	if (flushed.wait_for(std::chrono::seconds(60)) != std::future_status::ready) {
+		logPrintf("Timed out waiting for the logger to flush!\n");
+	}
+	const LoggerFlushStats stats = logger->flushStats();
+	const double totalSecs = std::chrono::duration<double>(BenchClock::now() - start).count();
+	logger.reset();
+
+	int64 dbBytes = FileSystem::size(filename);
+	if (FileSystem::exists(filename + "-wal")) dbBytes += FileSystem::size(filename + "-wal");
+
+	const int enqueueCount = enqueueUs.size();
+	const float p50 = percentile(enqueueUs, 0.50f);
+	const float p99 = percentile(enqueueUs, 0.99f);
+	const float p999 = percentile(enqueueUs, 0.999f);
+	const float maxUs = enqueueCount > 0 ? enqueueUs.last() : 0.0f;
+
+	logPrintf("\nRows:            %lld written of %lld produced in %.3f s (%.3f s producing)\n", (long long)stats.rowCount, (long long)expectedRows, totalSecs, produceSecs);
+	logPrintf("Sustained:       %.0f rows/s\n", stats.rowCount / totalSecs);
+	logPrintf("Enqueue latency: p50 = %.3f us, p99 = %.3f us, p99.9 = %.3f us, max = %.3f us (%d calls)\n", p50, p99, p999, maxUs, enqueueCount);
+	logPrintf("Flush latency:   mean = %.3f ms, max = %.3f ms (%d flushes)\n", stats.flushCount > 0 ? 1000.0 * stats.totalSecs / stats.flushCount : 0.0, 1000.0 * stats.maxSecs, stats.flushCount);
+	logPrintf("Results file:    %.2f MB (%.1f bytes/row)\n", dbBytes / (1024.0 * 1024.0), stats.rowCount > 0 ? (double)dbBytes / stats.rowCount : 0.0);
+	if (FileSystem::exists(columnarFilename)) {
+		const int64 columnarBytes = FileSystem::size(columnarFilename);
+		logPrintf("Columnar file:   %.2f MB (%.1f bytes/row)\n", columnarBytes / (1024.0 * 1024.0), stats.rowCount > 0 ? (double)columnarBytes / stats.rowCount : 0.0);
+	}
+
+	return (stats.rowCount == expectedRows) ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+import struct
+import numpy as np
+
+FILE_MAGIC = b'FPSCICOL'
+ROW_GROUP_MAGIC = b'RGRP'
+
+# Column encodings (see ColumnarWriter.h)
+TIME_DELTA_VARINT = 1
+FLOAT32 = 2
+STRING_DICTIONARY = 3
+QUANTIZED_DELTA = 4
+
+def _readVarint(buf, pos):
+    """Read an (unsigned) LEB128 varint from buf at pos, returns (value, new position)"""
+    value = 0
+    shift = 0
+    while True:
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7f) << shift
+        if b < 0x80: return value, pos
+        shift += 7
+
+def _readString(buf, pos):
+    length, pos = _readVarint(buf, pos)
+    return buf[pos:pos+length].decode('utf-8'), pos + length
+
+def _decodeVarints(buf, count):
+    """Decode count consecutive varints from buf"""
+    values = np.empty(count, dtype=np.uint64)
+    pos = 0
+    for i in range(count):
+        values[i], pos = _readVarint(buf, pos)
+    return values, pos
+
+def _unzigzag(zz):
+    return (zz >> np.uint64(1)).astype(np.int64) ^ -(zz & np.uint64(1)).astype(np.int64)
+
+def _decodeQuantizedDelta(data, rowCount, groupColumns, streams):
+    """Decode a quantized (per key) delta column, groupColumns holds the (already decoded) columns of this row group and
+    streams the last quantized value of each key from earlier row groups (deltas continue across row groups)"""
+    (step,) = struct.unpack_from('<d', data, 0)
+    keyColumn, pos = _readString(data, 8)
+    packed, _ = _decodeVarints(data[pos:], rowCount)
+    keyframe = (packed & np.uint64(1)).astype(bool)
+    values = _unzigzag(packed >> np.uint64(1))
+    keys = groupColumns[keyColumn] if keyColumn else np.zeros(rowCount, dtype=np.int64)
+    quantized = np.empty(rowCount, dtype=np.int64)
+    for key in np.unique(keys):
+        idx = np.nonzero(keys == key)[0]
+        v = values[idx].copy()
+        kf = keyframe[idx].copy()
+        if not kf[0]:
+            # Continue from the stream's last value in an earlier row group (the first sample of each key is a keyframe)
+            v[0] += streams[key]
+            kf[0] = True
+        total = np.cumsum(v)
+        # Each keyframe starts a new running sum
+        starts = np.nonzero(kf)[0]
+        segment = np.cumsum(kf) - 1
+        quantized[idx] = total - (total[starts] - v[starts])[segment]
+        streams[key] = quantized[idx[-1]]
+    return quantized * step
+
+def _decodeColumn(colType, data, rowCount, groupColumns, streams):
+    if colType == TIME_DELTA_VARINT:
+        zz, _ = _decodeVarints(data, rowCount)
+        return np.cumsum(_unzigzag(zz))
+    elif colType == FLOAT32:
+        return np.frombuffer(data, dtype='<f4', count=rowCount)
+    elif colType == STRING_DICTIONARY:
+        dictSize, pos = _readVarint(data, 0)
+        dictionary = []
+        for _ in range(dictSize):
+            entry, pos = _readString(data, pos)
+            dictionary.append(entry)
+        indices, _ = _decodeVarints(data[pos:], rowCount)
+        return np.array(dictionary, dtype=object)[indices.astype(np.int64)]
+    elif colType == QUANTIZED_DELTA:
+        return _decodeQuantizedDelta(data, rowCount, groupColumns, streams)
+    raise Exception('Unknown column type {0}'.format(colType))
+
+def readColumnarFile(filename):
+    """Read an FPSci columnar results file into a dictionary of {table name: {column name: numpy array}}.
+    Time columns are int64 microseconds since the (Unix) epoch, quantized (delta encoded) columns are float64 values
+    (rounded to the logged precision). A truncated final row group (e.g. from a crash) is ignored."""
+    with open(filename, 'rb') as f:
+        buf = f.read()
+    if buf[0:8] != FILE_MAGIC: raise Exception('{0} is not an FPSci columnar results file!'.format(filename))
+    (version,) = struct.unpack_from('<I', buf, 8)
+    # Version 1 files start each row group w/ keyframes, so are decoded the same as version 2 files
+    if version not in (1, 2): raise Exception('Unsupported columnar results file version {0}'.format(version))
+
+    chunks = {}         # Table name -> column name -> list of arrays (one per row group)
+    streams = {}        # Table name -> column name -> {key: last quantized value} (for quantized delta columns)
+    pos = 12
+    while pos + 8 <= len(buf):
+        if buf[pos:pos+4] != ROW_GROUP_MAGIC: raise Exception('Corrupt row group at byte {0} in {1}'.format(pos, filename))
+        (length,) = struct.unpack_from('<I', buf, pos + 4)
+        start = pos + 8
+        if start + length > len(buf): break         # Truncated (final) row group
+        body = buf[start:start+length]
+        pos = start + length
+
+        table, p = _readString(body, 0)
+        rowCount, p = _readVarint(body, p)
+        columnCount, p = _readVarint(body, p)
+        columns = chunks.setdefault(table, {})
+        groupColumns = {}
+        for _ in range(columnCount):
+            name, p = _readString(body, p)
+            colType = body[p]
+            size, p = _readVarint(body, p + 1)
+            columnStreams = streams.setdefault(table, {}).setdefault(name, {})
+            groupColumns[name] = _decodeColumn(colType, body[p:p+size], rowCount, groupColumns, columnStreams)
+            columns.setdefault(name, []).append(groupColumns[name])
+            p += size
+
+    return {table: {name: np.concatenate(arrays) for name, arrays in columns.items()} for table, columns in chunks.items()}
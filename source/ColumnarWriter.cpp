@@ -0,0 +1,190 @@
+#include "ColumnarWriter.h"
+#include <cstring>
+#include <cmath>
+
+static const char s_fileMagic[8] = { 'F', 'P', 'S', 'C', 'I', 'C', 'O', 'L' };
+static const char s_rowGroupMagic[4] = { 'R', 'G', 'R', 'P' };
+
+ColumnarWriter::ColumnarWriter(const String& filename) : m_filename(filename) {
+	const bool newFile = !FileSystem::exists(filename);
+	if (!newFile) {
+		// Keep appending in the format of the existing file (version 1 readers decode each row group on its own)
+		FILE* existing = fopen(filename.c_str(), "rb");
+		uint8 header[sizeof(s_fileMagic) + 4] = {};
+		if (notNull(existing) && fread(header, 1, sizeof(header), existing) == sizeof(header)) {
+			const uint32 existingVersion = header[8] | (header[9] << 8) | (header[10] << 16) | ((uint32)header[11] << 24);
+			m_keyframeEachRowGroup = existingVersion < 2;
+		}
+		if (notNull(existing)) fclose(existing);
+	}
+	m_file = fopen(filename.c_str(), "ab");
+	if (isNull(m_file)) {
+		logPrintf("Error opening columnar results file: %s\n", filename.c_str());
+		return;
+	}
+	if (newFile) {
+		Array<uint8> header;
+		writeBytes(header, s_fileMagic, sizeof(s_fileMagic));
+		writeUint32(header, version);
+		fwrite(header.getCArray(), 1, header.size(), m_file);
+		fflush(m_file);
+	}
+}
+
+ColumnarWriter::~ColumnarWriter() {
+	if (notNull(m_file)) fclose(m_file);
+}
+
+void ColumnarWriter::writeBytes(Array<uint8>& buf, const void* bytes, size_t count) {
+	const int start = buf.size();
+	buf.resize(start + (int)count);
+	memcpy(buf.getCArray() + start, bytes, count);
+}
+
+void ColumnarWriter::writeVarint(Array<uint8>& buf, uint64 value) {
+	while (value >= 0x80) {
+		buf.append((uint8)(value | 0x80));
+		value >>= 7;
+	}
+	buf.append((uint8)value);
+}
+
+void ColumnarWriter::writeString(Array<uint8>& buf, const String& str) {
+	writeVarint(buf, str.size());
+	writeBytes(buf, str.c_str(), str.size());
+}
+
+void ColumnarWriter::writeUint32(Array<uint8>& buf, uint32 value) {
+	for (int i = 0; i < 4; i++) buf.append((uint8)(value >> (8 * i)));
+}
+
+void ColumnarWriter::writeFloat64(Array<uint8>& buf, double value) {
+	uint64 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	for (int i = 0; i < 8; i++) buf.append((uint8)(bits >> (8 * i)));
+}
+
+void ColumnarWriter::beginRowGroup(const String& tableName, int rowCount) {
+	m_tableName = tableName;
+	m_rowCount = rowCount;
+	m_columnCount = 0;
+	m_columns.fastClear();
+	if (m_keyframeEachRowGroup) m_deltaStreams.clear();
+}
+
+void ColumnarWriter::addColumn(const String& name, ColumnType type, const Array<uint8>& values) {
+	writeString(m_columns, name);
+	m_columns.append((uint8)type);
+	writeVarint(m_columns, values.size());
+	m_columns.append(values);
+	m_columnCount++;
+}
+
+void ColumnarWriter::addTimeColumn(const String& name, const Array<int64>& values) {
+	debugAssert(values.size() == m_rowCount);
+	Array<uint8> encoded;
+	encoded.reserve(values.size() * 2);
+	int64 last = 0;
+	for (const int64 t : values) {
+		writeVarint(encoded, zigzag(t - last));
+		last = t;
+	}
+	addColumn(name, TimeDeltaVarint, encoded);
+}
+
+void ColumnarWriter::addFloatColumn(const String& name, const Array<float>& values) {
+	debugAssert(values.size() == m_rowCount);
+	Array<uint8> encoded;
+	encoded.reserve(values.size() * 4);
+	for (const float v : values) {
+		uint32 bits;
+		memcpy(&bits, &v, sizeof(bits));
+		writeUint32(encoded, bits);
+	}
+	addColumn(name, Float32, encoded);
+}
+
+void ColumnarWriter::addStringColumn(const String& name, const Array<String>& values) {
+	debugAssert(values.size() == m_rowCount);
+	// Build the dictionary (in order of first appearance) and the per-row indices
+	Table<String, int> indices;
+	Array<String> dictionary;
+	Array<uint8> encodedIndices;
+	encodedIndices.reserve(values.size());
+	for (const String& v : values) {
+		int* idx = indices.getPointer(v);
+		if (isNull(idx)) {
+			indices.set(v, dictionary.size());
+			writeVarint(encodedIndices, dictionary.size());
+			dictionary.append(v);
+		}
+		else {
+			writeVarint(encodedIndices, *idx);
+		}
+	}
+
+	Array<uint8> encoded;
+	writeVarint(encoded, dictionary.size());
+	for (const String& entry : dictionary) writeString(encoded, entry);
+	encoded.append(encodedIndices);
+	addColumn(name, StringDictionary, encoded);
+}
+
+void ColumnarWriter::addQuantizedDeltaColumn(const String& name, const Array<float>& values, double step,
+	const String& keyColumn, const Array<String>& keys, int keyframeInterval)
+{
+	debugAssert(values.size() == m_rowCount);
+	debugAssert(keys.size() == 0 || keys.size() == values.size());
+	debugAssert(step > 0.0);
+
+	// Streams continue from the previous row group of this table
+	Table<String, DeltaStreamState>& streams = m_deltaStreams.getCreate(m_tableName + "." + name);
+	const String singleStream = "";
+
+	Array<uint8> encoded;
+	encoded.reserve(values.size() * 2 + 16);
+	writeFloat64(encoded, step);
+	writeString(encoded, keyColumn);
+	for (int i = 0; i < values.size(); i++) {
+		const int64 q = (int64)llround(values[i] / step);
+		const String& key = keys.size() > 0 ? keys[i] : singleStream;
+		DeltaStreamState* state = streams.getPointer(key);
+		const bool keyframe = isNull(state) || state->sinceKeyframe >= keyframeInterval;
+		if (isNull(state)) {
+			streams.set(key, DeltaStreamState());
+			state = streams.getPointer(key);
+		}
+		// The low bit flags keyframes (absolute values), otherwise the value is a delta from this stream's last value
+		const int64 v = keyframe ? q : q - state->last;
+		writeVarint(encoded, (zigzag(v) << 1) | (keyframe ? 1 : 0));
+		state->last = q;
+		state->sinceKeyframe = keyframe ? 1 : state->sinceKeyframe + 1;
+	}
+	addColumn(name, QuantizedDelta, encoded);
+}
+
+bool ColumnarWriter::endRowGroup() {
+	if (!valid()) return false;
+
+	// Row group header is: magic, byte length (of everything after it), table name, row count, column count
+	Array<uint8> body;
+	writeString(body, m_tableName);
+	writeVarint(body, m_rowCount);
+	writeVarint(body, m_columnCount);
+	body.append(m_columns);
+
+	Array<uint8> group;
+	group.reserve(body.size() + 8);
+	writeBytes(group, s_rowGroupMagic, sizeof(s_rowGroupMagic));
+	writeUint32(group, (uint32)body.size());
+	group.append(body);
+
+	const size_t written = fwrite(group.getCArray(), 1, group.size(), m_file);
+	fflush(m_file);
+	m_columns.fastClear();
+	if (written != (size_t)group.size()) {
+		logPrintf("Error writing row group for table %s to columnar results file: %s\n", m_tableName.c_str(), m_filename.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <G3D/G3D.h>
+#include <cstdio>
+
+/** Append-only, columnar results file writer (see docs/resultsFiles.md for the file format).
+
+	Data is written as a series of self-describing "row groups" (one per table per logger flush), each of which
+	stores its rows column-by-column using a typed (and compact) encoding:
+		- Time columns are int64 (usec since epoch) stored as zigzag varint deltas from the previous row
+		- Real columns are stored as raw little-endian float32 values
+		- Text columns are dictionary encoded (per row group) w/ varint indices
+		- Quantized real columns are rounded to a fixed step, then stored as zigzag varint deltas from the previous
+		  sample with the same key (e.g. target id), w/ periodic (absolute valued) keyframes. Deltas continue across the
+		  row groups of a table (so row groups are decoded in order)
+	Each row group is written with a single fwrite (and flushed), so a crash can only ever truncate the last group.
+
+	Usage is: beginRowGroup(), add*Column() for each column (each w/ rowCount values), then endRowGroup(). */
+class ColumnarWriter : public ReferenceCountedObject {
+public:
+	/** Column encodings (stored in the file) */
+	enum ColumnType : uint8 {
+		TimeDeltaVarint = 1,
+		Float32 = 2,
+		StringDictionary = 3,
+		QuantizedDelta = 4
+	};
+
+	static const uint32 version = 2;			///< Version 2 continues quantized deltas across row groups (version 1 starts each row group w/ keyframes)
+
+protected:
+	FILE*			m_file = nullptr;			///< The output file (opened for append)
+	String			m_filename;					///< Name of the output file
+	Array<uint8>	m_columns;					///< Encoded columns for the current row group
+	String			m_tableName;				///< Table name for the current row group
+	int				m_rowCount = 0;				///< Number of rows in the current row group
+	int				m_columnCount = 0;			///< Number of columns added to the current row group
+
+	/** Last quantized value and samples since the last keyframe for a (quantized delta) stream */
+	struct DeltaStreamState {
+		int64	last = 0;
+		int		sinceKeyframe = 0;
+	};
+	Table<String, Table<String, DeltaStreamState>>	m_deltaStreams;		///< Stream state for each key of each quantized column ("table.column")
+	bool			m_keyframeEachRowGroup = false;	///< Start each row group w/ keyframes (when appending to a version 1 file)
+
+	static void writeBytes(Array<uint8>& buf, const void* bytes, size_t count);
+	static void writeVarint(Array<uint8>& buf, uint64 value);
+	static void writeString(Array<uint8>& buf, const String& str);
+	static void writeUint32(Array<uint8>& buf, uint32 value);
+	static void writeFloat64(Array<uint8>& buf, double value);
+	static inline uint64 zigzag(int64 value) { return ((uint64)value << 1) ^ (uint64)(value >> 63); }
+
+	/** Append an (already encoded) column to the current row group */
+	void addColumn(const String& name, ColumnType type, const Array<uint8>& values);
+
+public:
+	ColumnarWriter(const String& filename);
+	virtual ~ColumnarWriter();
+
+	static shared_ptr<ColumnarWriter> create(const String& filename) {
+		return createShared<ColumnarWriter>(filename);
+	}
+
+	bool valid() const { return notNull(m_file); }
+	const String& filename() const { return m_filename; }
+
+	void beginRowGroup(const String& tableName, int rowCount);
+	void addTimeColumn(const String& name, const Array<int64>& values);
+	void addFloatColumn(const String& name, const Array<float>& values);
+	void addStringColumn(const String& name, const Array<String>& values);
+	/** Add a real-valued column quantized to step (so reconstruction error is at most step/2). Each value is stored as a
+		delta from the previous sample w/ the same key (in this or an earlier row group of the table), where keys holds the
+		values of the (previously added) keyColumn, or is empty (w/ an empty keyColumn) if all rows belong to a single stream.
+		The first sample written for each key, and every keyframeInterval-th sample after that, is stored as an absolute
+		(keyframe) value. */
+	void addQuantizedDeltaColumn(const String& name, const Array<float>& values, double step,
+		const String& keyColumn = "", const Array<String>& keys = Array<String>(), int keyframeInterval = 1000);
+	/** Write the current row group to the file */
+	bool endRowGroup();
+};
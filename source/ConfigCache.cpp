@@ -0,0 +1,243 @@
+#include "ConfigCache.h"
+#include <fstream>
+
+const uint32 ConfigCache::version;
+
+static const char s_cacheMagic[8] = { 'F', 'P', 'S', 'C', 'F', 'G', 'C', '\0' };
+static const uint64 s_fnvOffset = 14695981039346656037ULL;
+static const uint64 s_fnvPrime = 1099511628211ULL;
+static const int s_maxIncludeDepth = 8;
+
+/** Node types in the binary format (independent of the values of Any::Type) */
+enum class CachedType : uint8 { Nil = 0, Boolean, Number, String, Array, Table, EmptyContainer };
+
+static uint64 fnv1a(const String& bytes, uint64 hash) {
+	for (const char c : bytes) {
+		hash ^= (uint8)c;
+		hash *= s_fnvPrime;
+	}
+	return hash;
+}
+
+/** Append little-endian values to a binary buffer */
+class CacheWriter {
+public:
+	String data;
+
+	void writeUint8(uint8 v) { data += (char)v; }
+	void writeUint32(uint32 v) { for (int i = 0; i < 4; i++) data += (char)((v >> (8 * i)) & 0xFF); }
+	void writeUint64(uint64 v) { for (int i = 0; i < 8; i++) data += (char)((v >> (8 * i)) & 0xFF); }
+	void writeDouble(double v) {
+		uint64 bits;
+		memcpy(&bits, &v, sizeof(bits));
+		writeUint64(bits);
+	}
+	void writeString(const String& s) {
+		writeUint32((uint32)s.size());
+		data.append(s.c_str(), s.size());
+	}
+
+	void writeAny(const Any& any) {
+		switch (any.type()) {
+		case Any::NIL:
+			writeUint8((uint8)CachedType::Nil);
+			break;
+		case Any::BOOLEAN:
+			writeUint8((uint8)CachedType::Boolean);
+			writeUint8(any.boolean() ? 1 : 0);
+			break;
+		case Any::NUMBER:
+			writeUint8((uint8)CachedType::Number);
+			writeDouble(any.number());
+			break;
+		case Any::STRING:
+			writeUint8((uint8)CachedType::String);
+			writeString(any.string());
+			break;
+		case Any::ARRAY:
+			writeUint8((uint8)CachedType::Array);
+			writeString(any.name());
+			writeUint32((uint32)any.size());
+			for (const Any& element : any.array()) writeAny(element);
+			break;
+		case Any::TABLE: {
+			writeUint8((uint8)CachedType::Table);
+			writeString(any.name());
+			const Table<String, Any>& table = any.table();
+			const Array<String> keys = table.getKeys();
+			writeUint32((uint32)keys.size());
+			for (const String& key : keys) {
+				writeString(key);
+				writeAny(table[key]);
+			}
+			break;
+		}
+		default:		// Any::EMPTY_CONTAINER
+			writeUint8((uint8)CachedType::EmptyContainer);
+			writeString(any.name());
+			break;
+		}
+	}
+};
+
+/** Read little-endian values from a binary buffer (throws if reading past its end) */
+class CacheReader {
+protected:
+	const uint8*	m_pos;
+	const uint8*	m_end;
+
+	void require(size_t bytes) const {
+		if ((size_t)(m_end - m_pos) < bytes) throw String("Config cache data is truncated");
+	}
+
+public:
+	CacheReader(const String& data, size_t offset = 0) : m_pos((const uint8*)data.c_str() + offset), m_end((const uint8*)data.c_str() + data.size()) {}
+
+	bool atEnd() const { return m_pos == m_end; }
+
+	uint8 readUint8() {
+		require(1);
+		return *m_pos++;
+	}
+	uint32 readUint32() {
+		require(4);
+		uint32 v = 0;
+		for (int i = 0; i < 4; i++) v |= (uint32)m_pos[i] << (8 * i);
+		m_pos += 4;
+		return v;
+	}
+	uint64 readUint64() {
+		require(8);
+		uint64 v = 0;
+		for (int i = 0; i < 8; i++) v |= (uint64)m_pos[i] << (8 * i);
+		m_pos += 8;
+		return v;
+	}
+	double readDouble() {
+		const uint64 bits = readUint64();
+		double v;
+		memcpy(&v, &bits, sizeof(v));
+		return v;
+	}
+	String readString() {
+		const uint32 size = readUint32();
+		require(size);
+		const String s((const char*)m_pos, size);
+		m_pos += size;
+		return s;
+	}
+
+	Any readAny() {
+		const CachedType type = (CachedType)readUint8();
+		switch (type) {
+		case CachedType::Nil: return Any();
+		case CachedType::Boolean: return Any(readUint8() != 0);
+		case CachedType::Number: return Any(readDouble());
+		case CachedType::String: return Any(readString());
+		case CachedType::Array: {
+			Any a(Any::ARRAY, readString());
+			const uint32 count = readUint32();
+			for (uint32 i = 0; i < count; i++) a.append(readAny());
+			return a;
+		}
+		case CachedType::Table: {
+			Any t(Any::TABLE, readString());
+			const uint32 count = readUint32();
+			for (uint32 i = 0; i < count; i++) {
+				const String key = readString();
+				t.set(key, readAny());
+			}
+			return t;
+		}
+		case CachedType::EmptyContainer: return Any(Any::EMPTY_CONTAINER, readString());
+		default: throw format("Unknown config cache node type %d", (int)type);
+		}
+	}
+};
+
+/** Hash a file's contents followed by the contents of any files it #includes (recursively) */
+static bool hashFile(const String& filename, uint64& hash, int depth) {
+	if (depth > s_maxIncludeDepth || !FileSystem::exists(filename)) return false;
+	const String contents = readWholeFile(filename);
+	hash = fnv1a(contents, hash);
+
+	// Find each #include("filename") (includes are resolved relative to the including file, then as data files)
+	size_t pos = 0;
+	while ((pos = contents.find("#include", pos)) != String::npos) {
+		pos += 8;
+		const size_t start = contents.find('"', pos);
+		const size_t end = (start == String::npos) ? String::npos : contents.find('"', start + 1);
+		if (end == String::npos) return false;
+		const String includeName = contents.substr(start + 1, end - start - 1);
+		String includeFilename = FilePath::concat(FilePath::parent(filename), includeName);
+		if (!FileSystem::exists(includeFilename)) includeFilename = System::findDataFile(includeName, false);
+		if (includeFilename.empty() || !hashFile(includeFilename, hash, depth + 1)) return false;
+		pos = end + 1;
+	}
+	return true;
+}
+
+bool ConfigCache::hashSource(const String& filename, uint64& hash) {
+	hash = s_fnvOffset;
+	return hashFile(filename, hash, 0);
+}
+
+String ConfigCache::toBinary(const Any& any) {
+	CacheWriter writer;
+	writer.writeAny(any);
+	return writer.data;
+}
+
+Any ConfigCache::fromBinary(const String& data) {
+	CacheReader reader(data);
+	const Any any = reader.readAny();
+	if (!reader.atEnd()) throw String("Config cache data has trailing bytes");
+	return any;
+}
+
+Any ConfigCache::load(const String& filename, bool* fromCache) {
+	if (notNull(fromCache)) *fromCache = false;
+	uint64 hash;
+	if (directory().empty() || !hashSource(filename, hash)) return Any::fromFile(filename);
+
+	// Name the cache file after the (full) source path so configs w/ the same name in different directories don't collide
+	String cacheName = FilePath::canonicalize(filename);
+	for (char& c : cacheName) {
+		if (c == '/' || c == '\\' || c == ':') c = '_';
+	}
+	const String cacheFilename = FilePath::concat(directory(), cacheName + ".cache");
+
+	// Use the cached Any if its header matches this source
+	if (FileSystem::exists(cacheFilename)) {
+		try {
+			const String data = readWholeFile(cacheFilename);
+			if (data.size() >= sizeof(s_cacheMagic) && memcmp(data.c_str(), s_cacheMagic, sizeof(s_cacheMagic)) == 0) {
+				CacheReader reader(data, sizeof(s_cacheMagic));
+				if (reader.readUint32() == version && reader.readUint64() == hash && reader.readString() == filename) {
+					const Any any = reader.readAny();
+					if (reader.atEnd()) {
+						if (notNull(fromCache)) *fromCache = true;
+						return any;
+					}
+				}
+			}
+		}
+		catch (...) {}		// Invalid cache file, rewrite it below
+	}
+
+	// Parse the source and (re)write the cache
+	const Any any = Any::fromFile(filename);
+	CacheWriter writer;
+	writer.data.append(s_cacheMagic, sizeof(s_cacheMagic));
+	writer.writeUint32(version);
+	writer.writeUint64(hash);
+	writer.writeString(filename);
+	writer.writeAny(any);
+
+	if (!FileSystem::exists(directory())) FileSystem::createDirectory(directory());
+	std::ofstream out(cacheFilename.c_str(), std::ios::binary | std::ios::trunc);
+	out.write(writer.data.c_str(), writer.data.size());
+	if (!out) logPrintf("WARNING: Could not write config cache file %s\n", cacheFilename.c_str());
+	else logPrintf("Cached parsed config %s as %s\n", filename.c_str(), cacheFilename.c_str());
+	return any;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <G3D/G3D.h>
+
+/** Binary cache of parsed .Any config files (see the "configCacheDir" startup setting).
+
+	Parsing large .Any files (i.e. experiment configs w/ long waypoint destination arrays) can take seconds, so the parsed
+	Any is stored in a compact binary form the first time a config file is loaded. Later loads (at startup and on each
+	reloadConfigs) read the cache file w/ a single read if the source file (and any files it #includes) hasn't changed.
+
+	Each cache file holds a header (magic, version, the source path, and a 64-bit FNV-1a hash of the source file contents
+	followed by the contents of each file it #includes) then the Any tree. Every node is a 1 byte type followed by its
+	value: a double for numbers, a byte for booleans, a (4 byte length prefixed) string for strings, and the container name
+	and element count followed by the elements (w/ each element's key for tables) for containers. All values are
+	little-endian. Any cache file that doesn't match its source (or is truncated/corrupt) is ignored and rewritten. */
+class ConfigCache {
+public:
+	static const uint32 version = 1;
+
+	/** The directory cache files are written to (empty to disable the cache) */
+	static String& directory() {
+		static String dir;
+		return dir;
+	}
+
+	/** Load a (found) .Any file, from the cache if the source is unchanged (otherwise parse it and update the cache).
+		fromCache (if not null) is set to whether the Any was read from the cache. */
+	static Any load(const String& filename, bool* fromCache = nullptr);
+
+	/** Load a (found) .Any file into a config (of a type constructed from an Any).
+
+		An Any read from the cache has no source (file/line) information, so a parse or validation error thrown while
+		constructing the config from it wouldn't say where in the file the problem is. In that case the source file is
+		parsed again and the config constructed from that Any instead, so the error reports its location. */
+	template <class T>
+	static T loadConfig(const String& filename) {
+		bool fromCache = false;
+		const Any any = load(filename, &fromCache);
+		if (!fromCache) return T(any);
+		try {
+			return T(any);
+		}
+		catch (...) {
+			logPrintf("Error in cached config %s, parsing the source file to locate it\n", filename.c_str());
+		}
+		return T(Any::fromFile(filename));
+	}
+
+	/** Hash the contents of a file and any files it #includes, returns false if the file (or an include) can't be read */
+	static bool hashSource(const String& filename, uint64& hash);
+
+	/** Serialize an Any (tree) to/from the binary cache format (fromBinary throws a String if the data is invalid) */
+	static String toBinary(const Any& any);
+	static Any fromBinary(const String& data);
+};
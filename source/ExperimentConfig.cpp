@@ -1,4 +1,5 @@
 #include "ExperimentConfig.h"
+#include "ConfigCache.h"
 
 ExperimentConfig::ExperimentConfig(const Any& any) : FpsConfig(any) {
 	FPSciAnyTableReader reader(any);
@@ -56,18 +57,6 @@ void ExperimentConfig::init() {
 
 		targets.append(tJump);
 	}
-	else {
-		// Targets are present (make sure no 2 have the same ID)
-		Array<String> ids;
-		for (TargetConfig target : targets) {
-			if (!ids.contains(target.id)) { ids.append(target.id); }
-			else {
-				// This is a repeat entry, throw an exception
-				throw format("Found duplicate target configuration for target: \"%s\"", target.id);
-			}
-		}
-
-	}
 
 	if (sessions.size() == 0 && addedTargets) {
 		SessionConfig sess60;
@@ -86,6 +75,43 @@ void ExperimentConfig::init() {
 
 		sessions.append(sess30);
 	}
+
+	buildIndex();
+}
+
+void ExperimentConfig::buildIndex() {
+	// Index the targets (making sure no 2 have the same ID)
+	m_targetIndex.clear();
+	for (const TargetConfig& target : targets) {
+		if (m_targetIndex.containsKey(target.id)) {
+			// This is a repeat entry, throw an exception
+			throw format("Found duplicate target configuration for target: \"%s\"", target.id);
+		}
+		m_targetIndex.set(target.id, TargetConfig::createShared<TargetConfig>(target));
+	}
+
+	// Index the sessions (the first session w/ a given ID is used) and precompute their target tables
+	m_sessionIndex.clear();
+	for (int i = 0; i < sessions.size(); i++) {
+		const SessionConfig& session = sessions[i];
+		if (m_sessionIndex.containsKey(session.id)) continue;
+		SessionEntry entry;
+		entry.index = i;
+		entry.config = SessionConfig::createShared<SessionConfig>(session);
+		for (const TrialCount& trial : session.trials) {
+			Array<shared_ptr<const TargetConfig>>& trialTargets = entry.targetsByTrial.next();
+			for (const String& id : trial.ids) {
+				const shared_ptr<const TargetConfig>* indexed = m_targetIndex.getPointer(id);
+				const shared_ptr<const TargetConfig> target = isNull(indexed) ? nullptr : *indexed;
+				trialTargets.append(target);
+				if (!entry.targets.contains(target)) entry.targets.append(target);
+			}
+		}
+		m_sessionIndex.set(session.id, entry);
+	}
+
+	m_indexedSessionCount = sessions.size();
+	m_indexedTargetCount = targets.size();
 }
 
 ExperimentConfig ExperimentConfig::load(const String& filename, bool saveJSON) {
@@ -97,75 +123,61 @@ ExperimentConfig ExperimentConfig::load(const String& filename, bool saveJSON) {
 		ex.toAny().save(filename, saveJSON);				// Save the defaults
 	}
 	else {
-		ex = Any::fromFile(System::findDataFile(filename));	// Load from existing Any file
+		ex = ConfigCache::loadConfig<ExperimentConfig>(System::findDataFile(filename));	// Load from existing Any file (or its cached copy)
 	}
 	return ex;
 }
 
+String ExperimentConfig::hash() const {
+	const size_t hash = HashTrait<String>::hashCode(toAny().unparse());		// Hash the serialized Any (don't consider formatting)
+	return format("%x", hash);
+}
+
 void ExperimentConfig::getSessionIds(Array<String>& ids) const {
 	ids.fastClear();
 	for (const SessionConfig& session : sessions) { ids.append(session.id); }
 }
 
+const ExperimentConfig::SessionEntry& ExperimentConfig::getSessionEntry(const String& id) const {
+	debugAssertM(indexIsCurrent(), "Session/target index is stale, call buildIndex() after modifying sessions or targets");
+	const SessionEntry* entry = m_sessionIndex.getPointer(id);
+	if (isNull(entry)) throw format("Could not find session:\"%s\"", id);
+	return *entry;
+}
+
 shared_ptr<SessionConfig> ExperimentConfig::getSessionConfigById(const String& id) const {
-	for (const SessionConfig& session : sessions) {
-		if (!session.id.compare(id)) {
-			return SessionConfig::createShared<SessionConfig>(session);
-		}
-	}
-	return nullptr;
+	// Sessions modify their config (i.e. question results) so this returns a copy of the shared config
+	const shared_ptr<const SessionConfig> config = getSharedSessionConfigById(id);
+	if (isNull(config)) return nullptr;
+	return SessionConfig::createShared<SessionConfig>(*config);
+}
+
+shared_ptr<const SessionConfig> ExperimentConfig::getSharedSessionConfigById(const String& id) const {
+	debugAssertM(indexIsCurrent(), "Session/target index is stale, call buildIndex() after modifying sessions or targets");
+	const SessionEntry* entry = m_sessionIndex.getPointer(id);
+	return isNull(entry) ? nullptr : entry->config;
 }
 
 int ExperimentConfig::getSessionIndex(const String& id) const {
-	debugAssert(sessions.size() >= 0 && sessions.size() < 100000);
-	for (int i = 0; i < sessions.size(); ++i) {
-		if (!sessions[i].id.compare(id)) {
-			return i;
-		}
-	}
-	throw format("Could not find session:\"%s\"", id);
+	return getSessionEntry(id).index;
 }
 
-shared_ptr<TargetConfig> ExperimentConfig::getTargetConfigById(const String& id) const {
-	for (const TargetConfig& target : targets) {
-		if (!target.id.compare(id)) {
-			return TargetConfig::createShared<TargetConfig>(target);
-		}
-	}
-	return nullptr;
+shared_ptr<const TargetConfig> ExperimentConfig::getTargetConfigById(const String& id) const {
+	debugAssertM(indexIsCurrent(), "Session/target index is stale, call buildIndex() after modifying sessions or targets");
+	const shared_ptr<const TargetConfig>* target = m_targetIndex.getPointer(id);
+	return isNull(target) ? nullptr : *target;
 }
 
-Array<Array<shared_ptr<TargetConfig>>> ExperimentConfig::getTargetsByTrial(const String& id) const {
-	return getTargetsByTrial(getSessionIndex(id));
+const Array<Array<shared_ptr<const TargetConfig>>>& ExperimentConfig::getTargetsByTrial(const String& id) const {
+	return getSessionEntry(id).targetsByTrial;
 }
 
-Array<Array<shared_ptr<TargetConfig>>> ExperimentConfig::getTargetsByTrial(int sessionIndex) const {
-	Array<Array<shared_ptr<TargetConfig>>> trials;
-	// Iterate through the trials
-	for (int i = 0; i < sessions[sessionIndex].trials.size(); i++) {
-		Array<shared_ptr<TargetConfig>> targets;
-		for (String id : sessions[sessionIndex].trials[i].ids) {
-			const shared_ptr<TargetConfig> t = getTargetConfigById(id);
-			targets.append(t);
-		}
-		trials.append(targets);
-	}
-	return trials;
-}
-
-Array<shared_ptr<TargetConfig>> ExperimentConfig::getSessionTargets(const String& id) const {
-	const int idx = getSessionIndex(id);		// Get session index
-	Array<shared_ptr<TargetConfig>> targets;
-	Array<String> loggedIds;
-	for (auto trial : sessions[idx].trials) {
-		for (String& id : trial.ids) {
-			if (!loggedIds.contains(id)) {
-				loggedIds.append(id);
-				targets.append(getTargetConfigById(id));
-			}
-		}
-	}
-	return targets;
+const Array<Array<shared_ptr<const TargetConfig>>>& ExperimentConfig::getTargetsByTrial(int sessionIndex) const {
+	return getTargetsByTrial(sessions[sessionIndex].id);
+}
+
+const Array<shared_ptr<const TargetConfig>>& ExperimentConfig::getSessionTargets(const String& id) const {
+	return getSessionEntry(id).targets;
 }
 
 bool ExperimentConfig::validate(bool throwException) const {
@@ -12,21 +12,44 @@ public:
 	Array<TargetConfig> targets;						///< Array of trial configs   
 	bool closeOnComplete = false;						///< Close application on all sessions complete
 
+protected:
+	/** Lookup tables for a session (precomputed by buildIndex()) */
+	struct SessionEntry {
+		int												index = -1;			///< Index of the session in the sessions array
+		shared_ptr<const SessionConfig>					config;				///< Shared (read-only) copy of the session config
+		Array<Array<shared_ptr<const TargetConfig>>>	targetsByTrial;		///< Target configs for each trial (null for unknown target IDs)
+		Array<shared_ptr<const TargetConfig>>			targets;			///< Unique target configs used in this session (in order of first use)
+	};
+
+	Table<String, SessionEntry>						m_sessionIndex;		///< Session lookup by ID
+	Table<String, shared_ptr<const TargetConfig>>	m_targetIndex;		///< Shared (read-only) target configs by ID
+	int												m_indexedSessionCount = 0;	///< Size of the sessions array when last indexed
+	int												m_indexedTargetCount = 0;	///< Size of the targets array when last indexed
+
+	const SessionEntry& getSessionEntry(const String& id) const;		///< Get the lookup tables for a session (throws if the ID isn't found)
+
+	/** Cheap (constant time) check for sessions or targets being added/removed since the last buildIndex() (for debug asserts) */
+	bool indexIsCurrent() const { return sessions.size() == m_indexedSessionCount && targets.size() == m_indexedTargetCount; }
+
+public:
 	ExperimentConfig() { init(); }
 	ExperimentConfig(const Any& any);
 
 	void init();
+	void buildIndex();															// (Re)build the session/target lookup tables (call after modifying sessions or targets)
 	static ExperimentConfig load(const String& filename, bool saveJSON = false); // Get the experiment config from file
 	Any toAny(const bool forceAll = false) const;
+	String hash() const;														// Hash of the serialized config (independent of file formatting) as a hex string
 
 	void getSessionIds(Array<String>& ids) const;								// Get an array of session IDs
-	shared_ptr<SessionConfig> getSessionConfigById(const String& id) const;		// Get a session config based on its ID
+	shared_ptr<SessionConfig> getSessionConfigById(const String& id) const;		// Get a (modifiable) copy of a session config based on its ID
+	shared_ptr<const SessionConfig> getSharedSessionConfigById(const String& id) const;	// Get the shared (read-only) session config based on its ID (no copy)
 	int getSessionIndex(const String& id) const;								// Get the index of a session in the session array (by ID)
-	shared_ptr<TargetConfig> getTargetConfigById(const String& id) const;		// Get a pointer to a target config by ID
+	shared_ptr<const TargetConfig> getTargetConfigById(const String& id) const;	// Get the shared (read-only) target config by ID
 
-	Array<Array<shared_ptr<TargetConfig>>> getTargetsByTrial(const String& id) const;			// Get target configs by trial (not recommended for repeated calls)
-	Array<Array<shared_ptr<TargetConfig>>> getTargetsByTrial(int sessionIndex) const;			// Get target configs by trial (not recommended for repeated calls)
-	Array<shared_ptr<TargetConfig>> getSessionTargets(const String& id) const;					// Get all targets affiliated with a session (not recommended for repeated calls)
+	const Array<Array<shared_ptr<const TargetConfig>>>& getTargetsByTrial(const String& id) const;	// Get (shared) target configs by trial
+	const Array<Array<shared_ptr<const TargetConfig>>>& getTargetsByTrial(int sessionIndex) const;	// Get (shared) target configs by trial
+	const Array<shared_ptr<const TargetConfig>>& getSessionTargets(const String& id) const;			// Get all (shared) targets affiliated with a session
 
 	bool validate(bool throwException) const;									// Validate the session/target configuration
 
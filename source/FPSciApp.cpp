@@ -48,6 +48,9 @@ void FPSciApp::initExperiment(){
 		waypointManager = WaypointManager::create(this);
 	}
 
+	// Start the simulation worker threads (once)
+	if (isNull(jobSystem)) jobSystem = createShared<JobSystem>();
+
 	// Setup the scene
 	setScene(PhysicsScene::create(m_ambientOcclusion));
 	scene()->registerEntitySubclass("PlayerEntity", &PlayerEntity::create);			// Register the player entity for creation
@@ -172,8 +175,7 @@ void FPSciApp::loadConfigs(const ConfigFiles& configs) {
 	experimentConfig.validate(true);
 
 	// Get hash for experimentconfig.Any file
-	const size_t hash = HashTrait<String>::hashCode(experimentConfig.toAny().unparse());		// Hash the serialized Any (don't consider formatting)
-	m_expConfigHash = format("%x", hash);														// Store the hash as a hex string
+	m_expConfigHash = experimentConfig.hash();													// Store the hash as a hex string
 	logPrintf("Experiment hash: %s\r\n", m_expConfigHash);										// Write to log
 
 	Array<String> sessionIds;
@@ -208,103 +210,91 @@ void FPSciApp::loadModels() {
 	}
 
 	// Add all the unqiue targets to this list
-	Table<String, Any> targetsToBuild;
-	Table<String, String> explosionsToBuild;
-	Table<String, float> explosionScales;
-	for (TargetConfig target : experimentConfig.targets) {
-		targetsToBuild.set(target.id, target.modelSpec);
-		explosionsToBuild.set(target.id, target.destroyDecal);
-		explosionScales.set(target.id, target.destroyDecalScale);
+	Table<String, TargetModelSpec> targetsToBuild;
+	for (const TargetConfig& target : experimentConfig.targets) {
+		targetsToBuild.set(target.id, TargetModelSpec{ target.modelSpec, target.destroyDecal, target.destroyDecalScale });
 	}
 
 	// Append reference target model(s)
-	Any& defaultRefTarget = experimentConfig.targetView.refTargetModelSpec;
-	for (SessionConfig& sess : experimentConfig.sessions) {
+	const Any& defaultRefTarget = experimentConfig.targetView.refTargetModelSpec;
+	for (const SessionConfig& sess : experimentConfig.sessions) {
 		if (sess.targetView.refTargetModelSpec != defaultRefTarget) {
 			// This is a custom reference target model
-			String id = sess.id + "_reference";
-			targetsToBuild.set(id, sess.targetView.refTargetModelSpec);
-			explosionsToBuild.set(id, "explosion_01.png");
-			explosionScales.set(id, 1.0);
+			targetsToBuild.set(sess.id + "_reference", TargetModelSpec{ sess.targetView.refTargetModelSpec, "explosion_01.png", 1.0f });
 		}
 	}
 	// Add default reference
-	targetsToBuild.set("reference", defaultRefTarget);
-	explosionsToBuild.set("reference", "explosion_01.png");
-	explosionScales.set("reference", 1.0);
-
-	// Scale the models into the m_targetModel table
-	for (String id : targetsToBuild.getKeys()) {
-		// Get the any specs
-		Any tSpec = targetsToBuild.get(id);
-		Any explosionSpec = Any::parse(format(
-			"ArticulatedModel::Specification {\
-				filename = \"ifs/square.ifs\";\
-				preprocess = {\
-					transformGeometry(all(), Matrix4::scale(0.1, 0.1, 0.1));\
-					setMaterial(all(), UniversalMaterial::Specification{\
-						lambertian = Texture::Specification {\
-							filename = \"%s\";\
-							encoding = Color3(1, 1, 1);\
-						};\
-					});\
-				};\
-			}", explosionsToBuild.get(id).c_str()));
-
-		// Get the bounding box to scale to size rather than arbitrary factor
-		shared_ptr<ArticulatedModel> size_model = ArticulatedModel::create(ArticulatedModel::Specification(tSpec));
-		AABox bbox;
-		size_model->getBoundingBox(bbox);
-		Vector3 extent = bbox.extent();
-		logPrintf("%20s bounding box: [%2.2f, %2.2f, %2.2f]\n", id.c_str(), extent[0], extent[1], extent[2]);
-		const float default_scale = 1.0f / extent[0];					// Setup scale so that default model is 1m across
-
-		// Create the target/explosion models for this target
-		Array<shared_ptr<ArticulatedModel>> tModels, expModels;
-		for (int i = 0; i <= TARGET_MODEL_SCALE_COUNT; ++i) {
-			const float scale = pow(1.0f + TARGET_MODEL_ARRAY_SCALING, float(i) - TARGET_MODEL_ARRAY_OFFSET);
-			tSpec.set("scale", scale * default_scale);
-			explosionSpec.set("scale", (20.0 * scale * explosionScales.get(id)));
-			tModels.push(ArticulatedModel::create(tSpec));
-			expModels.push(ArticulatedModel::create(explosionSpec));
+	targetsToBuild.set("reference", TargetModelSpec{ defaultRefTarget, "explosion_01.png", 1.0f });
+
+	// Drop the models for targets that are no longer in the experiment
+	for (const String& id : m_targetModelSpecs.getKeys()) {
+		if (!targetsToBuild.containsKey(id)) {
+			targetModels.remove(id);
+			materials.remove(id);
+			m_materialColors.remove(id);
+			m_targetModelSpecs.remove(id);
+		}
+	}
+
+	// Build the models for new targets and those whose specification changed (i.e. when reloading configs)
+	int builtCount = 0;
+	for (const String& id : targetsToBuild.getKeys()) {
+		const TargetModelSpec& spec = targetsToBuild[id];
+		const TargetModelSpec* loadedSpec = m_targetModelSpecs.getPointer(id);
+		if (isNull(loadedSpec) || !(*loadedSpec == spec)) {
+			targetModels.set(id, TargetModels::create(id, spec));
+			m_targetModelSpecs.set(id, spec);
+			builtCount++;
 		}
-		targetModels.set(id, tModels);
-		m_explosionModels.set(id, expModels);
+		updateMaterials(id);
+	}
+	logPrintf("Built models for %d of %d targets (the rest are unchanged)\n", builtCount, targetsToBuild.size());
 
-		// Create a series of colored materials to choose from for target health
-		shared_ptr<TargetConfig> tconfig = experimentConfig.getTargetConfigById(id);
-		materials.remove(id);
-		materials.set(id, makeMaterials(tconfig));
+	// Create the models for the scales the targets (and reference targets) can spawn at, other scales are created on first use
+	for (const TargetConfig& target : experimentConfig.targets) {
+		targetModels[target.id]->preload(target.size[0], target.size[1]);
+	}
+	for (const SessionConfig& sess : experimentConfig.sessions) {
+		const String refId = targetModels.containsKey(sess.id + "_reference") ? sess.id + "_reference" : "reference";
+		targetModels[refId]->preload(sess.targetView.refTargetSize, sess.targetView.refTargetSize);
 	}
+	int scaleCount = 0;
+	for (const String& id : targetModels.getKeys()) scaleCount += targetModels[id]->loadedCount();
+	logPrintf("Loaded %d target model scales (the rest are created on first use)\n", scaleCount);
+}
+
+void FPSciApp::updateMaterials(const String& id) {
+	// Create a series of colored materials to choose from for target health (unless the colors are unchanged)
+	const TargetMaterialColors colors = targetMaterialColors(experimentConfig.getTargetConfigById(id));
+	const TargetMaterialColors* madeColors = m_materialColors.getPointer(id);
+	if (notNull(madeColors) && *madeColors == colors && materials.containsKey(id)) return;
+	materials.set(id, makeMaterials(colors));
+	m_materialColors.set(id, colors);
 }
 
-Array<shared_ptr<UniversalMaterial>> FPSciApp::makeMaterials(shared_ptr<TargetConfig> tconfig) {
+TargetMaterialColors FPSciApp::targetMaterialColors(shared_ptr<const TargetConfig> tconfig) const {
+	TargetMaterialColors colors;
+	colors.colors = (notNull(tconfig) && tconfig->colors.length() > 0) ? tconfig->colors : sessConfig->targetView.healthColors;
+	colors.gloss = (notNull(tconfig) && tconfig->hasGloss) ? tconfig->gloss : sessConfig->targetView.gloss;
+	colors.emissive = (notNull(tconfig) && tconfig->emissive.length() > 0) ? tconfig->emissive : sessConfig->targetView.emissive;
+	return colors;
+}
+
+Array<shared_ptr<UniversalMaterial>> FPSciApp::makeMaterials(shared_ptr<const TargetConfig> tconfig) {
+	return makeMaterials(targetMaterialColors(tconfig));
+}
+
+Array<shared_ptr<UniversalMaterial>> FPSciApp::makeMaterials(const TargetMaterialColors& colors) {
 	Array<shared_ptr<UniversalMaterial>> targetMaterials;
 	for (int i = 0; i < matTableSize; i++) {
 		float complete = (float)i / (matTableSize-1);
 		
-		Color4 color;
-		if (notNull(tconfig) && tconfig->colors.length() > 0) {
-			color = lerpColor(tconfig->colors, complete);
-		}
-		else {
-			color = lerpColor(sessConfig->targetView.healthColors, complete);
-		}
-		
-		Color4 gloss;
-		if (notNull(tconfig) && tconfig->hasGloss) {
-			gloss = tconfig->gloss;
-		}
-		else {
-			gloss = sessConfig->targetView.gloss;
-		}
+		const Color4 color = lerpColor(colors.colors, complete);
+		const Color4 gloss = colors.gloss;
 
 		Color4 emissive;
-		if (notNull(tconfig) && tconfig->emissive.length() > 0) {
-			emissive = lerpColor(tconfig->emissive, complete);
-		}
-		else if(sessConfig->targetView.emissive.length() > 0) {
-			emissive = lerpColor(sessConfig->targetView.emissive, complete);
+		if (colors.emissive.length() > 0) {
+			emissive = lerpColor(colors.emissive, complete);
 		}
 		else {
 			emissive = color * 0.7f;	// Historical behavior fallback for unspecified case
@@ -513,9 +503,6 @@ void FPSciApp::presentQuestion(Question question) {
 }
 
 void FPSciApp::markSessComplete(String sessId) {
-	if (notNull(m_pyLogger)) {
-		m_pyLogger->mergeLogToDb();
-	}
 	// Add the session id to completed session array and save the user status table
 	userStatusTable.addCompletedSession(userStatusTable.currentUser, sessId);
 	logPrintf("Marked session: %s complete for user %s.\n", sessId, userStatusTable.currentUser);
@@ -633,6 +620,11 @@ void FPSciApp::initPlayer(bool setSpawnPosition) {
 }
 
 void FPSciApp::updateSession(const String& id, bool forceReload) {
+	// Make sure the previous session's results are written before the next session starts logging
+	if (notNull(sess)) {
+		sess->endLogging();
+	}
+
 	// Check for a valid ID (non-emtpy and 
 	Array<String> ids;
 	experimentConfig.getSessionIds(ids);
@@ -662,20 +654,20 @@ void FPSciApp::updateSession(const String& id, bool forceReload) {
 
 	// Update the frame rate/delay
 	updateParameters(sessConfig->render.frameDelay, sessConfig->render.frameRate);
+	m_framePacer = FramePacer::create(sessConfig->render.framePacer, sessConfig->render.framePacerSpinMarginMs, sessConfig->render.framePacerThread);
 
 	// Handle buffer setup here
 	updateShaderBuffers();
 
-	// Update shader table
-	m_shaderTable.clear();
-	if (!sessConfig->render.shader3D.empty()) {
-		m_shaderTable.set(sessConfig->render.shader3D, G3D::Shader::getShaderFromPattern(sessConfig->render.shader3D));
+	// Update shader table (keeping the shaders this session shares w/ the last one)
+	const Array<String> shaders = { sessConfig->render.shader3D, sessConfig->render.shader2D, sessConfig->render.shaderComposite };
+	for (const String& shader : m_shaderTable.getKeys()) {
+		if (!shaders.contains(shader)) m_shaderTable.remove(shader);
 	}
-	if (!sessConfig->render.shader2D.empty()) {
-		m_shaderTable.set(sessConfig->render.shader2D, G3D::Shader::getShaderFromPattern(sessConfig->render.shader2D));
-	}
-	if (!sessConfig->render.shaderComposite.empty()) {
-		m_shaderTable.set(sessConfig->render.shaderComposite, G3D::Shader::getShaderFromPattern(sessConfig->render.shaderComposite));
+	for (const String& shader : shaders) {
+		if (!shader.empty() && !m_shaderTable.containsKey(shader)) {
+			m_shaderTable.set(shader, G3D::Shader::getShaderFromPattern(shader));
+		}
 	}
 
 	// Update shader parameters
@@ -685,9 +677,16 @@ void FPSciApp::updateSession(const String& id, bool forceReload) {
 	m_lastCompositeTime = m_startTime;
 	m_frameNumber = 0;
 
-	// Load (session dependent) fonts
-	hudFont = GFont::fromFile(System::findDataFile(sessConfig->hud.hudFont));
-	m_combatFont = GFont::fromFile(System::findDataFile(sessConfig->targetView.combatTextFont));
+	// Load (session dependent) fonts (keeping the fonts this session shares w/ the last one)
+	const Array<String> fonts = { sessConfig->hud.hudFont, sessConfig->targetView.combatTextFont };
+	for (const String& font : m_fonts.getKeys()) {
+		if (!fonts.contains(font)) m_fonts.remove(font);
+	}
+	for (const String& font : fonts) {
+		if (!m_fonts.containsKey(font)) m_fonts.set(font, GFont::fromFile(System::findDataFile(font)));
+	}
+	hudFont = m_fonts[sessConfig->hud.hudFont];
+	m_combatFont = m_fonts[sessConfig->targetView.combatTextFont];
 
 	// Handle clearing the targets here (clear any remaining targets before loading a new scene)
 	if (notNull(scene())) sess->clearTargets();
@@ -718,27 +717,35 @@ void FPSciApp::updateSession(const String& id, bool forceReload) {
 	// Update weapon model (if drawn) and sounds
 	weapon->loadModels();
 	weapon->loadSounds();
-	if (!sessConfig->audio.sceneHitSound.empty()) {
-		m_sceneHitSound = Sound::create(System::findDataFile(sessConfig->audio.sceneHitSound));
-		// Play silently to pre-load the sound
-		m_sceneHitSound->play(0.f);
-	}
-	if (!sessConfig->audio.refTargetHitSound.empty()) {
-		m_refTargetHitSound = Sound::create(System::findDataFile(sessConfig->audio.refTargetHitSound));
-		// Play silently to pre-load the sound
-		m_refTargetHitSound->play(0.f);
+	const Array<String> sounds = { sessConfig->audio.sceneHitSound, sessConfig->audio.refTargetHitSound };
+	for (const String& sound : m_sessionSounds.getKeys()) {
+		if (!sounds.contains(sound)) m_sessionSounds.remove(sound);
+	}
+	for (const String& sound : sounds) {
+		if (!sound.empty() && !m_sessionSounds.containsKey(sound)) {
+			m_sessionSounds.set(sound, Sound::create(System::findDataFile(sound)));
+			// Play silently to pre-load the sound
+			m_sessionSounds[sound]->play(0.f);
+		}
 	}
+	if (!sessConfig->audio.sceneHitSound.empty()) m_sceneHitSound = m_sessionSounds[sessConfig->audio.sceneHitSound];
+	if (!sessConfig->audio.refTargetHitSound.empty()) m_refTargetHitSound = m_sessionSounds[sessConfig->audio.refTargetHitSound];
 
-	// Load static HUD textures
-	for (StaticHudElement element : sessConfig->hud.staticElements) {
-		hudTextures.set(element.filename, Texture::fromFile(System::findDataFile(element.filename)));
+	// Load static HUD textures (that aren't already loaded), dropping those this session doesn't use
+	Array<String> hudTextureNames = { "scoreBannerBackdrop" };
+	for (const StaticHudElement& element : sessConfig->hud.staticElements) hudTextureNames.append(element.filename);
+	for (const String& name : hudTextures.getKeys()) {
+		if (!hudTextureNames.contains(name)) hudTextures.remove(name);
+	}
+	for (const StaticHudElement& element : sessConfig->hud.staticElements) {
+		if (!hudTextures.containsKey(element.filename)) {
+			hudTextures.set(element.filename, Texture::fromFile(System::findDataFile(element.filename)));
+		}
 	}
 
-	// Update colored materials to choose from for target health
-	for (String id : sessConfig->getUniqueTargetIds()) {
-		shared_ptr<TargetConfig> tconfig = experimentConfig.getTargetConfigById(id);
-		materials.remove(id);
-		materials.set(id, makeMaterials(tconfig));
+	// Update colored materials to choose from for target health (if this session changes their colors)
+	for (const String& id : sessConfig->getUniqueTargetIds()) {
+		updateMaterials(id);
 	}
 
 	const String resultsDirPath = startupConfig.experimentList[experimentIdx].resultsDirPath;
@@ -756,24 +763,24 @@ void FPSciApp::updateSession(const String& id, bool forceReload) {
 	// This is the specified path and log basename with illegal characters replaced, but not suffix (.db)
 	const String logPath = resultsDirPath + logFilename;
 
+	// Initialize the experiment (this creates the results file)
+	sess->onInit(logPath, experimentConfig.description + "/" + sessConfig->description);
+
 	if (systemConfig.hasLogger) {
 		if (!sessConfig->clickToPhoton.enabled) {
 			logPrintf("WARNING: Using a click-to-photon logger without the click-to-photon region enabled!\n\n");
 		}
-		if (m_pyLogger == nullptr) {
-			m_pyLogger = PythonLogger::create(systemConfig.loggerComPort, systemConfig.hasSync, systemConfig.syncComPort);
+		// The event logger stays open (and synced) across sessions
+		if (isNull(m_eventLogger)) {
+			m_eventLogger = HardwareEventLogger::create(systemConfig.loggerComPort, systemConfig.hasSync ? systemConfig.syncComPort : "");
 		}
-		else {
-			// Handle running logger if we need to (terminate then merge results)
-			m_pyLogger->mergeLogToDb();
+		// Write its events directly into this session's results
+		const shared_ptr<FPSciLogger> logger = sess->logger;
+		if (notNull(logger)) {
+			m_eventLogger->setCallback([logger](const HardwareEvent& event) { logger->logHardwareEvent(event); });
 		}
-		// Run a new logger if we need to (include the mode to run in here...)
-		m_pyLogger->run(logPath, sessConfig->clickToPhoton.mode);
 	}
 
-	// Initialize the experiment (this creates the results file)
-	sess->onInit(logPath, experimentConfig.description + "/" + sessConfig->description);
-
 	// Don't create a results file for a user w/ no sessions left
 	if (m_userSettingsWindow->sessionsForSelectedUser() == 0) {
 		logPrintf("No sessions remaining for selected user.\n");
@@ -787,15 +794,32 @@ void FPSciApp::updateSession(const String& id, bool forceReload) {
 	}
 }
 
+shared_ptr<FPSciLogger> FPSciApp::openResultsLogger(const String& filename, const String& subjectID, const shared_ptr<SessionConfig>& sessConfig, const String& description) {
+	if (notNull(m_logger) && m_logger->canLogSession(filename, sessConfig->logger)) {
+		// Keep the open connection, thread, and prepared statements, just start a new session
+		m_logger->beginSession(subjectID, sessConfig, description);
+	}
+	else {
+		m_logger.reset();		// Close the previous results file (if any) before opening the new one
+		const ExperimentInfo experiment = { startupConfig.experimentList[experimentIdx].experimentConfigFilename, experimentConfig.description, m_expConfigHash };
+		m_logger = FPSciLogger::create(filename, subjectID, experiment, sessConfig, description);
+	}
+	return m_logger;
+}
+
+void FPSciApp::detachHardwareEventLogger() {
+	if (notNull(m_eventLogger)) {
+		m_eventLogger->setCallback(nullptr);
+	}
+}
+
 void FPSciApp::quitRequest() {
-	// End session logging
+	// End session logging and close the results file
 	if (notNull(sess)) {
 		sess->endLogging();
 	}
-	// Merge Python log into session log (if logging)
-	if (notNull(m_pyLogger)) {
-		m_pyLogger->mergeLogToDb(true);
-	}
+	m_logger.reset();
+	m_eventLogger.reset();
     setExitCode(0);
 }
 
@@ -928,6 +952,7 @@ void FPSciApp::onSimulation(RealTime rdt, SimTime sdt, SimTime idt) {
 	// These are all we need from GApp::onSimulation() for walk mode
 	m_widgetManager->onSimulation(rdt, sdt, idt);
 	if (scene()) { scene()->onSimulation(sdt); }
+	sess->simulateTargets(sdt);
 
 	// make sure mouse sensitivity is set right
 	if (m_userSettingsWindow->visible()) {
@@ -1016,6 +1041,7 @@ bool FPSciApp::onEvent(const GEvent& event) {
 			}
 			else if (keyMap.map["reloadConfigs"].contains(ksym)) {
 				loadConfigs(startupConfig.experimentList[experimentIdx]);					// (Re)load the configs
+				loadModels();																// Rebuild the models for any targets that changed
 				// Update session from the reloaded configs
 				m_userSettingsWindow->updateSessionDropDown();
 				updateSession(m_userSettingsWindow->selectedSession());
@@ -1270,7 +1296,7 @@ void FPSciApp::hitTarget(shared_ptr<TargetEntity> target) {
 		const shared_ptr<VisibleEntity> newExplosion = VisibleEntity::create(
 			format("explosion%d", m_explosionIdx), 
 			scene().get(), 
-			m_explosionModels.get(target->id())[target->scaleIndex()], 
+			targetModels.get(target->id())->explosionModel(target->scaleIndex()), 
 			explosionFrame
 		);
 		m_explosionIdx++;
@@ -1450,35 +1476,14 @@ void FPSciApp::oneFrame() {
     if ((submitToDisplayMode() == SubmitToDisplayMode::MINIMIZE_LATENCY)) {
         BEGIN_PROFILER_EVENT("Wait");
         m_waitWatch.tick(); {
-            RealTime nowAfterLoop = System::time();
-
-            // Compute accumulated time
-            RealTime cumulativeTime = nowAfterLoop - m_lastWaitTime;
-
-            debugAssert(m_wallClockTargetDuration < finf());
             // Perform wait for target time needed
             RealTime duration = targetFrameTime;
             if (!window()->hasFocus() && m_lowerFrameRateInBackground) {
                 // Lower frame rate to 4fps
                 duration = 1.0 / 4.0;
             }
-            RealTime desiredWaitTime = max(0.0, duration - cumulativeTime);
-            onWait(max(0.0, desiredWaitTime - m_lastFrameOverWait) * 0.97);
-
-            // Update wait timers
-            m_lastWaitTime = System::time();
-            RealTime actualWaitTime = m_lastWaitTime - nowAfterLoop;
-
-            // Learn how much onWait appears to overshoot by and compensate
-            double thisOverWait = actualWaitTime - desiredWaitTime;
-            if (G3D::abs(thisOverWait - m_lastFrameOverWait) / max(G3D::abs(m_lastFrameOverWait), G3D::abs(thisOverWait)) > 0.4) {
-                // Abruptly change our estimate
-                m_lastFrameOverWait = thisOverWait;
-            }
-            else {
-                // Smoothly change our estimate
-                m_lastFrameOverWait = lerp(m_lastFrameOverWait, thisOverWait, 0.1);
-            }
+            m_framePacer->wait(duration);
+            m_lastFrameOverWait = m_framePacer->overWait();
         }  m_waitWatch.tock();
         END_PROFILER_EVENT();
     }
@@ -1565,35 +1570,14 @@ void FPSciApp::oneFrame() {
     if ((submitToDisplayMode() != SubmitToDisplayMode::MINIMIZE_LATENCY)) {
         BEGIN_PROFILER_EVENT("Wait");
         m_waitWatch.tick(); {
-            RealTime nowAfterLoop = System::time();
-
-            // Compute accumulated time
-            RealTime cumulativeTime = nowAfterLoop - m_lastWaitTime;
-
-            debugAssert(m_wallClockTargetDuration < finf());
             // Perform wait for actual time needed
             RealTime duration = targetFrameTime;
             if (!window()->hasFocus() && m_lowerFrameRateInBackground) {
                 // Lower frame rate to 4fps
                 duration = 1.0 / 4.0;
             }
-            RealTime desiredWaitTime = max(0.0, duration - cumulativeTime);
-            onWait(max(0.0, desiredWaitTime - m_lastFrameOverWait) * 0.97);
-
-            // Update wait timers
-            m_lastWaitTime = System::time();
-            RealTime actualWaitTime = m_lastWaitTime - nowAfterLoop;
-
-            // Learn how much onWait appears to overshoot by and compensate
-            double thisOverWait = actualWaitTime - desiredWaitTime;
-            if (G3D::abs(thisOverWait - m_lastFrameOverWait) / max(G3D::abs(m_lastFrameOverWait), G3D::abs(thisOverWait)) > 0.4) {
-                // Abruptly change our estimate
-                m_lastFrameOverWait = thisOverWait;
-            }
-            else {
-                // Smoothly change our estimate
-                m_lastFrameOverWait = lerp(m_lastFrameOverWait, thisOverWait, 0.1);
-            }
+            m_framePacer->wait(duration);
+            m_lastFrameOverWait = m_framePacer->overWait();
         }  m_waitWatch.tock();
         END_PROFILER_EVENT();
     }
@@ -1626,6 +1610,21 @@ void FPSciApp::oneFrame() {
     }
     END_PROFILER_EVENT();
 
+    // Frame timing (for the Frame_Info table)
+    if (notNull(sess->logger)) {
+        FrameTiming timing;
+        timing.userInputMs = float(m_userInputWatch.elapsedTime() * 1000.0);
+        timing.networkMs = float(m_networkWatch.elapsedTime() * 1000.0);
+        timing.logicMs = float(m_logicWatch.elapsedTime() * 1000.0);
+        timing.simulationMs = float(m_simulationWatch.elapsedTime() * 1000.0);
+        timing.poseMs = float(m_poseWatch.elapsedTime() * 1000.0);
+        timing.waitMs = float(m_waitWatch.elapsedTime() * 1000.0);
+        timing.graphicsMs = float(m_graphicsWatch.elapsedTime() * 1000.0);
+        timing.overWaitMs = float(m_lastFrameOverWait * 1000.0);
+        timing.targetFrameTimeMs = float(targetFrameTime * 1000.0);
+        sess->accumulateFrameTiming(timing);
+    }
+
     // Remove all expired debug shapes
     for (int i = 0; i < debugShapeArray.size(); ++i) {
         if (debugShapeArray[i].endTime <= m_now) {
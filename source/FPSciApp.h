@@ -19,13 +19,17 @@
 #include "UserConfig.h"
 #include "UserStatus.h"
 #include "TargetEntity.h"
+#include "TargetModels.h"
 #include "PlayerEntity.h"
 #include "GuiElements.h"
-#include "PythonLogger.h"
+#include "HardwareEventLogger.h"
+#include "FramePacer.h"
+#include "JobSystem.h"
 #include "Weapon.h"
 #include "CombatText.h"
 
 class Session;
+class FPSciLogger;
 class DialogBase;
 class WaypointManager;
 
@@ -47,6 +51,17 @@ static String presentationStateToString(const PresentationState& state) {
 	return stateStr;
 }
 
+/** The colors a target's materials are made from (the target's colors, or the session's where the target doesn't specify them) */
+struct TargetMaterialColors {
+	Array<Color4>	colors;			///< Colors to interpolate across health
+	Color4			gloss;			///< Glossy color
+	Array<Color4>	emissive;		///< Emissive colors to interpolate across health (empty to use 0.7 * color)
+
+	bool operator==(const TargetMaterialColors& other) const {
+		return colors == other.colors && gloss == other.gloss && emissive == other.emissive;
+	}
+};
+
 class FPSciApp : public GApp {
 public:
 	enum MouseInputMode {					///< Enumerated type for controlling the mouse input mode
@@ -68,7 +83,10 @@ protected:
 	int										m_explosionIdx = 0;					///< Explosion index
 	const int								m_maxExplosions = 20;				///< Maximum number of simultaneous explosions
 	
-	Table<String, Array<shared_ptr<ArticulatedModel>>> m_explosionModels;
+	Table<String, TargetModelSpec>			m_targetModelSpecs;					///< Specifications of the models in targetModels (by target ID)
+	Table<String, TargetMaterialColors>		m_materialColors;					///< Colors of the materials in the materials table (by target ID)
+	Table<String, shared_ptr<GFont>>		m_fonts;							///< Fonts loaded for the current session (by filename)
+	Table<String, shared_ptr<Sound>>		m_sessionSounds;					///< Scene/reference target hit sounds loaded for the current session (by filename)
 	/** table of shaders cached for the 2D shader parameters set per session */
 	Table<String, shared_ptr<G3D::Shader>> m_shaderTable;
 
@@ -93,7 +111,9 @@ protected:
 
 	String									m_expConfigHash;					///< String hash of experiment config file
 
-	shared_ptr<PythonLogger>				m_pyLogger = nullptr;
+	shared_ptr<HardwareEventLogger>			m_eventLogger = nullptr;			///< Reader for the hardware (click-to-photon) event logger (if the system has one)
+	shared_ptr<FramePacer>					m_framePacer = FramePacer::create("sleep");	///< Waits out each frame to hit the target frame time (set per session)
+	shared_ptr<FPSciLogger>					m_logger = nullptr;					///< Results logger (kept open across sessions logging to the same results file)
 
 	/** When m_displayLagFrames > 0, 3D frames are delayed in this queue */
 	Array<shared_ptr<Framebuffer>>			m_ldrDelayBufferQueue;
@@ -133,7 +153,11 @@ protected:
 	
 	void loadConfigs(const ConfigFiles& configs);
 
+	/** Load the weapon and target models, only (re)building target models whose specification changed since the last load */
 	virtual void loadModels();
+
+	/** (Re)make the materials for a target, if its colors changed since they were last made */
+	void updateMaterials(const String& id);
 	
 	/** Initializes player settings from configs and resets player to initial position 
 		Also updates mouse sensitivity. */
@@ -172,7 +196,7 @@ public:
 	ReticleConfig					reticleConfig;					///< Config for the active reticle
 	shared_ptr<Texture>             reticleTexture;					///< Texture used for reticle
 	
-	Table<String, shared_ptr<Texture>> hudTextures;					///< Textures used for the HUD
+	Table<String, shared_ptr<Texture>> hudTextures;					///< Textures used for the HUD (the score banner and the current session's static elements)
 	shared_ptr<GuiTheme>			theme;	
 
 	FPSciApp(const GApp::Settings& settings = GApp::Settings());
@@ -189,7 +213,7 @@ public:
 	shared_ptr<DialogBase>			dialog;							///< Dialog box
 	Question						currentQuestion;				///< Currently presented question
 
-	Table<String, Array<shared_ptr<ArticulatedModel>>>	targetModels;
+	Table<String, shared_ptr<TargetModels>>	targetModels;			///< Target/explosion models (by target ID)
 
 	/** A table of sounds that targets can use to allow sounds to finish playing after they're destroyed */
 	Table<String, shared_ptr<Sound>>					soundTable;
@@ -198,12 +222,15 @@ public:
 	Table<String, Array<shared_ptr<UniversalMaterial>>>	materials;
 	const int											matTableSize = 13;	///< Set this to set # of color "levels"
 	
-	Array<shared_ptr<UniversalMaterial>> makeMaterials(shared_ptr<TargetConfig> tconfig);
+	TargetMaterialColors targetMaterialColors(shared_ptr<const TargetConfig> tconfig) const;
+	Array<shared_ptr<UniversalMaterial>> makeMaterials(shared_ptr<const TargetConfig> tconfig);
+	Array<shared_ptr<UniversalMaterial>> makeMaterials(const TargetMaterialColors& colors);
 	Color4 lerpColor(Array<Color4> colors, float a);
 
 	shared_ptr<Session> sess;					///< Pointer to the experiment
 	shared_ptr<Camera> playerCamera;			///< Pointer to the player camera						
 	shared_ptr<Weapon> weapon;					///< Current weapon
+	shared_ptr<JobSystem> jobSystem;			///< Worker threads for parallel simulation (of targets, see Session::simulateTargets)
 
 	bool		renderFPS			= false;	///< Control flag used to draw (or not draw) FPS information to the display	
 	int			displayLagFrames	= 0;		///< Count of frames of latency to add
@@ -255,6 +282,10 @@ public:
 	void markSessComplete(String id);
 	/** Updates experiment state to the provided session id and updates player parameters (including mouse sensitivity) */
 	virtual void updateSession(const String& id, bool forceReload = false);
+	/** Start a session in the results logger for filename, reusing the open logger if it logs to the same file w/ the same settings */
+	shared_ptr<FPSciLogger> openResultsLogger(const String& filename, const String& subjectID, const shared_ptr<SessionConfig>& sessConfig, const String& description);
+	/** Stop writing hardware event logger events to the results logger (call before ending the session in the logger) */
+	void detachHardwareEventLogger();
 	void updateParameters(int frameDelay, float frameRate);
 	void updateTargetColor(const shared_ptr<TargetEntity>& target);
 	void presentQuestion(Question question);
@@ -0,0 +1,74 @@
+#include "FPSciClock.h"
+#include <ctime>
+#include <cstdio>
+#include <cctype>
+
+const FPSciClock::Calibration FPSciClock::s_calibration = FPSciClock::measureCalibration();
+
+FPSciClock::Calibration FPSciClock::measureCalibration() {
+	Calibration c;
+	c.steadyTime = std::chrono::steady_clock::now();
+	c.wallTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	return c;
+}
+
+/** Split a timestamp into (UTC) calendar time and microseconds */
+static void toCalendarTime(FPSciTimestamp t, std::tm& datetime, int& usec) {
+	int64 secs = t / 1000000;
+	usec = (int)(t % 1000000);
+	if (usec < 0) { usec += 1000000; secs -= 1; }		// Round towards negative infinity for times before the epoch
+	const std::time_t tt = (std::time_t)secs;
+#ifdef _WIN32
+	gmtime_s(&datetime, &tt);
+#else
+	gmtime_r(&tt, &datetime);
+#endif
+}
+
+String FPSciClock::format(FPSciTimestamp t) {
+	std::tm datetime;
+	int usec;
+	toCalendarTime(t, datetime, usec);
+	char tmCharArray[64] = { 0 };
+	snprintf(tmCharArray, sizeof(tmCharArray), "%04d-%02d-%02d %02d:%02d:%02d.%06d", datetime.tm_year + 1900, datetime.tm_mon + 1, datetime.tm_mday, datetime.tm_hour, datetime.tm_min, datetime.tm_sec, usec);
+	return String(tmCharArray);
+}
+
+/** Days since 1970-01-01 for a (proleptic Gregorian) calendar date */
+static int64 daysFromCivil(int64 y, int m, int d) {
+	y -= m <= 2;
+	const int64 era = (y >= 0 ? y : y - 399) / 400;
+	const int64 yoe = y - era * 400;
+	const int64 doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+	const int64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 719468;
+}
+
+bool FPSciClock::parse(const String& str, FPSciTimestamp& t) {
+	int year, month, day, hour, minute, second;
+	int fracStart = 0;
+	if (sscanf(str.c_str(), "%4d-%2d-%2d %2d:%2d:%2d%n", &year, &month, &day, &hour, &minute, &second, &fracStart) != 6) return false;
+	if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return false;
+
+	// Read up to 6 digits of fractional seconds (as usec)
+	int usec = 0;
+	const char* frac = str.c_str() + fracStart;
+	if (*frac == '.') {
+		int digits = 0;
+		for (frac++; isdigit(*frac) && digits < 6; frac++, digits++) usec = usec * 10 + (*frac - '0');
+		for (; digits < 6; digits++) usec *= 10;
+	}
+
+	const int64 secs = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+	t = secs * 1000000 + usec;
+	return true;
+}
+
+String FPSciClock::formatForFilename(FPSciTimestamp t) {
+	std::tm datetime;
+	int usec;
+	toCalendarTime(t, datetime, usec);
+	char tmCharArray[64] = { 0 };
+	snprintf(tmCharArray, sizeof(tmCharArray), "%04d_%02d_%02d-%02d_%02d_%02d", datetime.tm_year + 1900, datetime.tm_mon + 1, datetime.tm_mday, datetime.tm_hour, datetime.tm_min, datetime.tm_sec);
+	return String(tmCharArray);
+}
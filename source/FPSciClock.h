@@ -0,0 +1,39 @@
+#pragma once
+#include <G3D/G3D.h>
+#include <chrono>
+
+/** A wall-clock timestamp in microseconds since the Unix epoch (UTC) */
+typedef int64 FPSciTimestamp;
+
+/** High-resolution, portable clock used for logging timestamps.
+	Reads a monotonic counter (std::chrono::steady_clock) and offsets it by a wall-clock time captured once at startup,
+	so reading the time is cheap enough to do for every frame/logged record and never jumps backwards. The calibration is
+	never changed after that, so the clock can be read from any thread (i.e. the logger and hardware event reader threads)
+	and offsets derived from it (like the hardware event parser's soft sync) stay valid. */
+class FPSciClock {
+protected:
+	/** A wall-clock time and the monotonic counter value at which it was sampled */
+	struct Calibration {
+		FPSciTimestamp wallTime;
+		std::chrono::steady_clock::time_point steadyTime;
+	};
+	static const Calibration s_calibration;		///< Calibration (measured at startup)
+
+	static Calibration measureCalibration();
+
+public:
+	/** Get the current time */
+	static FPSciTimestamp now() {
+		const auto elapsed = std::chrono::steady_clock::now() - s_calibration.steadyTime;
+		return s_calibration.wallTime + std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+	}
+
+	/** Format a timestamp as "YYYY-MM-DD HH:MM:SS.uuuuuu" (UTC) */
+	static String format(FPSciTimestamp t);
+
+	/** Format a timestamp for use in a filename as "YYYY_MM_DD-HH_MM_SS" (UTC) */
+	static String formatForFilename(FPSciTimestamp t);
+
+	/** Parse a timestamp formatted by format() (the fractional seconds are optional), returns false if str isn't a valid timestamp */
+	static bool parse(const String& str, FPSciTimestamp& t);
+};
@@ -0,0 +1,207 @@
+#include "FlyingTargetBatch.h"
+#include "TargetEntity.h"
+
+const float FlyingTargetBatch::minStepTime = 0.000001f;
+const int FlyingTargetBatch::maxPasses;
+
+void FlyingTargetBatch::add(FlyingEntity* entity) {
+	if (entity->m_batch == this) return;
+	if (notNull(entity->m_batch)) entity->m_batch->remove(entity);
+
+	Params params;
+	params.angularSpeedRange = entity->m_angularSpeedRange;
+	params.motionChangePeriodRange = entity->m_motionChangePeriodRange;
+	params.upperHemisphereOnly = entity->m_upperHemisphereOnly;
+	entity->m_batchSlot = add(entity->m_orbitCenter, entity->frame().translation, params, entity->m_random);
+	entity->m_batch = this;
+	m_entities.last() = entity;
+}
+
+int FlyingTargetBatch::add(const Point3& orbitCenter, const Point3& position, const Params& params, const RandomStream& random) {
+	m_entities.append(nullptr);
+	m_centerX.append(orbitCenter.x);
+	m_centerY.append(orbitCenter.y);
+	m_centerZ.append(orbitCenter.z);
+	m_radius.append(0.0f);
+	m_currX.append(0.0f);
+	m_currY.append(0.0f);
+	m_currZ.append(0.0f);
+	m_destX.append(0.0f);
+	m_destY.append(0.0f);
+	m_destZ.append(0.0f);
+	m_angularSpeed.append(0.0f);
+	m_remainingTime.append(0.0f);
+	m_hasDestination.append(0);
+	m_moved.append(0);
+	m_random.append(random);
+	m_minSpeed.append(params.angularSpeedRange.x);
+	m_maxSpeed.append(params.angularSpeedRange.y);
+	m_minPeriod.append(params.motionChangePeriodRange.x);
+	m_maxPeriod.append(params.motionChangePeriodRange.y);
+	m_upperHemisphereOnly.append(params.upperHemisphereOnly ? 1 : 0);
+
+	const int slot = size() - 1;
+	setPosition(slot, position);
+	return slot;
+}
+
+void FlyingTargetBatch::remove(FlyingEntity* entity) {
+	if (entity->m_batch != this) return;
+	remove(entity->m_batchSlot);
+}
+
+void FlyingTargetBatch::remove(int slot) {
+	if (notNull(m_entities[slot])) {
+		m_entities[slot]->m_random = m_random[slot];		// Continue the entity's stream where the batch left it
+		m_entities[slot]->m_batch = nullptr;
+		m_entities[slot]->m_batchSlot = -1;
+	}
+
+	// Move the last slot into this one (fastRemove) and update its entity
+	m_entities.fastRemove(slot);
+	m_centerX.fastRemove(slot);
+	m_centerY.fastRemove(slot);
+	m_centerZ.fastRemove(slot);
+	m_radius.fastRemove(slot);
+	m_currX.fastRemove(slot);
+	m_currY.fastRemove(slot);
+	m_currZ.fastRemove(slot);
+	m_destX.fastRemove(slot);
+	m_destY.fastRemove(slot);
+	m_destZ.fastRemove(slot);
+	m_angularSpeed.fastRemove(slot);
+	m_remainingTime.fastRemove(slot);
+	m_hasDestination.fastRemove(slot);
+	m_moved.fastRemove(slot);
+	m_random.fastRemove(slot);
+	m_minSpeed.fastRemove(slot);
+	m_maxSpeed.fastRemove(slot);
+	m_minPeriod.fastRemove(slot);
+	m_maxPeriod.fastRemove(slot);
+	m_upperHemisphereOnly.fastRemove(slot);
+	if (slot < size() && notNull(m_entities[slot])) m_entities[slot]->m_batchSlot = slot;
+}
+
+void FlyingTargetBatch::clear() {
+	while (size() > 0) remove(size() - 1);
+}
+
+Point3 FlyingTargetBatch::position(int slot) const {
+	return Point3(m_centerX[slot], m_centerY[slot], m_centerZ[slot]) + Vector3(m_currX[slot], m_currY[slot], m_currZ[slot]) * m_radius[slot];
+}
+
+void FlyingTargetBatch::setPosition(int slot, const Point3& position) {
+	const Vector3 rel = position - Point3(m_centerX[slot], m_centerY[slot], m_centerZ[slot]);
+	const Vector3 dir = rel.direction();
+	m_radius[slot] = rel.length();
+	m_currX[slot] = dir.x;
+	m_currY[slot] = dir.y;
+	m_currZ[slot] = dir.z;
+}
+
+void FlyingTargetBatch::newDestination(int slot) {
+	// Draw the motion change period and speed, then rotate toward a random perpendicular (as FlyingEntity::onSimulation does)
+	RandomStream& random = m_random[slot];
+	const float motionChangePeriod = random.uniform(m_minPeriod[slot], m_maxPeriod[slot]);
+	const float angularSpeed = random.uniform(m_minSpeed[slot], m_maxSpeed[slot]);
+	const float angularDistance = min(motionChangePeriod * angularSpeed, 170.0f);		// Limit to 170 deg
+
+	const Vector3 relPos = Vector3(m_currX[slot], m_currY[slot], m_currZ[slot]) * m_radius[slot];
+	const Vector3 dest = rotateToward(relPos, findPerpendicularVector(relPos, random), angularDistance).direction();
+	m_destX[slot] = dest.x;
+	m_destY[slot] = dest.y;
+	m_destZ[slot] = dest.z;
+	m_angularSpeed[slot] = angularSpeed * pif() / 180.0f;
+	m_hasDestination[slot] = 1;
+}
+
+void FlyingTargetBatch::advance(SimTime deltaTime) {
+	const int n = size();
+	const float dt = (float)deltaTime;
+	for (int i = 0; i < n; i++) {
+		// Targets w/ a zero minimum speed don't move (matches FlyingEntity::onSimulation)
+		m_remainingTime[i] = (dt > minStepTime && m_minSpeed[i] > 0.0f) ? dt : 0.0f;
+		m_moved[i] = 0;
+	}
+
+	float* const cx = m_currX.getCArray();
+	float* const cy = m_currY.getCArray();
+	float* const cz = m_currZ.getCArray();
+	float* const dx = m_destX.getCArray();
+	float* const dy = m_destY.getCArray();
+	float* const dz = m_destZ.getCArray();
+	float* const remaining = m_remainingTime.getCArray();
+	uint8* const hasDest = m_hasDestination.getCArray();
+	uint8* const moved = m_moved.getCArray();
+	const float* const radius = m_radius.getCArray();
+	const float* const speed = m_angularSpeed.getCArray();
+	const uint8* const upperOnly = m_upperHemisphereOnly.getCArray();
+
+	// Each pass moves every target toward its destination, targets that reach it use the rest of their time in the next pass
+	for (int pass = 0; pass < maxPasses; pass++) {
+		// Draw destinations for active targets that need one (the only per-target work)
+		int active = 0;
+		for (int i = 0; i < n; i++) {
+			if (remaining[i] <= minStepTime) continue;
+			active++;
+			if (!hasDest[i]) newDestination(i);
+		}
+		if (active == 0) break;
+
+		// Arc step for all targets (inactive ones have no remaining time, so an angle change of 0)
+		for (int i = 0; i < n; i++) {
+			const float t = remaining[i] > minStepTime ? remaining[i] : 0.0f;
+			const float projection = clamp(cx[i] * dx[i] + cy[i] * dy[i] + cz[i] * dz[i], -1.0f, 1.0f);
+			const float destinationAngle = acosf(projection);
+			const float step = speed[i] * t;
+
+			// Retire destinations we are (almost) at, the arc math is numerically imprecise for such close destinations
+			const bool close = radius[i] * sqrtf(2.0f - 2.0f * projection) < 0.001f;
+			const bool reached = !close && step > destinationAngle;
+			const float angleChange = close ? 0.0f : (reached ? destinationAngle : step);
+
+			// Spherical coordinates in the plane of the arc
+			float vx = dx[i] - cx[i] * projection;
+			float vy = dy[i] - cy[i] * projection;
+			float vz = dz[i] - cz[i] * projection;
+			const float vLength = sqrtf(vx * vx + vy * vy + vz * vz);
+			const float vScale = vLength > 0.0f ? 1.0f / vLength : 0.0f;
+			vx *= vScale; vy *= vScale; vz *= vScale;
+
+			const float c = cosf(angleChange);
+			const float s = sinf(angleChange);
+			cx[i] = c * cx[i] + s * vx;
+			cy[i] = c * cy[i] + s * vy;
+			cz[i] = c * cz[i] + s * vz;
+
+			if (t > 0.0f && (close || reached)) hasDest[i] = 0;
+			remaining[i] = close ? t : (reached ? t - destinationAngle / speed[i] : 0.0f);
+			moved[i] |= (angleChange != 0.0f) ? 1 : 0;
+		}
+
+		// Keep upper hemisphere targets above the orbit horizon (y-invert the position and destination if below it)
+		for (int i = 0; i < n; i++) {
+			if (upperOnly[i] && cy[i] < 0.0f) {
+				cy[i] = -cy[i];
+				dy[i] = -dy[i];
+			}
+		}
+	}
+}
+
+void FlyingTargetBatch::onSimulation(SimTime deltaTime) {
+	const int n = size();
+	for (int i = 0; i < n; i++) {
+		if (notNull(m_entities[i])) setPosition(i, m_entities[i]->frame().translation);
+	}
+
+	advance(deltaTime);
+
+	const RealTime now = System::time();
+	for (int i = 0; i < n; i++) {
+		FlyingEntity* entity = m_entities[i];
+		if (isNull(entity) || m_minSpeed[i] <= 0.0f) continue;
+		entity->setFrame(position(i));
+		if (m_moved[i]) entity->m_lastChangeTime = now;		// Set changed time if it moved
+	}
+}
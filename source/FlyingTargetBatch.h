@@ -0,0 +1,82 @@
+#pragma once
+#include <G3D/G3D.h>
+#include "RandomStream.h"
+
+class FlyingEntity;
+
+/** Orbit motion state for a set of player-space FlyingEntity targets, stored as a structure of arrays and advanced for all
+	targets at once (by onSimulation) rather than per-entity in FlyingEntity::onSimulation.
+
+	Each target moves along great-circle arcs of the sphere around its orbit center (at its current distance from the center),
+	toward a randomly drawn destination direction at a randomly drawn angular speed (see FlyingEntity). The orbit centers,
+	radii, current/destination unit vectors, and angular speeds are kept in contiguous per-component arrays, so each arc step
+	is a single branch-free pass over all targets. Only drawing new destinations is done per target, and only for targets that
+	reached their destination. Each target draws from its own random stream, so its motion doesn't depend on the other targets.
+
+	Batched entities are views over this storage: the batch reads each entity's position before stepping (so targets moved
+	elsewhere, i.e. on spawn or respawn, continue from their new position) and writes it back after. */
+class FlyingTargetBatch {
+public:
+	/** Motion parameters for a batched target */
+	struct Params {
+		Vector2		angularSpeedRange = Vector2(0.0f, 4.0f);			///< Angular speed range in deg/s (x=min y=max)
+		Vector2		motionChangePeriodRange = Vector2(1.0f, 1.0f);		///< Motion change period range in seconds (x=min y=max)
+		bool		upperHemisphereOnly = false;						///< Keep the target above its orbit center?
+	};
+
+	/** Steps below this duration (in seconds) are ignored (as in FlyingEntity::onSimulation) */
+	static const float minStepTime;
+	/** Limit on destinations reached by a target in a single onSimulation() call */
+	static const int maxPasses = 16;
+
+protected:
+	Array<FlyingEntity*>	m_entities;						///< Entity viewing each slot (not owned, null for slots added w/o an entity)
+
+	// Per-target state (indexed by slot)
+	Array<float>	m_centerX, m_centerY, m_centerZ;		///< Orbit center
+	Array<float>	m_radius;								///< Distance from the orbit center
+	Array<float>	m_currX, m_currY, m_currZ;				///< Current direction from the orbit center (unit vector)
+	Array<float>	m_destX, m_destY, m_destZ;				///< Destination direction from the orbit center (unit vector)
+	Array<float>	m_angularSpeed;							///< Angular speed toward the destination (rad/s)
+	Array<float>	m_remainingTime;						///< Time left to simulate in the current onSimulation() call
+	Array<uint8>	m_hasDestination;						///< Does the slot have a (not yet reached) destination?
+	Array<uint8>	m_moved;								///< Did the slot move in the last advance()?
+	Array<RandomStream> m_random;							///< Motion random stream (taken from/returned to the entity)
+
+	// Per-target parameters (indexed by slot)
+	Array<float>	m_minSpeed, m_maxSpeed;					///< Angular speed range (deg/s)
+	Array<float>	m_minPeriod, m_maxPeriod;				///< Motion change period range (s)
+	Array<uint8>	m_upperHemisphereOnly;
+
+	/** Draw a new destination (and angular speed) for a slot */
+	void newDestination(int slot);
+
+public:
+	FlyingTargetBatch() {}
+	~FlyingTargetBatch() { clear(); }
+
+	/** Add a (player-space) entity to the batch, the entity is moved by onSimulation() until it is removed */
+	void add(FlyingEntity* entity);
+	/** Add a slot w/o an entity (advanced by advance()), returns its slot index */
+	int add(const Point3& orbitCenter, const Point3& position, const Params& params, const RandomStream& random = RandomStream());
+
+	/** Remove an entity from the batch (the last slot is moved into its slot) */
+	void remove(FlyingEntity* entity);
+	void remove(int slot);
+	/** Remove all slots */
+	void clear();
+
+	/** Drop a slot's current destination (a new one is drawn on the next step) */
+	void clearDestination(int slot) { m_hasDestination[slot] = 0; }
+
+	int size() const { return m_radius.size(); }
+	Point3 position(int slot) const;
+	void setPosition(int slot, const Point3& position);
+	bool moved(int slot) const { return m_moved[slot] != 0; }
+
+	/** Advance all slots along their orbits by deltaTime (seconds) */
+	void advance(SimTime deltaTime);
+
+	/** Read the batched entities' positions, advance() them, then update the entities' frames */
+	void onSimulation(SimTime deltaTime);
+};
@@ -93,6 +93,7 @@ bool SceneConfig::operator!=(const SceneConfig& other) const {
 void RenderConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 	// List of valid frame time modes for parsing from Any
 	const Array<String> validFrameTimeModes = { "always", "taskonly", "restartwithtask" };
+	const Array<String> validFramePacers = { "sleep", "hybrid" };
 
 	switch (settingsVersion) {
 	case 1:
@@ -100,6 +101,7 @@ void RenderConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		reader.getIfPresent("frameDelay", frameDelay);
 		reader.getIfPresent("frameTimeArray", frameTimeArray);
 		reader.getIfPresent("frameTimeRandomize", frameTimeRandomize);
+		reader.getIfPresent("frameTimeSeed", frameTimeSeed);
 		
 		reader.getIfPresent("frameTimeMode", frameTimeMode);
 		frameTimeMode = toLower(frameTimeMode);	// Convert to lower case
@@ -112,6 +114,17 @@ void RenderConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 			throw errMsg;
 		}
 
+		reader.getIfPresent("framePacer", framePacer);
+		framePacer = toLower(framePacer);
+		if (!validFramePacers.contains(framePacer)) {
+			throw format("Specified \"framePacer\" (\"%s\") is invalid, must be one of: %s!", framePacer.c_str(), Any(validFramePacers).unparse().c_str());
+		}
+		reader.getIfPresent("framePacerSpinMarginMs", framePacerSpinMarginMs);
+		if (framePacerSpinMarginMs < 0.0f) {
+			throw format("Specified \"framePacerSpinMarginMs\" (%f) is invalid, must be at least 0!", framePacerSpinMarginMs);
+		}
+		reader.getIfPresent("framePacerThread", framePacerThread);
+
 		reader.getIfPresent("horizontalFieldOfView", hFoV);
 
 		reader.getIfPresent("resolution2D", resolution2D);
@@ -152,6 +165,10 @@ Any RenderConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.frameTimeArray != frameTimeArray)		a["frameTimeArray"] = frameTimeArray;
 	if (forceAll || def.frameTimeRandomize != frameTimeRandomize) a["frameTimeRandomize"] = frameTimeRandomize;
 	if (forceAll || def.frameTimeMode != frameTimeMode)			a["frameTimeMode"] = frameTimeMode;
+	if (forceAll || def.frameTimeSeed != frameTimeSeed)			a["frameTimeSeed"] = frameTimeSeed;
+	if (forceAll || def.framePacer != framePacer)				a["framePacer"] = framePacer;
+	if (forceAll || def.framePacerSpinMarginMs != framePacerSpinMarginMs)	a["framePacerSpinMarginMs"] = framePacerSpinMarginMs;
+	if (forceAll || def.framePacerThread != framePacerThread)	a["framePacerThread"] = framePacerThread;
 	if (forceAll || def.hFoV != hFoV)							a["horizontalFieldOfView"] = hFoV;
 
 	if (forceAll || def.resolution2D != resolution2D)			a["resolution2D"] = resolution2D;
@@ -366,6 +383,7 @@ void TimingConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		reader.getIfPresent("sessionFeedbackRequireClick", sessionFeedbackRequireClick);
 		reader.getIfPresent("defaultTrialCount", defaultTrialCount);
 		reader.getIfPresent("maxPretrialAimDisplacement", maxPretrialAimDisplacement);
+		reader.getIfPresent("randomSeed", randomSeed);
 		break;
 	default:
 		throw format("Did not recognize settings version: %d", settingsVersion);
@@ -384,6 +402,7 @@ Any TimingConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.sessionFeedbackRequireClick != sessionFeedbackRequireClick) a["sessionFeedbackRequireClick"] = sessionFeedbackRequireClick;
 	if (forceAll || def.defaultTrialCount != defaultTrialCount)				a["defaultTrialCount"] = defaultTrialCount;
 	if (forceAll || def.maxPretrialAimDisplacement != maxPretrialAimDisplacement)	a["maxPretrialAimDisplacement"] = maxPretrialAimDisplacement;
+	if (forceAll || def.randomSeed != randomSeed)							a["randomSeed"] = randomSeed;
 	return a;
 }
 
@@ -544,11 +563,19 @@ Any ClickToPhotonConfig::addToAny(Any a, bool forceAll) const {
 }
 
 void LoggerConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
+	// List of valid SQLite pragma values for parsing from Any
+	const Array<String> validJournalModes = { "delete", "truncate", "persist", "memory", "wal", "off" };
+	const Array<String> validSynchronousModes = { "off", "normal", "full", "extra" };
+	const Array<String> validOverflowPolicies = { "block", "dropoldest", "spill" };
+	const Array<String> validTimestampFormats = { "text", "integer" };
+	const Array<String> validTrajectoryEncodings = { "float", "delta" };
+
 	switch (settingsVersion) {
 	case 1:
 		reader.getIfPresent("logEnable", enable);
 		reader.getIfPresent("logTargetTrajectories", logTargetTrajectories);
 		reader.getIfPresent("logFrameInfo", logFrameInfo);
+		reader.getIfPresent("logFrameTiming", logFrameTiming);
 		reader.getIfPresent("logPlayerActions", logPlayerActions);
 		reader.getIfPresent("logTrialResponse", logTrialResponse);
 		reader.getIfPresent("logUsers", logUsers);
@@ -556,6 +583,54 @@ void LoggerConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		reader.getIfPresent("logSessionDropDownUpdate", logSessDDUpdate);
 		reader.getIfPresent("sessionParametersToLog", sessParamsToLog);
 		reader.getIfPresent("logToSingleDb", logToSingleDb);
+		reader.getIfPresent("logToColumnarFile", logToColumnarFile);
+		reader.getIfPresent("logSessionSummary", logSessionSummary);
+		reader.getIfPresent("logRecoveryJournal", logRecoveryJournal);
+		reader.getIfPresent("logRecoveryJournalSizeMB", recoveryJournalSizeMB);
+		if (recoveryJournalSizeMB < 1) {
+			throw format("Specified \"logRecoveryJournalSizeMB\" (%d) is invalid, must be at least 1!", recoveryJournalSizeMB);
+		}
+
+		reader.getIfPresent("logJournalMode", journalMode);
+		journalMode = toLower(journalMode);
+		if (!validJournalModes.contains(journalMode)) {
+			throw format("Specified \"logJournalMode\" (\"%s\") is invalid, must be one of: %s!", journalMode.c_str(), Any(validJournalModes).unparse().c_str());
+		}
+		reader.getIfPresent("logSynchronousMode", synchronous);
+		synchronous = toLower(synchronous);
+		if (!validSynchronousModes.contains(synchronous)) {
+			throw format("Specified \"logSynchronousMode\" (\"%s\") is invalid, must be one of: %s!", synchronous.c_str(), Any(validSynchronousModes).unparse().c_str());
+		}
+		reader.getIfPresent("logTimestampFormat", timestampFormat);
+		timestampFormat = toLower(timestampFormat);
+		if (!validTimestampFormats.contains(timestampFormat)) {
+			throw format("Specified \"logTimestampFormat\" (\"%s\") is invalid, must be one of: %s!", timestampFormat.c_str(), Any(validTimestampFormats).unparse().c_str());
+		}
+		reader.getIfPresent("logTrajectoryEncoding", trajectoryEncoding);
+		trajectoryEncoding = toLower(trajectoryEncoding);
+		if (!validTrajectoryEncodings.contains(trajectoryEncoding)) {
+			throw format("Specified \"logTrajectoryEncoding\" (\"%s\") is invalid, must be one of: %s!", trajectoryEncoding.c_str(), Any(validTrajectoryEncodings).unparse().c_str());
+		}
+		reader.getIfPresent("logPositionPrecision", positionPrecision);
+		if (positionPrecision <= 0.0f) {
+			throw format("Specified \"logPositionPrecision\" (%f) is invalid, must be greater than 0!", positionPrecision);
+		}
+		reader.getIfPresent("logAnglePrecision", anglePrecision);
+		if (anglePrecision <= 0.0f) {
+			throw format("Specified \"logAnglePrecision\" (%f) is invalid, must be greater than 0!", anglePrecision);
+		}
+		reader.getIfPresent("logKeyframeInterval", keyframeInterval);
+		if (keyframeInterval < 1) {
+			throw format("Specified \"logKeyframeInterval\" (%d) is invalid, must be at least 1!", keyframeInterval);
+		}
+		reader.getIfPresent("logQueueCapacity", queueCapacity);
+		if (queueCapacity < 2) {
+			throw format("Specified \"logQueueCapacity\" (%d) is invalid, must be at least 2!", queueCapacity);
+		}
+		reader.getIfPresent("logQueueOverflowPolicy", queueOverflowPolicy);
+		if (!validOverflowPolicies.contains(toLower(queueOverflowPolicy))) {
+			throw format("Specified \"logQueueOverflowPolicy\" (\"%s\") is invalid, must be one of: \"block\", \"dropOldest\", or \"spill\"!", queueOverflowPolicy.c_str());
+		}
 		break;
 	default:
 		throw format("Did not recognize settings version: %d", settingsVersion);
@@ -568,6 +643,7 @@ Any LoggerConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.enable != enable)								a["logEnable"] = enable;
 	if (forceAll || def.logTargetTrajectories != logTargetTrajectories)	a["logTargetTrajectories"] = logTargetTrajectories;
 	if (forceAll || def.logFrameInfo != logFrameInfo)					a["logFrameInfo"] = logFrameInfo;
+	if (forceAll || def.logFrameTiming != logFrameTiming)				a["logFrameTiming"] = logFrameTiming;
 	if (forceAll || def.logPlayerActions != logPlayerActions)			a["logPlayerActions"] = logPlayerActions;
 	if (forceAll || def.logTrialResponse != logTrialResponse)			a["logTrialResponse"] = logTrialResponse;
 	if (forceAll || def.logUsers != logUsers)							a["logUsers"] = logUsers;
@@ -575,6 +651,19 @@ Any LoggerConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.sessParamsToLog != sessParamsToLog)				a["sessionParametersToLog"] = sessParamsToLog;
 	if (forceAll || def.logSessDDUpdate != logSessDDUpdate)				a["logSessionDropDownUpdate"] = logSessDDUpdate;
 	if (forceAll || def.logToSingleDb != logToSingleDb)					a["logToSingleDb"] = logToSingleDb;
+	if (forceAll || def.logToColumnarFile != logToColumnarFile)			a["logToColumnarFile"] = logToColumnarFile;
+	if (forceAll || def.logSessionSummary != logSessionSummary)			a["logSessionSummary"] = logSessionSummary;
+	if (forceAll || def.logRecoveryJournal != logRecoveryJournal)		a["logRecoveryJournal"] = logRecoveryJournal;
+	if (forceAll || def.recoveryJournalSizeMB != recoveryJournalSizeMB)	a["logRecoveryJournalSizeMB"] = recoveryJournalSizeMB;
+	if (forceAll || def.journalMode != journalMode)						a["logJournalMode"] = journalMode;
+	if (forceAll || def.synchronous != synchronous)						a["logSynchronousMode"] = synchronous;
+	if (forceAll || def.timestampFormat != timestampFormat)				a["logTimestampFormat"] = timestampFormat;
+	if (forceAll || def.trajectoryEncoding != trajectoryEncoding)		a["logTrajectoryEncoding"] = trajectoryEncoding;
+	if (forceAll || def.positionPrecision != positionPrecision)			a["logPositionPrecision"] = positionPrecision;
+	if (forceAll || def.anglePrecision != anglePrecision)				a["logAnglePrecision"] = anglePrecision;
+	if (forceAll || def.keyframeInterval != keyframeInterval)			a["logKeyframeInterval"] = keyframeInterval;
+	if (forceAll || def.queueCapacity != queueCapacity)					a["logQueueCapacity"] = queueCapacity;
+	if (forceAll || def.queueOverflowPolicy != queueOverflowPolicy)		a["logQueueOverflowPolicy"] = queueOverflowPolicy;
 	return a;
 }
 
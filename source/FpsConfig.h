@@ -32,6 +32,10 @@ public:
 	Array<float>	frameTimeArray = { };						///< Array of target frame times (in seconds)
 	bool			frameTimeRandomize = false;					///< Whether to choose a sequential or random item from frameTimeArray
 	String			frameTimeMode = "always";					///< Mode to use for frame time selection (can be "always", "taskOnly", or "restartWithTask", case insensitive)
+	int				frameTimeSeed = -1;							///< Seed for drawing random frame times from frameTimeArray (-1 to choose one for each session)
+	String			framePacer = "sleep";						///< How to wait for the target frame time ("sleep" or "hybrid" sleep then spin, case insensitive)
+	float			framePacerSpinMarginMs = 1.0f;				///< Time (in ms) before each frame's deadline the "hybrid" pacer stops sleeping and spins
+	bool			framePacerThread = false;					///< Use a dedicated (high priority) timing thread for the "hybrid" pacer?
 
 	float           hFoV = 103.0f;							    ///< Field of view (horizontal) for the user
 	
@@ -159,6 +163,7 @@ public:
 	bool			clickToStart = true;						///< Require a click before starting the first session (spawning the reference target)
 	bool			sessionFeedbackRequireClick = false;		///< Require a click to progress from the session feedback?
 	float			maxPretrialAimDisplacement = 180.0f;		///< Maximum (angular) aim displacement in the pretrial duration in degrees, set to negative value to disable
+	int				randomSeed = -1;							///< Seed for the session's random streams (trial order, pretrial duration, targets, weapon spread), -1 to choose one for each session
 
 	// Trial count
 	int             defaultTrialCount = 5;						///< Default trial count
@@ -283,6 +288,7 @@ public:
 	bool enable = true;					///< High-level logging enable flag (if false no output is created)							
 	bool logTargetTrajectories = true;	///< Log target trajectories in table?
 	bool logFrameInfo = true;			///< Log frame info in table?
+	bool logFrameTiming = false;		///< Add per-phase frame timing columns to the frame info table?
 	bool logPlayerActions = true;		///< Log player actions in table?
 	bool logTrialResponse = true;		///< Log trial response in table?
 	bool logUsers = true;				///< Log user information in table?
@@ -290,6 +296,27 @@ public:
 	bool logSessDDUpdate = false;		///< Log the session drop-down update (on each session complete)
 
 	bool logToSingleDb = true;			///< Log all results to a single db file?
+	bool logToColumnarFile = false;		///< Also write the Frame_Info, Player_Action, and Target_Trajectory tables to a (per session) columnar file?
+	bool logRecoveryJournal = false;	///< Journal Frame_Info, Player_Action, and Target_Trajectory records to a memory-mapped file (replayed after a crash)?
+	int recoveryJournalSizeMB = 64;		///< Size (in MB) of the recovery journal
+	bool logSessionSummary = true;		///< Index the results file and write per-trial summaries (Trial_Summary table) at the end of each session?
+
+	// SQLite pragmas applied when opening the results file
+	String journalMode = "delete";		///< SQLite journal_mode pragma for the results file ("delete", "truncate", "persist", "memory", "wal", or "off")
+	String synchronous = "full";		///< SQLite synchronous pragma for the results file ("off", "normal", "full", or "extra")
+
+	// Results schema
+	String timestampFormat = "text";		///< Storage for Frame_Info/Player_Action/Target_Trajectory timestamps ("text" or "integer" microseconds since epoch)
+
+	// Columnar file trajectory encoding
+	String trajectoryEncoding = "float";	///< Encoding for positions/view angles in the columnar file ("float" or "delta" for quantized deltas)
+	float positionPrecision = 1e-5f;		///< Quantization step (in meters) for delta encoded positions
+	float anglePrecision = 0.001f;			///< Quantization step (in degrees) for delta encoded view angles
+	int keyframeInterval = 1000;			///< Number of samples (per target) between absolute valued keyframes for delta encoded values
+
+	// Logger queue control
+	int queueCapacity = 16384;				///< Capacity (in records) of each high-rate logger queue (frame info, player actions, target trajectories)
+	String queueOverflowPolicy = "spill";	///< What to do when a logger queue is full ("block", "dropOldest", or "spill")
 
 	// Session parameter logging
 	Array<String> sessParamsToLog = { "frameRate", "frameDelay" };			///< Parameter names to log to the Sessions table of the DB
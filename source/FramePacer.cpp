@@ -0,0 +1,134 @@
+#include "FramePacer.h"
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FRAME_PACER_PAUSE() _mm_pause()
+#else
+#define FRAME_PACER_PAUSE() std::this_thread::yield()
+#endif
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+shared_ptr<FramePacer> FramePacer::create(const String& mode, float spinMarginMs, bool timingThread) {
+	if (toLower(mode) == "hybrid") return createShared<HybridFramePacer>(spinMarginMs, timingThread);
+	return createShared<SleepFramePacer>();
+}
+
+void FramePacer::sleepUntil(Clock::time_point time) {
+#ifdef _WIN32
+	// Sleep() is limited to the system timer resolution (up to 15.6ms), so use a high resolution timer where one is available (Windows 10 1803+)
+	static thread_local HANDLE timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	const Clock::duration remaining = time - Clock::now();
+	if (remaining <= Clock::duration::zero()) return;
+	if (notNull(timer)) {
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(LONGLONG)std::chrono::duration_cast<std::chrono::duration<int64, std::ratio<1, 10000000>>>(remaining).count();	// Relative, in 100ns units
+		if (SetWaitableTimer(timer, &dueTime, 0, NULL, NULL, FALSE)) {
+			WaitForSingleObject(timer, INFINITE);
+			return;
+		}
+	}
+#endif
+	std::this_thread::sleep_until(time);
+}
+
+void SleepFramePacer::wait(RealTime duration) {
+	const Clock::time_point nowAfterLoop = Clock::now();
+
+	// Compute accumulated time
+	const RealTime cumulativeTime = std::chrono::duration<RealTime>(nowAfterLoop - m_lastFrameEnd).count();
+
+	// Perform wait for target time needed
+	const RealTime desiredWaitTime = max(0.0, duration - cumulativeTime);
+	const RealTime sleepTime = max(0.0, desiredWaitTime - m_overWait) * 0.97;
+	std::this_thread::sleep_for(std::chrono::duration<RealTime>(sleepTime));
+
+	// Update wait timers
+	m_lastFrameEnd = Clock::now();
+	const RealTime actualWaitTime = std::chrono::duration<RealTime>(m_lastFrameEnd - nowAfterLoop).count();
+
+	// Learn how much the sleep appears to overshoot by and compensate
+	const RealTime thisOverWait = actualWaitTime - desiredWaitTime;
+	if (G3D::abs(thisOverWait - m_overWait) / max(G3D::abs(m_overWait), G3D::abs(thisOverWait)) > 0.4) {
+		// Abruptly change our estimate
+		m_overWait = thisOverWait;
+	}
+	else {
+		// Smoothly change our estimate
+		m_overWait = lerp(m_overWait, thisOverWait, 0.1);
+	}
+}
+
+HybridFramePacer::HybridFramePacer(float spinMarginMs, bool timingThread) {
+	m_spinMargin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(max(0.0f, spinMarginMs)));
+	if (timingThread) {
+		m_running = true;
+		m_thread = std::thread(&HybridFramePacer::timingThreadEntry, this);
+	}
+}
+
+HybridFramePacer::~HybridFramePacer() {
+	if (m_thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lk(m_mutex);
+			m_running = false;
+		}
+		m_cv.notify_one();
+		m_thread.join();
+	}
+}
+
+void HybridFramePacer::waitUntil(Clock::time_point deadline) const {
+	const Clock::time_point spinStart = deadline - m_spinMargin;
+	if (Clock::now() < spinStart) sleepUntil(spinStart);
+	while (Clock::now() < deadline) {
+		FRAME_PACER_PAUSE();
+	}
+}
+
+void HybridFramePacer::timingThreadEntry() {
+#ifdef _WIN32
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+#endif
+	std::unique_lock<std::mutex> lk(m_mutex);
+	uint64 frame = 0;
+	while (true) {
+		m_cv.wait(lk, [&] { return !m_running || m_requestedFrame != frame; });
+		if (!m_running) break;
+		frame = m_requestedFrame;
+		const Clock::time_point deadline = m_requestedDeadline;
+
+		lk.unlock();
+		waitUntil(deadline);
+		lk.lock();
+		m_completedFrame = frame;
+		m_completedCV.notify_one();
+	}
+}
+
+void HybridFramePacer::wait(RealTime duration) {
+	const Clock::time_point now = Clock::now();
+
+	// Schedule from the previous deadline, unless this frame has already missed its deadline (then restart the schedule from now)
+	Clock::time_point deadline = m_lastFrameEnd + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<RealTime>(duration));
+	if (deadline < now) deadline = now;
+
+	if (m_thread.joinable()) {
+		// Hand the deadline to the timing thread, then block (w/o using the CPU) until it signals the deadline was reached
+		std::unique_lock<std::mutex> lk(m_mutex);
+		m_requestedDeadline = deadline;
+		const uint64 frame = ++m_requestedFrame;
+		m_cv.notify_one();
+		m_completedCV.wait(lk, [&] { return m_completedFrame == frame; });
+	}
+	else {
+		waitUntil(deadline);
+	}
+
+	m_overWait = std::chrono::duration<RealTime>(Clock::now() - deadline).count();
+	m_lastFrameEnd = deadline;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <G3D/G3D.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/** Waits out the remainder of each frame to hit a target frame time (see the "framePacer" render setting).
+	Create one using FramePacer::create() and call wait() once per frame. */
+class FramePacer : public ReferenceCountedObject {
+public:
+	using Clock = std::chrono::steady_clock;
+
+protected:
+	Clock::time_point	m_lastFrameEnd;				///< Time (or deadline) the previous wait ended at
+	RealTime			m_overWait = 0.0;			///< How much the wait overshoots its target by (in seconds)
+
+	FramePacer() : m_lastFrameEnd(Clock::now()) {}
+
+public:
+	virtual ~FramePacer() {}
+
+	/** Create a pacer for a "framePacer" mode ("sleep" or "hybrid", case insensitive). Hybrid pacers spin for the last
+		spinMarginMs of each frame, optionally using a dedicated (high priority) timing thread. */
+	static shared_ptr<FramePacer> create(const String& mode, float spinMarginMs = 1.0f, bool timingThread = false);
+
+	/** Wait until duration (in seconds) after the end of the previous frame's wait */
+	virtual void wait(RealTime duration) = 0;
+
+	/** How much the wait overshoots its target by (in seconds), an estimate for "sleep" pacers and the last frame's error for "hybrid" pacers */
+	RealTime overWait() const { return m_overWait; }
+
+	/** Sleep the calling thread until time (as precisely as the OS allows) */
+	static void sleepUntil(Clock::time_point time);
+};
+
+/** The original FPSci pacer, sleeps for (slightly less than) the remaining frame time, compensating for the learned oversleep */
+class SleepFramePacer : public FramePacer {
+public:
+	virtual void wait(RealTime duration) override;
+};
+
+/** Sleeps until spinMargin before the deadline then spins on the (monotonic) clock until it. Deadlines are scheduled from the
+	previous deadline (rather than the time the previous wait ended) so wake-up error doesn't accumulate, unless a frame runs late. */
+class HybridFramePacer : public FramePacer {
+protected:
+	Clock::duration			m_spinMargin;				///< How long before the deadline to stop sleeping and start spinning
+
+	// Timing thread (if used), which does the sleeping and spinning while the frame thread blocks until it signals m_completedCV
+	std::thread				m_thread;
+	std::mutex				m_mutex;
+	std::condition_variable	m_cv;						///< Signals the timing thread (new request or stop)
+	std::condition_variable	m_completedCV;				///< Signals the frame thread (deadline reached)
+	bool					m_running = false;			///< Should the timing thread keep running? (protected by m_mutex)
+	Clock::time_point		m_requestedDeadline;		///< Deadline for the timing thread to wait until (protected by m_mutex)
+	uint64					m_requestedFrame = 0;		///< Frame m_requestedDeadline is for (protected by m_mutex)
+	uint64					m_completedFrame = 0;		///< Last frame whose deadline the timing thread has reached (protected by m_mutex)
+
+	void timingThreadEntry();
+
+	/** Sleep until the spin margin before the deadline, then spin until it */
+	void waitUntil(Clock::time_point deadline) const;
+
+public:
+	HybridFramePacer(float spinMarginMs, bool timingThread);
+	virtual ~HybridFramePacer();
+
+	virtual void wait(RealTime duration) override;
+};
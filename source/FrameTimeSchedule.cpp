@@ -0,0 +1,5 @@
+#include "FrameTimeSchedule.h"
+
+FrameTimeSchedule::FrameTimeSchedule(const Array<float>& frameTimes, bool randomize, FrameTimeMode mode, float defaultFrameTime, uint32 seed) :
+	m_frameTimes(frameTimes), m_defaultFrameTime(defaultFrameTime), m_mode(mode), m_randomized(randomize && frameTimes.size() > 1), m_seed(seed),
+	m_random(seed) {}
@@ -0,0 +1,68 @@
+#pragma once
+#include <G3D/G3D.h>
+#include "RandomStream.h"
+
+/** When the frameTimeArray is applied (the "frameTimeMode" render setting) */
+enum class FrameTimeMode {
+	Always,				///< Always use the frameTimeArray
+	TaskOnly,			///< Only use the frameTimeArray in the task state (continuing from where the previous task left off)
+	RestartWithTask		///< Only use the frameTimeArray in the task state (restarting it at the start of each task)
+};
+
+inline FrameTimeMode frameTimeModeFromString(const String& mode) {
+	const String m = toLower(mode);
+	if (m == "taskonly") return FrameTimeMode::TaskOnly;
+	if (m == "restartwithtask") return FrameTimeMode::RestartWithTask;
+	return FrameTimeMode::Always;
+}
+
+inline String frameTimeModeToString(FrameTimeMode mode) {
+	switch (mode) {
+	case FrameTimeMode::TaskOnly: return "taskOnly";
+	case FrameTimeMode::RestartWithTask: return "restartWithTask";
+	default: return "always";
+	}
+}
+
+/** The sequence of target frame times for a session, compiled once (at session start) from the frameTimeArray, frameTimeRandomize,
+	and frameTimeMode render settings. Randomized schedules draw each frame time from the frameTimeArray as it is needed, using a
+	counter-based stream seeded w/ the schedule's seed (frame i is the i-th draw), so the sequence never repeats but the exact
+	per-frame target times of a session can be reproduced from its (logged) seed. */
+class FrameTimeSchedule {
+protected:
+	Array<float>	m_frameTimes;				///< Target frame times (in seconds), cycled through in order or drawn from at random (empty to always use m_defaultFrameTime)
+	float			m_defaultFrameTime = 0.0f;	///< Target frame time (in seconds) when the frameTimeArray isn't used
+	FrameTimeMode	m_mode = FrameTimeMode::Always;
+	bool			m_randomized = false;		///< Are frame times drawn at random from m_frameTimes?
+	uint32			m_seed = 0;					///< Seed for the random draws (if randomized)
+	RandomStream	m_random;					///< Stream the frame times are drawn from (if randomized)
+	int				m_idx = 0;					///< Index of the next frame time in m_frameTimes (if not randomized)
+
+public:
+	FrameTimeSchedule() {}
+
+	/** Compile a schedule from a frameTimeArray (cycled in order, or drawn from at random using seed if randomize is set). The
+		defaultFrameTime is used when frameTimes is empty, or outside the task for the TaskOnly and RestartWithTask modes. */
+	FrameTimeSchedule(const Array<float>& frameTimes, bool randomize, FrameTimeMode mode, float defaultFrameTime, uint32 seed);
+
+	/** Get the target frame time (in seconds) for the next frame, only frames inTask advance the TaskOnly and RestartWithTask schedules */
+	float next(bool inTask) {
+		if (m_frameTimes.size() == 0 || (!inTask && m_mode != FrameTimeMode::Always)) return m_defaultFrameTime;
+		if (m_randomized) return m_frameTimes[m_random.integer(0, m_frameTimes.size() - 1)];
+		const float frameTime = m_frameTimes[m_idx];
+		if (++m_idx == m_frameTimes.size()) m_idx = 0;
+		return frameTime;
+	}
+
+	/** Called at the start of each task (restarts ordered RestartWithTask schedules, randomized ones keep drawing new values) */
+	void startTask() {
+		if (m_mode == FrameTimeMode::RestartWithTask) m_idx = 0;
+	}
+
+	/** The frameTimeArray (cycled in order, or drawn from if randomized) */
+	const Array<float>& frameTimes() const { return m_frameTimes; }
+	float defaultFrameTime() const { return m_defaultFrameTime; }
+	FrameTimeMode mode() const { return m_mode; }
+	bool randomized() const { return m_randomized; }
+	uint32 seed() const { return m_seed; }
+};
@@ -0,0 +1,278 @@
+#include "HardwareEventLogger.h"
+#include <cstdlib>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+const char* const HardwareEventParser::s_eventTypes[eventTypeCount] = { "M1", "M2", "PD", "SW" };
+
+bool HardwareEventParser::parseLine(const String& line, FPSciTimestamp arrivalTime, HardwareEvent& event) {
+	// Split "<time>:<value>" (ignoring whitespace/line endings)
+	const size_t sep = line.find(':');
+	if (sep == String::npos || sep == 0) return false;
+	const String timeStr = trimWhitespace(line.substr(0, sep));
+	const String value = trimWhitespace(line.substr(sep + 1));
+	char* end = nullptr;
+	const unsigned long long rawTime = strtoull(timeStr.c_str(), &end, 10);
+	if (timeStr.empty() || *end != '\0' || value.empty()) return false;
+
+	int typeIdx = -1;
+	for (int i = 0; i < eventTypeCount; i++) {
+		if (value == s_eventTypes[i]) typeIdx = i;
+	}
+	if (typeIdx < 0) {
+		// Anything else should be an ADC sample (which still carries a valid device time)
+		strtol(value.c_str(), &end, 10);
+		if (*end != '\0') return false;
+	}
+
+	// Unwrap the 32-bit device counter (lines arrive in order, so the signed difference is the elapsed time)
+	const uint32 raw = (uint32)rawTime;
+	m_deviceTime = m_haveDeviceTime ? m_deviceTime + (int32)(raw - m_lastRawTime) : (int64)raw;
+	m_lastRawTime = raw;
+	m_haveDeviceTime = true;
+
+	// Align the device time w/ the FPSciClock
+	if (typeIdx == 3 && m_pendingSyncTime >= 0) {
+		m_offset = m_pendingSyncTime - m_deviceTime;
+		m_pendingSyncTime = -1;
+		m_synced = true;
+	}
+	else if (!m_synced) {
+		// Soft sync, the first line received is assumed to have arrived as it happened
+		m_offset = arrivalTime - m_deviceTime;
+		m_synced = true;
+	}
+	if (typeIdx < 0) return false;
+
+	// Debounce events of the same type
+	int64& lastTime = m_lastEventTime[typeIdx];
+	if (lastTime >= 0 && m_deviceTime - lastTime < minEventSpacingUs) return false;
+	lastTime = m_deviceTime;
+
+	// Match photodetector events to the click that caused them
+	FPSciTimestamp clickTime = -1;
+	if (typeIdx == 0) {
+		m_clickTime = m_deviceTime;
+	}
+	else if (typeIdx == 2 && m_clickTime >= 0 && m_deviceTime - m_clickTime < maxClickToPhotonUs) {
+		clickTime = m_clickTime + m_offset;
+		m_clickTime = -1;
+	}
+
+	event = HardwareEvent(m_deviceTime + m_offset, s_eventTypes[typeIdx], clickTime);
+	return true;
+}
+
+#ifdef _WIN32
+
+SerialPort::SerialPort(const String& name, int baudRate, int readTimeoutMs) : m_name(name), m_readTimeoutMs(readTimeoutMs) {
+	// COM ports need exclusive access and the device namespace prefix (for ports above 9)
+	const bool isComPort = beginsWith(toUpper(name), "COM");
+	const String path = isComPort ? "\\\\.\\" + name : name;
+	const DWORD shareMode = isComPort ? 0 : FILE_SHARE_READ | FILE_SHARE_WRITE;
+	HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, shareMode, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (handle == INVALID_HANDLE_VALUE) {
+		logPrintf("Error opening serial port: %s\n", name.c_str());
+		return;
+	}
+	m_handle = handle;
+
+	// A regular file can stand in for the device w/o any setup
+	m_isDevice = GetFileType(handle) == FILE_TYPE_CHAR;
+	if (!m_isDevice) return;
+
+	DCB dcb;
+	ZeroMemory(&dcb, sizeof(dcb));
+	dcb.DCBlength = sizeof(dcb);
+	if (GetCommState(handle, &dcb)) {
+		dcb.BaudRate = (DWORD)baudRate;
+		dcb.ByteSize = 8;
+		dcb.Parity = NOPARITY;
+		dcb.StopBits = ONESTOPBIT;
+		dcb.fDtrControl = DTR_CONTROL_DISABLE;
+		SetCommState(handle, &dcb);
+	}
+
+	// Return as soon as any data is available, or after the timeout
+	COMMTIMEOUTS timeouts;
+	ZeroMemory(&timeouts, sizeof(timeouts));
+	timeouts.ReadIntervalTimeout = MAXDWORD;
+	timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+	timeouts.ReadTotalTimeoutConstant = (DWORD)readTimeoutMs;
+	timeouts.WriteTotalTimeoutConstant = 100;
+	SetCommTimeouts(handle, &timeouts);
+}
+
+SerialPort::~SerialPort() {
+	if (notNull(m_handle)) CloseHandle(m_handle);
+}
+
+bool SerialPort::valid() const {
+	return notNull(m_handle);
+}
+
+int SerialPort::read(char* buffer, int size) {
+	DWORD bytesRead = 0;
+	if (!ReadFile(m_handle, buffer, (DWORD)size, &bytesRead, NULL)) return -1;
+	if (bytesRead == 0 && !m_isDevice) {
+		// At the end of a file, wait for more to be appended (like a device w/ no data)
+		Sleep((DWORD)m_readTimeoutMs);
+	}
+	return (int)bytesRead;
+}
+
+bool SerialPort::write(const String& data) {
+	if (!m_isDevice) return true;
+	DWORD bytesWritten = 0;
+	return WriteFile(m_handle, data.c_str(), (DWORD)data.size(), &bytesWritten, NULL) && bytesWritten == (DWORD)data.size();
+}
+
+void SerialPort::purgeInput() {
+	if (m_isDevice) PurgeComm(m_handle, PURGE_RXCLEAR);
+}
+
+void SerialPort::pulseDTR() {
+	if (!m_isDevice) return;
+	EscapeCommFunction(m_handle, SETDTR);
+	EscapeCommFunction(m_handle, CLRDTR);
+}
+
+#else
+
+static speed_t baudRateToSpeed(int baudRate) {
+	switch (baudRate) {
+	case 9600: return B9600;
+	case 19200: return B19200;
+	case 38400: return B38400;
+	case 57600: return B57600;
+	case 230400: return B230400;
+	default: return B115200;
+	}
+}
+
+SerialPort::SerialPort(const String& name, int baudRate, int readTimeoutMs) : m_name(name), m_readTimeoutMs(readTimeoutMs) {
+	m_fd = open(name.c_str(), O_RDWR | O_NOCTTY);
+	if (m_fd < 0) {
+		logPrintf("Error opening serial port: %s\n", name.c_str());
+		return;
+	}
+
+	// Use raw mode for terminals (a regular file can stand in for the device w/o any setup)
+	m_isDevice = isatty(m_fd) != 0;
+	if (m_isDevice) {
+		termios tty;
+		if (tcgetattr(m_fd, &tty) == 0) {
+			cfmakeraw(&tty);
+			cfsetispeed(&tty, baudRateToSpeed(baudRate));
+			cfsetospeed(&tty, baudRateToSpeed(baudRate));
+			tty.c_cflag |= CLOCAL | CREAD;
+			tcsetattr(m_fd, TCSANOW, &tty);
+		}
+	}
+}
+
+SerialPort::~SerialPort() {
+	if (m_fd >= 0) close(m_fd);
+}
+
+bool SerialPort::valid() const {
+	return m_fd >= 0;
+}
+
+int SerialPort::read(char* buffer, int size) {
+	pollfd pfd = { m_fd, POLLIN, 0 };
+	const int ready = poll(&pfd, 1, m_readTimeoutMs);
+	if (ready < 0) return -1;
+	if (ready == 0) return 0;
+	const ssize_t bytesRead = ::read(m_fd, buffer, (size_t)size);
+	if (bytesRead == 0 && !m_isDevice) {
+		// At the end of a file, wait for more to be appended (like a device w/ no data)
+		std::this_thread::sleep_for(std::chrono::milliseconds(m_readTimeoutMs));
+	}
+	return (int)bytesRead;
+}
+
+bool SerialPort::write(const String& data) {
+	if (!m_isDevice) return true;
+	return ::write(m_fd, data.c_str(), data.size()) == (ssize_t)data.size();
+}
+
+void SerialPort::purgeInput() {
+	if (m_isDevice) tcflush(m_fd, TCIFLUSH);
+}
+
+void SerialPort::pulseDTR() {
+	if (!m_isDevice) return;
+	int dtr = TIOCM_DTR;
+	ioctl(m_fd, TIOCMBIS, &dtr);
+	ioctl(m_fd, TIOCMBIC, &dtr);
+}
+
+#endif
+
+HardwareEventLogger::HardwareEventLogger(const String& comPort, const String& syncComPort) : m_running(false) {
+	m_port = SerialPort::create(comPort, baudRate);
+	if (!m_port->valid()) {
+		logPrintf("WARNING: Could not open the hardware event logger on %s, no hardware events will be logged!\n", comPort.c_str());
+		return;
+	}
+
+	// Discard anything sent before now and turn off ADC reporting (only events are logged)
+	m_port->purgeInput();
+	m_port->write("aoff\n");
+
+	// Sync the logger to the FPSciClock (otherwise it is synced from the arrival times of the events)
+	if (!syncComPort.empty()) {
+		m_syncPort = SerialPort::create(syncComPort, baudRate);
+		if (m_syncPort->valid()) {
+			m_syncPort->pulseDTR();
+			m_parser.hardSync(FPSciClock::now());
+		}
+		else {
+			logPrintf("WARNING: Could not open the hardware event logger sync port %s, syncing to event arrival times instead\n", syncComPort.c_str());
+		}
+	}
+
+	m_running = true;
+	m_thread = std::thread(&HardwareEventLogger::readerThreadEntry, this);
+	logPrintf("Started hardware event logger on %s\n", comPort.c_str());
+}
+
+HardwareEventLogger::~HardwareEventLogger() {
+	m_running = false;
+	if (m_thread.joinable()) m_thread.join();
+}
+
+void HardwareEventLogger::readerThreadEntry() {
+	char buffer[256];
+	String pending;				// Received characters not yet terminated by a newline
+	HardwareEvent event;
+	while (m_running) {
+		const int count = m_port->read(buffer, sizeof(buffer));
+		if (count < 0) {
+			logPrintf("Error reading from the hardware event logger on %s, stopping\n", m_port->name().c_str());
+			break;
+		}
+		if (count == 0) continue;
+
+		// Timestamp the data as soon as it arrives (used to sync the logger when there is no sync port)
+		const FPSciTimestamp arrivalTime = FPSciClock::now();
+		pending.append(buffer, (size_t)count);
+		size_t start = 0;
+		for (size_t end = pending.find('\n'); end != String::npos; end = pending.find('\n', start)) {
+			if (m_parser.parseLine(pending.substr(start, end - start), arrivalTime, event)) {
+				std::lock_guard<std::mutex> lk(m_callbackMutex);
+				if (m_callback) m_callback(event);
+			}
+			start = end + 1;
+		}
+		pending = pending.substr(start);
+	}
+}
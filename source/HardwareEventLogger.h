@@ -0,0 +1,134 @@
+#pragma once
+#include <G3D/G3D.h>
+#include "FPSciClock.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/** An event reported by the hardware (click-to-photon) event logger */
+struct HardwareEvent {
+	FPSciTimestamp	time = 0;					///< Time of the event (on the FPSciClock timebase)
+	String			event;						///< Event type ("M1", "M2", "PD", or "SW")
+	FPSciTimestamp	clickTime = -1;				///< For a "PD" event caused by a click, the time of the click (otherwise -1)
+
+	HardwareEvent() {}
+	HardwareEvent(FPSciTimestamp t, const String& type, FPSciTimestamp click = -1) : time(t), event(type), clickTime(click) {}
+
+	/** Click-to-photon latency (in ms) for a "PD" event caused by a click */
+	float clickToPhotonMs() const { return (float)(time - clickTime) / 1000.0f; }
+};
+
+/** Parses the line protocol sent by the hardware event logger, one "<device time (us)>:<event>" line at a time, where the event
+	is one of "M1" (left mouse), "M2" (right mouse), "PD" (photodetector), or "SW" (software/sync interrupt), or an integer ADC sample.
+
+	Device times come from the logger's 32-bit microsecond counter (which wraps every ~71 minutes) and are converted to the FPSciClock
+	timebase using either a hard sync (a DTR pulse whose wall-clock time is known, which the logger reports as the next "SW" event) or
+	a soft sync from the time the first line arrives at. Events are debounced (per type) and "PD" events within maxClickToPhotonUs of a click
+	are matched to it, as done by the (Python) event logger scripts. */
+class HardwareEventParser {
+public:
+	static const int64 minEventSpacingUs = 100000;		///< Minimum time between two events of the same type (shorter gaps are bounces)
+	static const int64 maxClickToPhotonUs = 300000;		///< Maximum delay between a click and the photodetector event it caused
+
+protected:
+	static const int eventTypeCount = 4;
+	static const char* const s_eventTypes[eventTypeCount];
+
+	bool			m_haveDeviceTime = false;
+	uint32			m_lastRawTime = 0;					///< Last (wrapping) device time received
+	int64			m_deviceTime = 0;					///< Last device time received (unwrapped)
+
+	bool			m_synced = false;					///< Is m_offset valid?
+	FPSciTimestamp	m_pendingSyncTime = -1;				///< Time of a sync pulse whose "SW" event hasn't been received yet (or -1)
+	int64			m_offset = 0;						///< FPSciClock time - device time
+
+	int64			m_lastEventTime[eventTypeCount] = { -1, -1, -1, -1 };		///< Device time of the last (debounced) event of each type
+	int64			m_clickTime = -1;					///< Device time of the last click not yet matched to a photodetector event (or -1)
+
+public:
+	/** Note that a sync pulse was sent to the logger at wallTime, the next "SW" event is aligned to this time */
+	void hardSync(FPSciTimestamp wallTime) { m_pendingSyncTime = wallTime; }
+
+	/** Is the device time synchronized to the FPSciClock? */
+	bool synced() const { return m_synced; }
+
+	/** Parse a line (w/o the line ending) received at arrivalTime, returns true if it was an event (returned in event) */
+	bool parseLine(const String& line, FPSciTimestamp arrivalTime, HardwareEvent& event);
+};
+
+/** Platform-independent (blocking w/ timeout) serial port, also usable w/ a pseudo-terminal or a file standing in for the device */
+class SerialPort {
+protected:
+	String		m_name;
+#ifdef _WIN32
+	void*		m_handle = nullptr;
+#else
+	int			m_fd = -1;
+#endif
+	bool		m_isDevice = false;		///< Is this a serial device/terminal (rather than a file standing in for one)?
+	int			m_readTimeoutMs;
+
+public:
+	SerialPort(const String& name, int baudRate, int readTimeoutMs);
+	virtual ~SerialPort();
+
+	static shared_ptr<SerialPort> create(const String& name, int baudRate = 115200, int readTimeoutMs = 100) {
+		return createShared<SerialPort>(name, baudRate, readTimeoutMs);
+	}
+
+	bool valid() const;
+	const String& name() const { return m_name; }
+
+	/** Read up to size bytes, waiting up to the read timeout for data. Returns the number of bytes read (0 on timeout) or -1 on error */
+	int read(char* buffer, int size);
+
+	/** Write a string to the port (a file standing in for the device is only read), returns false on error */
+	bool write(const String& data);
+
+	/** Discard any received data that hasn't been read yet */
+	void purgeInput();
+
+	/** Toggle the DTR line (used to send a sync pulse) */
+	void pulseDTR();
+};
+
+/** Native replacement for the event_logger.py script. Reads events from the hardware event logger on a background thread and
+	passes them (timestamped on the FPSciClock timebase) to a callback, e.g. to write them into the results file. */
+class HardwareEventLogger : public ReferenceCountedObject {
+public:
+	static const int baudRate = 115200;
+
+	/** Called (from the reader thread) for each event received */
+	using EventCallback = std::function<void(const HardwareEvent&)>;
+
+protected:
+	shared_ptr<SerialPort>		m_port;					///< Port the event logger is connected to
+	shared_ptr<SerialPort>		m_syncPort;				///< Port whose DTR line is used to sync the logger (null if none)
+	HardwareEventParser			m_parser;				///< Parser for the received lines (only used from the reader thread)
+
+	std::mutex					m_callbackMutex;		///< Held while calling the callback (so it can be safely replaced)
+	EventCallback				m_callback;				///< Where to send events (events are discarded if this is empty)
+
+	std::atomic<bool>			m_running;
+	std::thread					m_thread;
+
+	void readerThreadEntry();
+
+public:
+	HardwareEventLogger(const String& comPort, const String& syncComPort);
+	virtual ~HardwareEventLogger();
+
+	/** Open the event logger on comPort (and sync it using the DTR line of syncComPort if it isn't empty), and start reading events */
+	static shared_ptr<HardwareEventLogger> create(const String& comPort, const String& syncComPort = "") {
+		return createShared<HardwareEventLogger>(comPort, syncComPort);
+	}
+
+	bool valid() const { return notNull(m_port) && m_port->valid(); }
+
+	/** Set where events are sent (or pass nullptr to discard them). Once this returns the previous callback won't be called again. */
+	void setCallback(const EventCallback& callback) {
+		std::lock_guard<std::mutex> lk(m_callbackMutex);
+		m_callback = callback;
+	}
+};
@@ -0,0 +1,112 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(int workerCount) {
+	if (workerCount < 0) workerCount = max((int)std::thread::hardware_concurrency() - 1, 0);
+	for (int i = 0; i <= workerCount; i++) m_queues.append(new Queue());
+	for (int i = 1; i <= workerCount; i++) m_threads.push_back(std::thread(&JobSystem::workerThreadEntry, this, i));
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lk(m_wakeMutex);
+		m_stop = true;
+	}
+	m_wakeCondition.notify_all();
+	for (std::thread& thread : m_threads) thread.join();
+	m_queues.deleteAll();
+}
+
+bool JobSystem::takeJob(int queueIdx, Job& job) {
+	// Newest job from our own queue first (its data is most likely still in cache)
+	{
+		Queue* queue = m_queues[queueIdx];
+		std::lock_guard<std::mutex> lk(queue->mutex);
+		if (!queue->jobs.empty()) {
+			job = queue->jobs.back();
+			queue->jobs.pop_back();
+			m_queuedJobs--;
+			return true;
+		}
+	}
+	// Otherwise steal the oldest job from another queue
+	for (int i = 1; i < m_queues.size(); i++) {
+		Queue* queue = m_queues[(queueIdx + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lk(queue->mutex);
+		if (!queue->jobs.empty()) {
+			job = queue->jobs.front();
+			queue->jobs.pop_front();
+			m_queuedJobs--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::runJob(const Job& job) {
+	Batch* batch = job.batch;
+	try {
+		(*batch->function)(job.begin, job.end);
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lk(batch->errorMutex);
+		if (!batch->error) batch->error = std::current_exception();
+	}
+	// The batch (owned by the parallelFor() caller) can't be used after the last job is marked complete
+	if (--batch->remaining == 0) {
+		std::lock_guard<std::mutex> lk(m_doneMutex);
+		m_doneCondition.notify_all();
+	}
+}
+
+void JobSystem::workerThreadEntry(int queueIdx) {
+	while (true) {
+		Job job;
+		if (takeJob(queueIdx, job)) {
+			runJob(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lk(m_wakeMutex);
+		m_wakeCondition.wait(lk, [this] { return m_stop || m_queuedJobs > 0; });
+		if (m_stop) return;
+	}
+}
+
+void JobSystem::parallelFor(int count, int grainSize, const RangeFunction& function) {
+	if (count <= 0) return;
+	grainSize = max(grainSize, 1);
+	if (m_threads.size() == 0 || count <= grainSize) {
+		function(0, count);
+		return;
+	}
+
+	Batch batch;
+	batch.function = &function;
+	const int jobCount = (count + grainSize - 1) / grainSize;
+	batch.remaining = jobCount;
+
+	// Deal the chunks out to the queues (round robin), then wake the workers
+	for (int j = 0; j < jobCount; j++) {
+		Job job;
+		job.batch = &batch;
+		job.begin = j * grainSize;
+		job.end = min(job.begin + grainSize, count);
+		Queue* queue = m_queues[j % m_queues.size()];
+		std::lock_guard<std::mutex> lk(queue->mutex);
+		queue->jobs.push_back(job);
+	}
+	{
+		std::lock_guard<std::mutex> lk(m_wakeMutex);
+		m_queuedJobs += jobCount;
+	}
+	m_wakeCondition.notify_all();
+
+	// Work on the batch from this thread too, then wait for jobs still running on the workers
+	Job job;
+	while (takeJob(0, job)) runJob(job);
+	{
+		std::unique_lock<std::mutex> lk(m_doneMutex);
+		m_doneCondition.wait(lk, [&batch] { return batch.remaining == 0; });
+	}
+
+	if (batch.error) std::rethrow_exception(batch.error);
+}
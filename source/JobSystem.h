@@ -0,0 +1,76 @@
+#pragma once
+#include <G3D/G3D.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** A fixed pool of worker threads that run the chunks of parallelFor() calls w/ work stealing.
+
+	Each thread (the workers and the calling thread) has its own job queue. parallelFor() splits its range into chunks, deals them
+	out to the queues round-robin, then runs chunks along w/ the workers until none are left. Threads take jobs from the back of their
+	own queue and steal from the front of the others' once it is empty, so an uneven split (i.e. some targets being more expensive to
+	simulate than others) is evened out.
+
+	parallelFor() is meant to be called from a single (the main) thread and blocks until the whole range is done, jobs must not call
+	it themselves. An exception thrown by a job is rethrown from parallelFor() (once all jobs are done). */
+class JobSystem {
+public:
+	typedef std::function<void(int begin, int end)> RangeFunction;
+
+protected:
+	/** A parallelFor() call */
+	struct Batch {
+		const RangeFunction*	function = nullptr;
+		std::atomic<int>		remaining{ 0 };				///< Jobs not yet completed
+		std::mutex				errorMutex;
+		std::exception_ptr		error;						///< First exception thrown by a job (if any)
+	};
+
+	/** A chunk of a parallelFor() range */
+	struct Job {
+		Batch*	batch = nullptr;
+		int		begin = 0;
+		int		end = 0;
+	};
+
+	/** Job queue for a thread (index 0 is the thread calling parallelFor()) */
+	struct Queue {
+		std::mutex			mutex;
+		std::deque<Job>		jobs;
+	};
+
+	std::vector<std::thread>	m_threads;
+	Array<Queue*>				m_queues;
+
+	std::mutex					m_wakeMutex;
+	std::condition_variable		m_wakeCondition;			///< Signaled when jobs are queued (or on shutdown)
+	std::atomic<int>			m_queuedJobs{ 0 };			///< Jobs queued but not yet taken
+	bool						m_stop = false;
+
+	std::mutex					m_doneMutex;
+	std::condition_variable		m_doneCondition;			///< Signaled when the last job of a batch completes
+
+	/** Take a job from this thread's queue, or steal one from another queue */
+	bool takeJob(int queueIdx, Job& job);
+	void runJob(const Job& job);
+	void workerThreadEntry(int queueIdx);
+
+public:
+	/** Creates workerCount worker threads (negative for one less than the number of hardware threads, 0 runs everything on the caller) */
+	explicit JobSystem(int workerCount = -1);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	int workerCount() const { return (int)m_threads.size(); }
+
+	/** Call function(begin, end) for chunks (of at most grainSize) covering [0, count), in parallel, and wait for them to finish.
+		Ranges of no more than grainSize are run directly on the calling thread. */
+	void parallelFor(int count, int grainSize, const RangeFunction& function);
+};
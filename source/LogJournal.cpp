@@ -0,0 +1,161 @@
+#include "LogJournal.h"
+#include <cstring>
+#include <cstddef>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static const char s_journalMagic[8] = { 'F', 'P', 'S', 'C', 'I', 'J', 'N', 'L' };
+
+static_assert(sizeof(std::atomic<uint64>) == sizeof(uint64), "Journal header requires 64-bit atomics w/o extra storage");
+
+static inline uint32 readUint32(const uint8* p) {
+	return (uint32)p[0] | ((uint32)p[1] << 8) | ((uint32)p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+static inline void writeUint32(uint8* p, uint32 value) {
+	for (int i = 0; i < 4; i++) p[i] = (uint8)(value >> (8 * i));
+}
+
+LogJournal::LogJournal(const String& filename, size_t dataSize) : m_filename(filename), m_dataSize(dataSize) {
+	m_mappedSize = sizeof(Header) + dataSize;
+	void* mapped = nullptr;
+#ifdef _WIN32
+	m_fileHandle = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_fileHandle == INVALID_HANDLE_VALUE) {
+		m_fileHandle = nullptr;
+		logPrintf("Error creating logger journal: %s\n", filename.c_str());
+		return;
+	}
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, NULL, PAGE_READWRITE, (DWORD)((uint64)m_mappedSize >> 32), (DWORD)(m_mappedSize & 0xFFFFFFFF), NULL);
+	if (notNull(m_mappingHandle)) {
+		mapped = MapViewOfFile(m_mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, m_mappedSize);
+	}
+#else
+	m_fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (m_fd < 0) {
+		logPrintf("Error creating logger journal: %s\n", filename.c_str());
+		return;
+	}
+	if (ftruncate(m_fd, (off_t)m_mappedSize) == 0) {
+		mapped = mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+		if (mapped == MAP_FAILED) mapped = nullptr;
+	}
+#endif
+	if (isNull(mapped)) {
+		logPrintf("Error mapping logger journal: %s\n", filename.c_str());
+		unmap();
+		return;
+	}
+
+	m_header = new (mapped) Header();
+	memcpy(m_header->magic, s_journalMagic, sizeof(s_journalMagic));
+	m_header->version = version;
+	m_header->reserved = 0;
+	m_header->dataSize = dataSize;
+	m_header->writePos.store(0);
+	m_header->committedPos.store(0);
+	m_data = (uint8*)mapped + sizeof(Header);
+}
+
+LogJournal::~LogJournal() {
+	unmap();
+}
+
+void LogJournal::unmap() {
+#ifdef _WIN32
+	if (notNull(m_header)) UnmapViewOfFile(m_header);
+	if (notNull(m_mappingHandle)) CloseHandle(m_mappingHandle);
+	if (notNull(m_fileHandle)) CloseHandle(m_fileHandle);
+	m_mappingHandle = nullptr;
+	m_fileHandle = nullptr;
+#else
+	if (notNull(m_header)) munmap(m_header, m_mappedSize);
+	if (m_fd >= 0) ::close(m_fd);
+	m_fd = -1;
+#endif
+	m_header = nullptr;
+	m_data = nullptr;
+}
+
+bool LogJournal::append(uint8 type, const uint8* data, uint32 size) {
+	if (!valid()) return false;
+	const uint32 recordSize = recordHeaderSize + size;
+	uint64 pos = m_header->writePos.load(std::memory_order_relaxed);		// Only the producer writes this
+	const uint64 committed = m_header->committedPos.load(std::memory_order_acquire);
+
+	// Records don't wrap, pad out the end of the ring if this one doesn't fit
+	const uint64 offset = pos % m_dataSize;
+	const uint64 padding = (offset + recordSize > m_dataSize) ? m_dataSize - offset : 0;
+	if (pos + padding + recordSize - committed > m_dataSize) {
+		m_skipped++;
+		return false;
+	}
+	if (padding > 0) {
+		// A padding "record" (w/ at least a length) or zeroed bytes (too small for a header) both mean skip to the start
+		if (padding >= recordHeaderSize) {
+			writeUint32(m_data + offset, (uint32)padding);
+			m_data[offset + 4] = Padding;
+		}
+		else {
+			memset(m_data + offset, 0, (size_t)padding);
+		}
+		pos += padding;
+	}
+
+	// Write the record, then publish it by advancing the write position
+	uint8* record = m_data + (pos % m_dataSize);
+	writeUint32(record, recordSize);
+	record[4] = type;
+	memcpy(record + recordHeaderSize, data, size);
+	m_header->writePos.store(pos + recordSize, std::memory_order_release);
+	return true;
+}
+
+void LogJournal::close() {
+	if (!valid()) return;
+	const bool committed = m_header->committedPos.load() >= m_header->writePos.load();
+	unmap();
+	if (committed) {
+		FileSystem::removeFile(m_filename);
+	}
+	else {
+		logPrintf("Logger journal %s has uncommitted records, it will be replayed when the results file is next opened\n", m_filename.c_str());
+	}
+}
+
+int LogJournal::replay(const String& filename, const RecordCallback& callback) {
+	const String contents = readWholeFile(filename);
+	const uint8* bytes = (const uint8*)contents.c_str();
+	if (contents.size() < sizeof(Header) || memcmp(bytes, s_journalMagic, sizeof(s_journalMagic)) != 0) return -1;
+
+	// Read the header fields directly (the atomics are plain 64-bit values in the file)
+	uint32 fileVersion;
+	uint64 dataSize, writePos, pos;
+	memcpy(&fileVersion, bytes + offsetof(Header, version), sizeof(fileVersion));
+	memcpy(&dataSize, bytes + offsetof(Header, dataSize), sizeof(dataSize));
+	memcpy(&writePos, bytes + offsetof(Header, writePos), sizeof(writePos));
+	memcpy(&pos, bytes + offsetof(Header, committedPos), sizeof(pos));
+	if (fileVersion != version || dataSize == 0 || contents.size() < sizeof(Header) + dataSize || pos > writePos) return -1;
+
+	const uint8* data = bytes + sizeof(Header);
+	int count = 0;
+	while (pos < writePos) {
+		const uint64 offset = pos % dataSize;
+		const uint64 remaining = dataSize - offset;
+		if (remaining < recordHeaderSize) { pos += remaining; continue; }		// Zero padding at the end of the ring
+		const uint32 recordSize = readUint32(data + offset);
+		if (recordSize < recordHeaderSize || recordSize > remaining) return count;		// Corrupt record, stop here
+		const uint8 type = data[offset + 4];
+		if (type != Padding) {
+			callback(type, data + offset + recordHeaderSize, recordSize - recordHeaderSize);
+			count++;
+		}
+		pos += recordSize;
+	}
+	return count;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <G3D/G3D.h>
+#include <atomic>
+#include <functional>
+
+/** Memory-mapped, append-only recovery journal for logger records (see docs/resultsFiles.md).
+
+	The producer (main) thread appends each record to a mapped file as it is logged. The logger thread marks the
+	journal as committed up to a position once the records before it have been committed to the results file. Since
+	the file is memory-mapped, records survive a crash (or kill) of the process without any per-record system calls.
+	Any records past the committed position are replayed into the results file the next time it is opened.
+
+	The data region is used as a ring: positions are monotonic byte offsets, wrapped into the data region when
+	writing. If the uncommitted records would overrun the ring the record is not journaled (and counted as skipped),
+	so the producer never waits on the logger thread.
+
+	Each record is a 4 byte (little-endian) length (of the whole record), a 1 byte type, and the payload. Records
+	never wrap, a Padding record fills the space at the end of the ring when the next record doesn't fit. */
+class LogJournal : public ReferenceCountedObject {
+public:
+	/** Record type reserved for padding (users of the journal define their own types starting at 1) */
+	static const uint8 Padding = 0;
+	static const uint32 version = 2;			///< 2: logger records start w/ a sequence number (see FPSciLogger::replayJournal())
+	static const uint32 recordHeaderSize = 5;
+
+	/** Header at the start of the mapped file */
+	struct Header {
+		char				magic[8];
+		uint32				version;
+		uint32				reserved;
+		uint64				dataSize;			///< Size of the (ring) data region following the header
+		std::atomic<uint64>	writePos;			///< Position after the last complete record (written by the producer)
+		std::atomic<uint64>	committedPos;		///< Position up to which records are in the results file (written by the logger thread)
+	};
+
+	/** Called for each record replayed from a journal */
+	using RecordCallback = std::function<void(uint8 type, const uint8* data, uint32 size)>;
+
+protected:
+	String		m_filename;							///< Name of the journal file
+	Header*		m_header = nullptr;					///< Mapped header (null if the journal couldn't be created)
+	uint8*		m_data = nullptr;					///< Mapped (ring) data region
+	uint64		m_dataSize = 0;						///< Size of the data region
+	size_t		m_mappedSize = 0;					///< Total size of the mapping
+	int64		m_skipped = 0;						///< Number of records not journaled because the ring was full (producer only)
+
+#ifdef _WIN32
+	void*		m_fileHandle = nullptr;
+	void*		m_mappingHandle = nullptr;
+#else
+	int			m_fd = -1;
+#endif
+
+	void unmap();
+
+public:
+	LogJournal(const String& filename, size_t dataSize);
+	virtual ~LogJournal();
+
+	/** Create a new (empty) journal, replacing any existing file w/ this name */
+	static shared_ptr<LogJournal> create(const String& filename, size_t dataSize) {
+		return createShared<LogJournal>(filename, dataSize);
+	}
+
+	/** Read the uncommitted records from an existing journal file, returns the number of records replayed (or -1 if the file isn't a valid journal) */
+	static int replay(const String& filename, const RecordCallback& callback);
+
+	bool valid() const { return notNull(m_header); }
+	const String& filename() const { return m_filename; }
+	int64 skippedCount() const { return m_skipped; }
+
+	/** Append a record (producer thread only), returns false if the record wasn't journaled */
+	bool append(uint8 type, const uint8* data, uint32 size);
+
+	/** Current write position, records before this position are complete */
+	uint64 writePosition() const { return m_header->writePos.load(std::memory_order_acquire); }
+
+	/** Mark everything before pos as committed to the results file (logger thread only) */
+	void commit(uint64 pos) { m_header->committedPos.store(pos, std::memory_order_release); }
+
+	/** Close the journal, deleting the file if all records were committed */
+	void close();
+};
@@ -2,57 +2,64 @@
 #include "Session.h"
 #include "FPSciApp.h"
 
-// TODO: Replace with the G3D timestamp uses.
+/** Frame_Info columns for the (optional, see logFrameTiming) per-phase frame timing */
+static const struct {
+	const char* name;
+	float FrameTiming::* field;
+} s_frameTimingColumns[] = {
+	{ "user_input_ms", &FrameTiming::userInputMs },
+	{ "network_ms", &FrameTiming::networkMs },
+	{ "logic_ms", &FrameTiming::logicMs },
+	{ "simulation_ms", &FrameTiming::simulationMs },
+	{ "pose_ms", &FrameTiming::poseMs },
+	{ "wait_ms", &FrameTiming::waitMs },
+	{ "graphics_ms", &FrameTiming::graphicsMs },
+	{ "over_wait_ms", &FrameTiming::overWaitMs },
+	{ "target_frame_time_ms", &FrameTiming::targetFrameTimeMs },
+};
+static const int s_frameTimingColumnCount = sizeof(s_frameTimingColumns) / sizeof(s_frameTimingColumns[0]);
+
 // utility function for generating a unique timestamp.
 String FPSciLogger::genUniqueTimestamp() {
-	return formatFileTime(getFileTime());
-}
-
-FILETIME FPSciLogger::getFileTime() {
-	FILETIME ft;
-	GetSystemTimePreciseAsFileTime(&ft);
-	return ft;
-}
-
-String FPSciLogger::formatFileTime(FILETIME ft) {
-	unsigned long long usecsinceepoch = (static_cast<unsigned long long>(ft.dwHighDateTime) << 32 | ft.dwLowDateTime) / 10;		// Get time since epoch in usec
-	int usec = usecsinceepoch % 1000000;
-
-	SYSTEMTIME datetime;
-	FileTimeToSystemTime(&ft, &datetime);
-
-	char tmCharArray[30] = { 0 };
-	sprintf(tmCharArray, "%04d-%02d-%02d %02d:%02d:%02d.%06d", datetime.wYear, datetime.wMonth, datetime.wDay, datetime.wHour, datetime.wMinute, datetime.wSecond, usec);
-	std::string timeStr(tmCharArray);
-	return String(timeStr);
+	return FPSciClock::format(FPSciClock::now());
 }
 
-
 String FPSciLogger::genFileTimestamp() {
-	_SYSTEMTIME t;
-	GetSystemTime(&t);
-	char tmCharArray[30] = { 0 };
-	sprintf(tmCharArray, "%04d_%02d_%02d-%02d_%02d_%02d", t.wYear, t.wMonth, t.wDay, t.wHour, t.wMinute, t.wSecond);
-	std::string timeStr(tmCharArray);
-	return String(timeStr);
+	return FPSciClock::formatForFilename(FPSciClock::now());
 }
 
 void FPSciLogger::initResultsFile(const String& filename, 
-	const String& subjectID, 
-	const String& expConfigFilename,
-	const shared_ptr<SessionConfig>& sessConfig, 
-	const String& description)
+	const ExperimentInfo& experiment,
+	const shared_ptr<SessionConfig>& sessConfig)
 {
+	m_filename = filename;
 	const bool createNewFile = !FileSystem::exists(filename);
 
 	// Open the file
 	if (sqlite3_open(filename.c_str(), &m_db)) {
 		logPrintf(("Error opening log file: " + filename).c_str());					// Write an error to the log
 	}
+	applyPragmas();
+
+	// Use the timestamp format of the existing schema when appending to a results file
+	m_integerTimestamps = m_config.timestampFormat == "integer";
+	if (!createNewFile) {
+		const bool fileUsesIntegerTimestamps = tableExistsInDB(m_db, "Frame_Info_Raw");
+		if (fileUsesIntegerTimestamps != m_integerTimestamps) {
+			logPrintf("WARNING: Results file %s uses %s timestamps (ignoring \"logTimestampFormat\" = \"%s\")\n",
+				filename.c_str(), fileUsesIntegerTimestamps ? "integer" : "text", m_config.timestampFormat.c_str());
+		}
+		m_integerTimestamps = fileUsesIntegerTimestamps;
+	}
+
+	// Only the columnar file is delta encoded
+	if (m_config.trajectoryEncoding == "delta" && !m_config.logToColumnarFile) {
+		logPrintf("WARNING: \"logTrajectoryEncoding\" = \"delta\" has no effect unless \"logToColumnarFile\" is set\n");
+	}
 
 	// Create tables if a new log file is opened
 	if (createNewFile) {
-		createExperimentsTable(expConfigFilename);
+		createExperimentsTable(experiment);
 		createSessionsTable(sessConfig);
 		createTargetTypeTable();
 		createTargetsTable();
@@ -63,13 +70,203 @@ void FPSciLogger::initResultsFile(const String& filename,
 		createQuestionsTable();
 		createUsersTable();
 	}
+	else if (m_config.logFrameTiming) {
+		addFrameTimingColumns();
+	}
+
+	prepareInserts();
+
+	// Recover anything a previous (crashed) run left in the journal, then start a new one
+	replayJournal();
+	if (m_config.logRecoveryJournal) {
+		createJournalCommitsTable();
+		m_journal = LogJournal::create(journalFilename(), (size_t)m_config.recoveryJournalSizeMB * 1024 * 1024);
+		if (!m_journal->valid()) m_journal.reset();
+	}
+}
+
+String FPSciLogger::journalFilename() const {
+	return (endsWith(m_filename, ".db") ? m_filename.substr(0, m_filename.size() - 3) : m_filename) + ".fpjournal";
+}
+
+// Journal record serialization (fixed size fields are stored in native byte order)
+template<typename T> static inline void journalWrite(Array<uint8>& buf, const T& value) {
+	const int start = buf.size();
+	buf.resize(start + (int)sizeof(T));
+	memcpy(buf.getCArray() + start, &value, sizeof(T));
+}
+
+static inline void journalWrite(Array<uint8>& buf, const String& str) {
+	journalWrite(buf, (uint32)str.size());
+	const int start = buf.size();
+	buf.resize(start + (int)str.size());
+	memcpy(buf.getCArray() + start, str.c_str(), str.size());
+}
+
+/** Reads the fields of a journal record (in the order written) */
+class JournalReader {
+protected:
+	const uint8*	m_data;
+	uint32			m_size;
+	uint32			m_pos = 0;
+public:
+	JournalReader(const uint8* data, uint32 size) : m_data(data), m_size(size) {}
+	bool ok() const { return m_pos <= m_size; }
+	bool atEnd() const { return m_pos >= m_size; }
+
+	template<typename T> T read() {
+		T value = T();
+		if (m_pos + sizeof(T) <= m_size) memcpy(&value, m_data + m_pos, sizeof(T));
+		m_pos += sizeof(T);
+		return value;
+	}
+	String readString() {
+		const uint32 length = read<uint32>();
+		if (m_pos + length > m_size) { m_pos = m_size + 1; return ""; }
+		const String str((const char*)m_data + m_pos, length);
+		m_pos += length;
+		return str;
+	}
+};
+
+void FPSciLogger::journalRecord(const FrameInfo& info) {
+	m_journalScratch.fastClear();
+	journalWrite(m_journalScratch, info.journalSeq);
+	journalWrite(m_journalScratch, info.time);
+	journalWrite(m_journalScratch, info.sdt);
+	if (m_config.logFrameTiming) journalWrite(m_journalScratch, info.timing);
+	m_journal->append(JournalFrameInfo, m_journalScratch.getCArray(), m_journalScratch.size());
+}
+
+void FPSciLogger::journalRecord(const PlayerAction& action) {
+	m_journalScratch.fastClear();
+	journalWrite(m_journalScratch, action.journalSeq);
+	journalWrite(m_journalScratch, action.time);
+	journalWrite(m_journalScratch, action.viewDirection);
+	journalWrite(m_journalScratch, action.position);
+	journalWrite(m_journalScratch, (int32)action.state);
+	journalWrite(m_journalScratch, (int32)action.action);
+	journalWrite(m_journalScratch, action.targetName);
+	m_journal->append(JournalPlayerAction, m_journalScratch.getCArray(), m_journalScratch.size());
+}
+
+void FPSciLogger::journalRecord(const TargetLocation& loc) {
+	m_journalScratch.fastClear();
+	journalWrite(m_journalScratch, loc.journalSeq);
+	journalWrite(m_journalScratch, loc.time);
+	journalWrite(m_journalScratch, loc.name);
+	journalWrite(m_journalScratch, (int32)loc.state);
+	journalWrite(m_journalScratch, loc.position);
+	m_journal->append(JournalTargetLocation, m_journalScratch.getCArray(), m_journalScratch.size());
+}
+
+void FPSciLogger::createJournalCommitsTable() {
+	const Array<Array<String>> columns = {
+		{ "record_type", "integer", "PRIMARY KEY" },
+		{ "sequence", "integer" },
+	};
+	createTableInDB(m_db, "Journal_Commits", columns);
+}
+
+void FPSciLogger::recordJournalCommit(JournalRecordType type, uint64 seq) {
+	execStatementInDB(m_db, format("INSERT OR REPLACE INTO Journal_Commits VALUES(%d, %llu);", (int)type, (unsigned long long)seq));
+}
+
+void FPSciLogger::replayJournal() {
+	// The last journaled record of each type already written to the results file (in the same transaction as the record)
+	uint64 committedSeq[JournalTargetLocation + 1] = {};
+	if (tableExistsInDB(m_db, "Journal_Commits")) {
+		shared_ptr<PreparedQuery> commits = PreparedQuery::create(m_db, "SELECT record_type, sequence FROM Journal_Commits;");
+		while (commits->step()) {
+			const int64 type = commits->columnInt(0);
+			const uint64 seq = (uint64)commits->columnInt(1);
+			if (type > 0 && type <= JournalTargetLocation) committedSeq[type] = seq;
+			m_journalSeq = max(m_journalSeq, seq);		// New journal records continue past these
+		}
+	}
+
+	const String filename = journalFilename();
+	if (!FileSystem::exists(filename)) return;
+
+	Array<FrameInfo> frameInfo;
+	Array<PlayerAction> actions;
+	Array<TargetLocation> locations;
+	int alreadyWritten = 0;
+	const int count = LogJournal::replay(filename, [&](uint8 type, const uint8* data, uint32 size) {
+		JournalReader reader(data, size);
+		const uint64 seq = reader.read<uint64>();
+		if (!reader.ok() || type == 0 || type > JournalTargetLocation) return;
+		m_journalSeq = max(m_journalSeq, seq);
+		// Skip records the results file already has (i.e. drained by a flush after the journal's committed position was read,
+		// or a crash between committing a flush and marking it committed in the journal)
+		if (seq <= committedSeq[type]) {
+			alreadyWritten++;
+			return;
+		}
+		switch (type) {
+		case JournalFrameInfo: {
+			FrameInfo info;
+			info.journalSeq = seq;
+			info.time = reader.read<FPSciTimestamp>();
+			info.sdt = reader.read<float>();
+			if (!reader.atEnd()) info.timing = reader.read<FrameTiming>();
+			if (reader.ok()) frameInfo.append(info);
+			break;
+		}
+		case JournalPlayerAction: {
+			PlayerAction action;
+			action.journalSeq = seq;
+			action.time = reader.read<FPSciTimestamp>();
+			action.viewDirection = reader.read<Point2>();
+			action.position = reader.read<Point3>();
+			action.state = (PresentationState)reader.read<int32>();
+			action.action = (PlayerActionType)reader.read<int32>();
+			action.targetName = reader.readString();
+			if (reader.ok()) actions.append(action);
+			break;
+		}
+		case JournalTargetLocation: {
+			TargetLocation loc;
+			loc.journalSeq = seq;
+			loc.time = reader.read<FPSciTimestamp>();
+			loc.name = reader.readString();
+			loc.state = (PresentationState)reader.read<int32>();
+			loc.position = reader.read<Point3>();
+			if (reader.ok()) locations.append(loc);
+			break;
+		}
+		}
+	});
+
+	if (count < 0) {
+		logPrintf("WARNING: Ignoring invalid logger journal: %s\n", filename.c_str());
+	}
+	else if (count > 0) {
+		logPrintf("Recovering %d records (%d frame info, %d player action, %d target trajectory, %d already in the results file) from logger journal: %s\n",
+			count, frameInfo.size(), actions.size(), locations.size(), alreadyWritten, filename.c_str());
+		createJournalCommitsTable();
+		beginTransactionInDB(m_db);
+		recordFrameInfo(frameInfo);
+		recordPlayerActions(actions);
+		recordTargetLocations(locations);
+		// Mark the replayed records written (so replaying this journal again, i.e. after a crash before it is removed, adds nothing)
+		if (frameInfo.size() > 0) recordJournalCommit(JournalFrameInfo, frameInfo.last().journalSeq);
+		if (actions.size() > 0) recordJournalCommit(JournalPlayerAction, actions.last().journalSeq);
+		if (locations.size() > 0) recordJournalCommit(JournalTargetLocation, locations.last().journalSeq);
+		commitTransactionInDB(m_db);
+	}
+	FileSystem::removeFile(filename);
+}
+
+void FPSciLogger::beginSession(const String& subjectID, const shared_ptr<SessionConfig>& sessConfig, const String& description) {
+	endSession();
 
 	// Add the session info to the sessions table
-	m_openTimeStr = genUniqueTimestamp();
+	const String openTimeStr = genUniqueTimestamp();
 	RowEntry sessValues = {
 		"'" + sessConfig->id + "'",
-		"'" + m_openTimeStr + "'",
-		"'" + m_openTimeStr + "'",
+		"'" + openTimeStr + "'",
+		"'" + openTimeStr + "'",
 		"'" + subjectID + "'",
 		"'" + description + "'",
 		"false",
@@ -81,11 +278,91 @@ void FPSciLogger::initResultsFile(const String& filename,
 	// Add the looked up values
 	for (String name : sessConfig->logger.sessParamsToLog) { sessValues.append("'" + a[name].unparse() + "'"); }
 	// add header row
-	insertRowIntoDB(m_db, "Sessions", sessValues);
+	queueDBTask([this, sessValues] { insertRowIntoDB(m_db, "Sessions", sessValues); });
+
+	// Open the (per session) columnar output alongside the db
+	shared_ptr<ColumnarWriter> columnar;
+	if (m_config.logToColumnarFile) {
+		const String base = endsWith(m_filename, ".db") ? m_filename.substr(0, m_filename.size() - 3) : m_filename;
+		columnar = ColumnarWriter::create(base + "_" + sessConfig->id + ".fpcol");
+	}
+
+	{
+		std::lock_guard<std::mutex> lk(m_queueMutex);
+		m_sessionId = sessConfig->id;
+		m_clickToPhotonMode = sessConfig->clickToPhoton.mode;
+		m_columnar = columnar;
+	}
+	m_openTimeStr = openTimeStr;
+
+	// The logger thread reads the session state when it starts a flush, so wait for a flush started after the change
+	// (nothing logged for this session can be drained by a flush still using the previous session's state)
+	flush(true);
+}
+
+void FPSciLogger::endSession() {
+	if (m_openTimeStr.empty()) return;		// No open session
+	flush(true);
+	{
+		std::lock_guard<std::mutex> lk(m_queueMutex);
+		// Summarize the session in the background (on the logger thread)
+		if (m_config.logSessionSummary) {
+			m_pendingSummaries.append({ m_sessionId, m_openTimeStr });
+		}
+		m_openTimeStr = "";
+		m_columnar.reset();
+	}
+	m_queueCV.notify_one();
+}
+
+bool FPSciLogger::canLogSession(const String& filename, const LoggerConfig& config) const {
+	// The queues, schema, and file settings are all fixed when the logger is created
+	return filename == m_filename && m_config.addToAny(Any(Any::TABLE), true) == config.addToAny(Any(Any::TABLE), true);
+}
+
+void FPSciLogger::applyPragmas() {
+	execStatementInDB(m_db, "PRAGMA journal_mode = " + toUpper(m_config.journalMode) + ";");
+	execStatementInDB(m_db, "PRAGMA synchronous = " + toUpper(m_config.synchronous) + ";");
+}
 
+void FPSciLogger::prepareInserts() {
+	// Name the frame info columns (the file may have frame timing columns that aren't being logged)
+	String frameInfoColumns = "time, sdt";
+	if (m_config.logFrameTiming) {
+		for (int i = 0; i < s_frameTimingColumnCount; i++) frameInfoColumns += String(", ") + s_frameTimingColumns[i].name;
+	}
+	m_frameInfoInsert = PreparedInsert::create(m_db, timedTableName("Frame_Info"), m_config.logFrameTiming ? 2 + s_frameTimingColumnCount : 2, " (" + frameInfoColumns + ")");
+	m_playerActionInsert = PreparedInsert::create(m_db, timedTableName("Player_Action"), 9);
+	m_targetLocationInsert = PreparedInsert::create(m_db, timedTableName("Target_Trajectory"), 6);
+	m_targetInsert = PreparedInsert::create(m_db, "Targets", 6);
+	m_trialInsert = PreparedInsert::create(m_db, "Trials", 10);
+	m_questionInsert = PreparedInsert::create(m_db, "Questions", 7);
+	m_userInsert = PreparedInsert::create(m_db, "Users", 18);
+}
+
+void FPSciLogger::createTimedTable(const String& tableName, const Columns& columns) {
+	if (!m_integerTimestamps) {
+		createTableInDB(m_db, tableName, columns);
+		return;
+	}
+
+	// Store the time as an integer in the raw table
+	Columns rawColumns = columns;
+	rawColumns[0] = { columns[0][0], "integer" };
+	const String rawTableName = timedTableName(tableName);
+	createTableInDB(m_db, rawTableName, rawColumns);
+
+	// Present it as "YYYY-MM-DD HH:MM:SS.uuuuuu" (same as FPSciClock::format()) in a view w/ the original table name
+	const String timeCol = columns[0][0];
+	String selectC = "SELECT strftime('%Y-%m-%d %H:%M:%S', " + timeCol + " / 1000000, 'unixepoch') || '.' || substr('000000' || (" + timeCol + " % 1000000), -6) AS " + timeCol;
+	for (int i = 1; i < columns.size(); i++) {
+		selectC += ", " + columns[i][0];
+	}
+	selectC += " FROM " + rawTableName;
+	createViewInDB(m_db, tableName, selectC);
 }
 
-void FPSciLogger::createExperimentsTable(const String& expConfigFilename) {
+void FPSciLogger::createExperimentsTable(const ExperimentInfo& experiment) {
 	// Create experiments table columns
 	Columns expColumns = {
 		{ "description", "text", "NOT NULL"},
@@ -96,16 +373,12 @@ void FPSciLogger::createExperimentsTable(const String& expConfigFilename) {
 	createTableInDB(m_db, "Experiments", expColumns);
 
 	// Currently this should just happen once per results file (hash is in name) but in the future we may want to check if the hash is in the the table...
-	// Load experiment config text and get hash
-	ExperimentConfig expConfig = ExperimentConfig::load(expConfigFilename);
-	const size_t hash = HashTrait<String>::hashCode(expConfig.toAny().unparse());		// Hash the serialized Any (don't consider formatting)
-
-	// Update row
+	// Use the description/hash of the already loaded experiment config (rather than parsing the file again)
 	RowEntry expRow = {
-		"'" + expConfig.description + "'",
+		"'" + experiment.description + "'",
 		"'" + genUniqueTimestamp() + "'",
-		"'" + format("0x%x", hash) + "'",
-		"'" + readWholeFile(expConfigFilename)  + "'"
+		"'0x" + experiment.hash + "'",
+		"'" + readWholeFile(experiment.configFilename)  + "'"
 	};
 	insertRowIntoDB(m_db, "Experiments", expRow);
 }
@@ -131,10 +404,8 @@ void FPSciLogger::updateSessionEntry(bool complete, int trialCount) {
 	if (m_openTimeStr.empty()) return;		// Need an "open" session
 	const String completeStr = complete ? "true" : "false";
 	const String trialCountStr = String(std::to_string(trialCount));
-	char* errMsg;
-	String updateQ = "UPDATE Sessions SET end_time = '" + genUniqueTimestamp() + "', complete = " + completeStr + ", trials_complete = " + trialCountStr + " WHERE start_time = '" + m_openTimeStr + "'";
-	int ret = sqlite3_exec(m_db, updateQ.c_str(), 0, 0, &errMsg);
-	if (ret != SQLITE_OK) { logPrintf("Error in UPDATE statement (%s): %s\n", updateQ, errMsg); }
+	const String updateQ = "UPDATE Sessions SET end_time = '" + genUniqueTimestamp() + "', complete = " + completeStr + ", trials_complete = " + trialCountStr + " WHERE start_time = '" + m_openTimeStr + "'";
+	queueDBTask([this, updateQ] { execStatementInDB(m_db, updateQ); });
 }
 
 void FPSciLogger::createTargetTypeTable() {
@@ -162,7 +433,7 @@ void FPSciLogger::createTargetTypeTable() {
 }
 
 // Log target parameters into Target_Types table
-void FPSciLogger::logTargetTypes(const Array<shared_ptr<TargetConfig>>& targets) {
+void FPSciLogger::logTargetTypes(const Array<shared_ptr<const TargetConfig>>& targets) {
 	Array<RowEntry> rows;
 	for (auto config : targets) {
 		const String type = (config->destinations.size() > 0) ? "waypoint" : "parametrized";
@@ -188,7 +459,53 @@ void FPSciLogger::logTargetTypes(const Array<shared_ptr<TargetConfig>>& targets)
 		};
 		rows.append(targetTypeRow);
 	}
-	insertRowsIntoDB(m_db, "Target_Types", rows);
+	queueDBTask([this, rows] { insertRowsIntoDB(m_db, "Target_Types", rows); });
+}
+
+void FPSciLogger::logFrameTimeSchedule(const String& sessId, const FrameTimeSchedule& schedule) {
+	// Created here (rather than w/ the results file) so it is added to existing results files
+	Columns scheduleColumns = {
+		{ "session_id", "text" },
+		{ "frame_time_mode", "text" },
+		{ "randomized", "boolean" },
+		{ "seed", "integer" },
+		{ "default_frame_time", "real" },
+		{ "frame_times", "text" }
+	};
+
+	// Store the frameTimeArray as a comma separated list (w/ enough digits to reproduce each float exactly), a randomized schedule is
+	// reproduced from it and the seed (not stored per frame)
+	String frameTimes;
+	for (const float frameTime : schedule.frameTimes()) {
+		if (!frameTimes.empty()) frameTimes += ",";
+		frameTimes += format("%.9g", frameTime);
+	}
+	const String mode = frameTimeModeToString(schedule.mode());
+	const bool randomized = schedule.randomized();
+	const int64 seed = schedule.seed();
+	const float defaultFrameTime = schedule.defaultFrameTime();
+	queueDBTask([=] {
+		createTableInDB(m_db, "Frame_Time_Schedules", scheduleColumns);
+		PreparedInsert::create(m_db, "Frame_Time_Schedules", (int)scheduleColumns.size())->bindText(sessId)
+			.bindText(mode)
+			.bindInt(randomized ? 1 : 0)
+			.bindInt(seed)
+			.bindReal(defaultFrameTime)
+			.bindText(frameTimes)
+			.insert();
+	});
+}
+
+void FPSciLogger::logRandomSeed(const String& sessId, int64 seed) {
+	// Created here (rather than w/ the results file) so it is added to existing results files
+	Columns seedColumns = {
+		{ "session_id", "text" },
+		{ "seed", "integer" }
+	};
+	queueDBTask([=] {
+		createTableInDB(m_db, "Random_Seeds", seedColumns);
+		PreparedInsert::create(m_db, "Random_Seeds", (int)seedColumns.size())->bindText(sessId).bindInt(seed).insert();
+	});
 }
 
 void FPSciLogger::createTargetsTable() {
@@ -204,16 +521,20 @@ void FPSciLogger::createTargetsTable() {
 	createTableInDB(m_db, "Targets", targetColumns);
 }
 
-void FPSciLogger::addTarget(const String& name, const shared_ptr<TargetConfig>& config, const String& spawnTime, const float& size, const Point2& spawnEcc) {
-	const RowEntry targetValues = {
-		"'" + name + "'",
-		"'" + config->id + "'",
-		"'" + spawnTime + "'",
-		String(std::to_string(size)),
-		String(std::to_string(spawnEcc.x)),
-		String(std::to_string(spawnEcc.y)),
-	};
-	logTargetInfo(targetValues);
+void FPSciLogger::addTarget(const String& name, const shared_ptr<const TargetConfig>& config, FPSciTimestamp spawnTime, const float& size, const Point2& spawnEcc) {
+	logTargetInfo(TargetInfo(spawnTime, name, config, size, spawnEcc));
+}
+
+void FPSciLogger::recordTargets(const Array<TargetInfo>& targets) {
+	for (const TargetInfo& target : targets) {
+		m_targetInsert->bindText(target.name)
+			.bindText(target.config->id)
+			.bindText(FPSciClock::format(target.spawnTime))
+			.bindReal(target.size)
+			.bindReal(target.spawnEcc.x)
+			.bindReal(target.spawnEcc.y)
+			.insert();
+	}
 }
 
 void FPSciLogger::createTrialsTable() {
@@ -233,6 +554,22 @@ void FPSciLogger::createTrialsTable() {
 	createTableInDB(m_db, "Trials", trialColumns);
 }
 
+void FPSciLogger::recordTrials(const Array<TrialValues>& trials, const String& sessionId) {
+	for (const TrialValues& trial : trials) {
+		m_trialInsert->bindText(sessionId)
+			.bindInt(trial.trialId)
+			.bindInt(trial.trialIndex)
+			.bindText(format("Block %d", trial.block))
+			.bindText(FPSciClock::format(trial.startTime))
+			.bindText(FPSciClock::format(trial.endTime))
+			.bindReal(trial.pretrialDuration)
+			.bindReal(trial.taskExecutionTime)
+			.bindInt(trial.destroyedTargets)
+			.bindInt(trial.totalTargets)
+			.insert();
+	}
+}
+
 void FPSciLogger::createTargetTrajectoryTable() {
 	// Target_Trajectory, only need to create the table.
 	Columns targetTrajectoryColumns = {
@@ -243,24 +580,30 @@ void FPSciLogger::createTargetTrajectoryTable() {
 		{ "position_y", "real" },
 		{ "position_z", "real" },
 	};
-	createTableInDB(m_db, "Target_Trajectory", targetTrajectoryColumns);
+	createTimedTable("Target_Trajectory", targetTrajectoryColumns);
 }
 
 void FPSciLogger::recordTargetLocations(const Array<TargetLocation>& locations) {
-	Array<RowEntry> rows;
 	for (const auto& loc : locations) {
-		String stateStr = presentationStateToString(loc.state);
-		Array<String> targetTrajectoryValues = {
-			"'" + FPSciLogger::formatFileTime(loc.time) + "'",
-			"'" + loc.name + "'",
-			"'" + stateStr + "'",
-			String(std::to_string(loc.position.x)),
-			String(std::to_string(loc.position.y)),
-			String(std::to_string(loc.position.z)),
-		};
-		rows.append(targetTrajectoryValues);
+		bindTime(m_targetLocationInsert, loc.time)
+			.bindText(loc.name)
+			.bindText(presentationStateToString(loc.state))
+			.bindReal(loc.position.x)
+			.bindReal(loc.position.y)
+			.bindReal(loc.position.z)
+			.insert();
+	}
+}
+
+static String playerActionTypeToString(PlayerActionType action) {
+	switch (action) {
+		case FireCooldown: return "fireCooldown";
+		case Aim: return "aim";
+		case Miss: return "miss";
+		case Hit: return "hit";
+		case Destroy: return "destroy";
+		default: return "";
 	}
-	insertRowsIntoDB(m_db, "Target_Trajectory", rows);
 }
 
 void FPSciLogger::createPlayerActionTable() {
@@ -276,37 +619,22 @@ void FPSciLogger::createPlayerActionTable() {
 		{ "event", "text" },
 		{ "target_id", "text" },
 	};
-	createTableInDB(m_db, "Player_Action", viewTrajectoryColumns);
+	createTimedTable("Player_Action", viewTrajectoryColumns);
 }
 
 void FPSciLogger::recordPlayerActions(const Array<PlayerAction>& actions) {
-	Array<RowEntry> rows;
-	for (PlayerAction action : actions) {
-		String stateStr = presentationStateToString(action.state);
-
-		String actionStr = "";
-		switch (action.action) {
-			case FireCooldown: actionStr = "fireCooldown"; break;
-			case Aim: actionStr = "aim"; break;
-			case Miss: actionStr = "miss"; break;
-			case Hit: actionStr = "hit"; break;
-			case Destroy: actionStr = "destroy"; break;
-		}
-
-		Array<String> playerActionValues = {
-		"'" + FPSciLogger::formatFileTime(action.time) + "'",
-		String(std::to_string(action.viewDirection.x)),
-		String(std::to_string(action.viewDirection.y)),
-		String(std::to_string(action.position.x)),
-		String(std::to_string(action.position.y)),
-		String(std::to_string(action.position.z)),
-		"'" + stateStr + "'",
-		"'" + actionStr + "'",
-		"'" + action.targetName + "'",
-		};
-		rows.append(playerActionValues);
+	for (const PlayerAction& action : actions) {
+		bindTime(m_playerActionInsert, action.time)
+			.bindReal(action.viewDirection.x)
+			.bindReal(action.viewDirection.y)
+			.bindReal(action.position.x)
+			.bindReal(action.position.y)
+			.bindReal(action.position.z)
+			.bindText(presentationStateToString(action.state))
+			.bindText(playerActionTypeToString(action.action))
+			.bindText(action.targetName)
+			.insert();
 	}
-	insertRowsIntoDB(m_db, "Player_Action", rows);
 }
 
 void FPSciLogger::createFrameInfoTable() {
@@ -316,20 +644,281 @@ void FPSciLogger::createFrameInfoTable() {
 		//{"idt", "real"},
 		{"sdt", "real"},
 	};
-	createTableInDB(m_db, "Frame_Info", frameInfoColumns);
+	if (m_config.logFrameTiming) {
+		for (int i = 0; i < s_frameTimingColumnCount; i++) frameInfoColumns.append(Array<String>{ s_frameTimingColumns[i].name, "real" });
+	}
+	createTimedTable("Frame_Info", frameInfoColumns);
+}
+
+void FPSciLogger::addFrameTimingColumns() {
+	const String tableName = timedTableName("Frame_Info");
+	bool added = false;
+	for (int i = 0; i < s_frameTimingColumnCount; i++) {
+		if (columnExistsInDB(m_db, tableName, s_frameTimingColumns[i].name)) continue;
+		execStatementInDB(m_db, "ALTER TABLE " + tableName + " ADD COLUMN " + s_frameTimingColumns[i].name + " real;");
+		added = true;
+	}
+	// Re-create the integer timestamp view so it includes the new columns
+	if (added && m_integerTimestamps) {
+		execStatementInDB(m_db, "DROP VIEW IF EXISTS Frame_Info;");
+		createFrameInfoTable();
+	}
 }
 
 void FPSciLogger::recordFrameInfo(const Array<FrameInfo>& frameInfo) {
-	Array<RowEntry> rows;
-	for (FrameInfo info : frameInfo) {
-		Array<String> frameValues = {
-			"'" + FPSciLogger::formatFileTime(info.time) + "'",
-			//String(std::to_string(info.idt)),
-			String(std::to_string(info.sdt))
-		};
-		rows.append(frameValues);
+	for (const FrameInfo& info : frameInfo) {
+		PreparedInsert& insert = bindTime(m_frameInfoInsert, info.time)
+			//.bindReal(info.idt)
+			.bindReal(info.sdt);
+		if (m_config.logFrameTiming) {
+			for (int i = 0; i < s_frameTimingColumnCount; i++) insert.bindReal(info.timing.*s_frameTimingColumns[i].field);
+		}
+		insert.insert();
+	}
+}
+
+void FPSciLogger::recordColumnar(ColumnarWriter& columnar, const Array<FrameInfo>& frameInfo, const Array<PlayerAction>& actions, const Array<TargetLocation>& locations) {
+	// Column storage (reused for each table)
+	Array<int64> time;
+	Array<float> x, y, z, az, el;
+	Array<String> name, state, event;
+	const Array<String> noKeys;
+	const bool deltaEncode = m_config.trajectoryEncoding == "delta";
+
+	if (frameInfo.size() > 0) {
+		time.fastClear(); x.fastClear();
+		for (const FrameInfo& info : frameInfo) {
+			time.append(info.time);
+			x.append(info.sdt);
+		}
+		columnar.beginRowGroup("Frame_Info", frameInfo.size());
+		columnar.addTimeColumn("time", time);
+		columnar.addFloatColumn("sdt", x);
+		if (m_config.logFrameTiming) {
+			for (int i = 0; i < s_frameTimingColumnCount; i++) {
+				x.fastClear();
+				for (const FrameInfo& info : frameInfo) x.append(info.timing.*s_frameTimingColumns[i].field);
+				columnar.addFloatColumn(s_frameTimingColumns[i].name, x);
+			}
+		}
+		columnar.endRowGroup();
+	}
+
+	if (actions.size() > 0) {
+		time.fastClear(); az.fastClear(); el.fastClear(); x.fastClear(); y.fastClear(); z.fastClear();
+		state.fastClear(); event.fastClear(); name.fastClear();
+		for (const PlayerAction& action : actions) {
+			time.append(action.time);
+			az.append(action.viewDirection.x);
+			el.append(action.viewDirection.y);
+			x.append(action.position.x);
+			y.append(action.position.y);
+			z.append(action.position.z);
+			state.append(presentationStateToString(action.state));
+			event.append(playerActionTypeToString(action.action));
+			name.append(action.targetName);
+		}
+		columnar.beginRowGroup("Player_Action", actions.size());
+		columnar.addTimeColumn("time", time);
+		if (deltaEncode) {
+			// Player actions are a single stream (no key column)
+			columnar.addQuantizedDeltaColumn("position_az", az, m_config.anglePrecision, "", noKeys, m_config.keyframeInterval);
+			columnar.addQuantizedDeltaColumn("position_el", el, m_config.anglePrecision, "", noKeys, m_config.keyframeInterval);
+			columnar.addQuantizedDeltaColumn("position_x", x, m_config.positionPrecision, "", noKeys, m_config.keyframeInterval);
+			columnar.addQuantizedDeltaColumn("position_y", y, m_config.positionPrecision, "", noKeys, m_config.keyframeInterval);
+			columnar.addQuantizedDeltaColumn("position_z", z, m_config.positionPrecision, "", noKeys, m_config.keyframeInterval);
+		}
+		else {
+			columnar.addFloatColumn("position_az", az);
+			columnar.addFloatColumn("position_el", el);
+			columnar.addFloatColumn("position_x", x);
+			columnar.addFloatColumn("position_y", y);
+			columnar.addFloatColumn("position_z", z);
+		}
+		columnar.addStringColumn("state", state);
+		columnar.addStringColumn("event", event);
+		columnar.addStringColumn("target_id", name);
+		columnar.endRowGroup();
+	}
+
+	if (locations.size() > 0) {
+		time.fastClear(); x.fastClear(); y.fastClear(); z.fastClear();
+		name.fastClear(); state.fastClear();
+		for (const TargetLocation& loc : locations) {
+			time.append(loc.time);
+			name.append(loc.name);
+			state.append(presentationStateToString(loc.state));
+			x.append(loc.position.x);
+			y.append(loc.position.y);
+			z.append(loc.position.z);
+		}
+		columnar.beginRowGroup("Target_Trajectory", locations.size());
+		columnar.addTimeColumn("time", time);
+		columnar.addStringColumn("target_id", name);
+		columnar.addStringColumn("state", state);
+		if (deltaEncode) {
+			// Delta encode each target's trajectory against its own previous sample
+			columnar.addQuantizedDeltaColumn("position_x", x, m_config.positionPrecision, "target_id", name, m_config.keyframeInterval);
+			columnar.addQuantizedDeltaColumn("position_y", y, m_config.positionPrecision, "target_id", name, m_config.keyframeInterval);
+			columnar.addQuantizedDeltaColumn("position_z", z, m_config.positionPrecision, "target_id", name, m_config.keyframeInterval);
+		}
+		else {
+			columnar.addFloatColumn("position_x", x);
+			columnar.addFloatColumn("position_y", y);
+			columnar.addFloatColumn("position_z", z);
+		}
+		columnar.endRowGroup();
 	}
-	insertRowsIntoDB(m_db, "Frame_Info", rows);
+}
+
+void FPSciLogger::createTrialSummaryTable() {
+	// Per-trial summaries (written at the end of each session)
+	Columns summaryColumns = {
+		{ "session_id", "text" },
+		{ "trial_id", "integer" },
+		{ "trial_index", "integer" },
+		{ "block_id", "text" },
+		{ "start_time", "text" },
+		{ "end_time", "text" },
+		{ "shots", "integer" },
+		{ "hits", "integer" },
+		{ "time_to_first_hit", "real" },
+		{ "mean_aim_error", "real" },
+		{ "aim_samples", "integer" }
+	};
+	createTableInDB(m_db, "Trial_Summary", summaryColumns);
+}
+
+void FPSciLogger::buildSessionSummary(const SessionSummaryRequest& session) {
+	const auto buildStart = std::chrono::steady_clock::now();
+	const String frameInfoTable = timedTableName("Frame_Info");
+	const String actionTable = timedTableName("Player_Action");
+	const String trajectoryTable = timedTableName("Target_Trajectory");
+
+	// Indexes for per-trial (time range) and per-target queries (only built once per results file)
+	createIndexInDB(m_db, frameInfoTable + "_time", frameInfoTable, "time");
+	createIndexInDB(m_db, actionTable + "_time", actionTable, "time");
+	createIndexInDB(m_db, trajectoryTable + "_time", trajectoryTable, "time");
+	createIndexInDB(m_db, trajectoryTable + "_target_id", trajectoryTable, "target_id");
+	createIndexInDB(m_db, "Trials_trial_id", "Trials", "trial_id");
+	createIndexInDB(m_db, "Trials_session_id", "Trials", "session_id, start_time");
+	createTrialSummaryTable();
+
+	shared_ptr<PreparedQuery> trialQuery = PreparedQuery::create(m_db,
+		"SELECT trial_id, trial_index, block_id, start_time, end_time FROM Trials WHERE session_id = ? AND start_time >= ? ORDER BY start_time;");
+	shared_ptr<PreparedQuery> actionQuery = PreparedQuery::create(m_db,
+		"SELECT time, position_az, position_el, position_x, position_y, position_z, state, event, target_id FROM " + actionTable + " WHERE time >= ? AND time <= ? ORDER BY time;");
+	shared_ptr<PreparedQuery> trajectoryQuery = PreparedQuery::create(m_db,
+		"SELECT time, target_id, position_x, position_y, position_z FROM " + trajectoryTable + " WHERE time >= ? AND time <= ? ORDER BY time;");
+	shared_ptr<PreparedInsert> summaryInsert = PreparedInsert::create(m_db, "Trial_Summary", 11);
+	if (!trialQuery->valid() || !actionQuery->valid() || !trajectoryQuery->valid() || !summaryInsert->valid()) return;
+
+	// Times in the high-rate tables are either integer usec or formatted text
+	auto readTime = [this](const shared_ptr<PreparedQuery>& query, int col) {
+		FPSciTimestamp t = 0;
+		if (m_integerTimestamps) t = query->columnInt(col);
+		else FPSciClock::parse(query->columnText(col), t);
+		return t;
+	};
+	auto bindTimeRange = [this](const shared_ptr<PreparedQuery>& query, FPSciTimestamp start, FPSciTimestamp end) {
+		query->reset();
+		if (m_integerTimestamps) query->bindInt(start).bindInt(end);
+		else query->bindText(FPSciClock::format(start)).bindText(FPSciClock::format(end));
+	};
+
+	// Most recent position of each (live) target, updated as the trajectory is merged w/ the player actions
+	Table<String, int> targetIndices;
+	Array<Point3> targetPositions;
+	Array<bool> targetLive;
+
+	int trialCount = 0;
+	beginTransactionInDB(m_db);
+	trialQuery->bindText(session.sessionId).bindText(session.startTime);
+	while (trialQuery->step()) {
+		FPSciTimestamp trialStart, trialEnd;
+		if (!FPSciClock::parse(trialQuery->columnText(3), trialStart) || !FPSciClock::parse(trialQuery->columnText(4), trialEnd)) continue;
+
+		targetIndices.clear();
+		targetPositions.fastClear();
+		targetLive.fastClear();
+		int shots = 0, hits = 0, aimSamples = 0;
+		FPSciTimestamp firstHit = -1;
+		double aimErrorSum = 0.0;
+
+		bindTimeRange(actionQuery, trialStart, trialEnd);
+		bindTimeRange(trajectoryQuery, trialStart, trialEnd);
+		bool hasTrajectory = trajectoryQuery->step();
+		while (actionQuery->step()) {
+			const FPSciTimestamp t = readTime(actionQuery, 0);
+
+			// Bring the target positions up to the time of this action
+			while (hasTrajectory && readTime(trajectoryQuery, 0) <= t) {
+				const String name = trajectoryQuery->columnText(1);
+				const Point3 pos((float)trajectoryQuery->columnReal(2), (float)trajectoryQuery->columnReal(3), (float)trajectoryQuery->columnReal(4));
+				int* idx = targetIndices.getPointer(name);
+				if (isNull(idx)) {
+					targetIndices.set(name, targetPositions.size());
+					targetPositions.append(pos);
+					targetLive.append(true);
+				}
+				else {
+					targetPositions[*idx] = pos;
+				}
+				hasTrajectory = trajectoryQuery->step();
+			}
+
+			const String event = actionQuery->columnText(7);
+			if (event == "hit" || event == "destroy") {
+				shots++;
+				hits++;
+				if (firstHit < 0) firstHit = t;
+				if (event == "destroy") {
+					const int* idx = targetIndices.getPointer(actionQuery->columnText(8));
+					if (notNull(idx)) targetLive[*idx] = false;
+				}
+			}
+			else if (event == "miss") {
+				shots++;
+			}
+			else if (event == "aim" && actionQuery->columnText(6) == "trialTask") {
+				// Angle between the view direction and the direction to the closest live target
+				const float az = toRadians((float)actionQuery->columnReal(1));
+				const float el = toRadians((float)actionQuery->columnReal(2));
+				const Vector3 view(cosf(el) * sinf(az), sinf(el), -cosf(el) * cosf(az));
+				const Point3 player((float)actionQuery->columnReal(3), (float)actionQuery->columnReal(4), (float)actionQuery->columnReal(5));
+				float minError = finf();
+				for (int i = 0; i < targetPositions.size(); i++) {
+					if (!targetLive[i]) continue;
+					const Vector3 toTarget = targetPositions[i] - player;
+					if (toTarget.squaredLength() == 0.0f) continue;
+					minError = min(minError, acosf(clamp(view.dot(toTarget.direction()), -1.0f, 1.0f)));
+				}
+				if (minError < finf()) {
+					aimErrorSum += toDegrees(minError);
+					aimSamples++;
+				}
+			}
+		}
+
+		summaryInsert->bindText(session.sessionId)
+			.bindInt(trialQuery->columnInt(0))
+			.bindInt(trialQuery->columnInt(1))
+			.bindText(trialQuery->columnText(2))
+			.bindText(trialQuery->columnText(3))
+			.bindText(trialQuery->columnText(4))
+			.bindInt(shots)
+			.bindInt(hits);
+		if (firstHit >= 0) summaryInsert->bindReal((firstHit - trialStart) / 1e6);
+		else summaryInsert->bindNull();
+		if (aimSamples > 0) summaryInsert->bindReal(aimErrorSum / aimSamples);
+		else summaryInsert->bindNull();
+		summaryInsert->bindInt(aimSamples).insert();
+		trialCount++;
+	}
+	commitTransactionInDB(m_db);
+
+	logPrintf("Built summary for session %s (%d trials) in %.3f s\n", session.sessionId.c_str(), trialCount,
+		std::chrono::duration<double>(std::chrono::steady_clock::now() - buildStart).count());
 }
 
 void FPSciLogger::createQuestionsTable() {
@@ -347,23 +936,29 @@ void FPSciLogger::createQuestionsTable() {
 }
 
 void FPSciLogger::addQuestion(Question q, String session, const shared_ptr<DialogBase>& dialog) {
-	const String time = genUniqueTimestamp();
-	const String optStr = Any(q.options).unparse();
-	const String keyStr = Any(q.optionKeys).unparse();
-	String orderStr = "";
+	QuestionResult result;
+	result.time = FPSciClock::now();
+	result.sessionId = session;
+	result.question = q;
 	if (q.type == Question::Type::MultipleChoice || q.type == Question::Type::Rating) {
-		orderStr = Any(dynamic_pointer_cast<SelectionDialog>(dialog)->options()).unparse();
-	}
-	RowEntry rowContents = {
-		"'" + time + "'",
-		"'" + session + "'",
-		"'" + q.prompt + "'",
-		"'" + optStr + "'",
-		"'" + keyStr + "'",
-		"'" + orderStr + "'",
-		"'" + q.result + "'"
-	};
-	logQuestionResult(rowContents);
+		result.presentedOptions = dynamic_pointer_cast<SelectionDialog>(dialog)->options();
+	}
+	logQuestionResult(result);
+}
+
+void FPSciLogger::recordQuestions(const Array<QuestionResult>& questions) {
+	for (const QuestionResult& result : questions) {
+		const Question& q = result.question;
+		const bool hasOrder = q.type == Question::Type::MultipleChoice || q.type == Question::Type::Rating;
+		m_questionInsert->bindText(FPSciClock::format(result.time))
+			.bindText(result.sessionId)
+			.bindText(q.prompt)
+			.bindText(Any(q.options).unparse())
+			.bindText(Any(q.optionKeys).unparse())
+			.bindText(hasOrder ? Any(result.presentedOptions).unparse() : "")
+			.bindText(q.result)
+			.insert();
+	}
 }
 
 void FPSciLogger::createUsersTable() {
@@ -393,112 +988,250 @@ void FPSciLogger::createUsersTable() {
 
 void FPSciLogger::logUserConfig(const UserConfig& user, const String& sessId, const Vector2& sessTurnScale) {
 	if (!m_config.logUsers) return;
-	// Collapse Y-inversion into per-user turn scale (no need to complicate the log)
-	const float userYTurnScale = user.invertY ? -user.turnScale.y : user.turnScale.y;
-	const float cmp360 = 36.f / (float)user.mouseDegPerMm;
-	const Vector2 sensitivity = cmp360 * user.turnScale * sessTurnScale;
-	const String time = genUniqueTimestamp();
-
-	RowEntry row = {
-		"'" + user.id + "'",
-		"'" + sessId + "'",
-		"'" + time + "'",
-		String(std::to_string(cmp360)),
-		String(std::to_string(user.mouseDegPerMm)),
-		String(std::to_string(user.mouseDPI)),
-		String(std::to_string(user.reticle.index)),
-		String(std::to_string(user.reticle.scale[0])),
-		String(std::to_string(user.reticle.scale[1])),
-		"'" + user.reticle.color[0].toString() + "'",
-		"'" + user.reticle.color[1].toString() + "'",
-		String(std::to_string(user.reticle.changeTimeS)),
-		String(std::to_string(user.turnScale.x)),
-		String(std::to_string(userYTurnScale)),
-		String(std::to_string(sessTurnScale.x)),
-		String(std::to_string(sessTurnScale.y)),
-		String(std::to_string(sensitivity.x)),
-		String(std::to_string(sensitivity.y))
+	UserValues values;
+	values.time = FPSciClock::now();
+	values.sessionId = sessId;
+	values.userId = user.id;
+	values.mouseDPI = user.mouseDPI;
+	values.mouseDegPerMm = user.mouseDegPerMm;
+	values.turnScale = user.turnScale;
+	values.invertY = user.invertY;
+	values.reticleIndex = user.reticle.index;
+	for (int i = 0; i < 2; i++) {
+		values.reticleScale[i] = user.reticle.scale[i];
+		values.reticleColor[i] = user.reticle.color[i];
+	}
+	values.reticleChangeTimeS = user.reticle.changeTimeS;
+	values.sessTurnScale = sessTurnScale;
+	addToQueue(m_users, values);
+}
+
+void FPSciLogger::recordUsers(const Array<UserValues>& users) {
+	for (const UserValues& values : users) {
+		// Collapse Y-inversion into per-user turn scale (no need to complicate the log)
+		const float userYTurnScale = values.invertY ? -values.turnScale.y : values.turnScale.y;
+		const float cmp360 = 36.f / (float)values.mouseDegPerMm;
+		const Vector2 sensitivity = cmp360 * values.turnScale * values.sessTurnScale;
+
+		m_userInsert->bindText(values.userId)
+			.bindText(values.sessionId)
+			.bindText(FPSciClock::format(values.time))
+			.bindReal(cmp360)
+			.bindReal(values.mouseDegPerMm)
+			.bindReal(values.mouseDPI)
+			.bindInt(values.reticleIndex)
+			.bindReal(values.reticleScale[0])
+			.bindReal(values.reticleScale[1])
+			.bindText(values.reticleColor[0].toString())
+			.bindText(values.reticleColor[1].toString())
+			.bindReal(values.reticleChangeTimeS)
+			.bindReal(values.turnScale.x)
+			.bindReal(userYTurnScale)
+			.bindReal(values.sessTurnScale.x)
+			.bindReal(values.sessTurnScale.y)
+			.bindReal(sensitivity.x)
+			.bindReal(sensitivity.y)
+			.insert();
+	}
+}
+
+void FPSciLogger::createHardwareEventTables() {
+	// Events table (all events reported by the hardware event logger)
+	Columns eventColumns = {
+		{ "time", "text" },
+		{ "session_id", "text" },
+		{ "event", "text" },
 	};
-	m_users.append(row);
+	createTimedTable("Events", eventColumns);
+
+	// Click_Latencies table (click-to-photon latency for each click matched to a photodetector event)
+	Columns clickLatencyColumns = {
+		{ "time", "text" },
+		{ "session_id", "text" },
+		{ "latency", "real" },
+		{ "latency_mode", "text" },
+	};
+	createTimedTable("Click_Latencies", clickLatencyColumns);
+}
+
+void FPSciLogger::recordHardwareEvents(const Array<HardwareEvent>& events, const String& sessionId, const String& clickToPhotonMode) {
+	if (events.size() == 0) return;
+	// Most results files never see a hardware event, so only add these tables once one is logged
+	if (isNull(m_eventInsert)) {
+		createHardwareEventTables();
+		m_eventInsert = PreparedInsert::create(m_db, timedTableName("Events"), 3);
+		m_clickLatencyInsert = PreparedInsert::create(m_db, timedTableName("Click_Latencies"), 4);
+	}
+	for (const HardwareEvent& event : events) {
+		bindTime(m_eventInsert, event.time)
+			.bindText(sessionId)
+			.bindText(event.event)
+			.insert();
+		if (event.clickTime >= 0) {
+			bindTime(m_clickLatencyInsert, event.clickTime)
+				.bindText(sessionId)
+				.bindReal(event.clickToPhotonMs())
+				.bindText(clickToPhotonMode)
+				.insert();
+		}
+	}
 }
 
 void FPSciLogger::loggerThreadEntry()
 {
+	// Local copies of the queues (written out while the main thread keeps pushing into the rings)
+	Array<FrameInfo> frameInfo;
+	Array<PlayerAction> playerActions;
+	Array<QuestionResult> questions;
+	Array<TargetLocation> targetLocations;
+	Array<TargetInfo> targets;
+	Array<TrialValues> trials;
+	Array<UserValues> users;
+	Array<HardwareEvent> hardwareEvents;
+	Array<DBTask> dbTasks;
+
 	std::unique_lock<std::mutex> lk(m_queueMutex);
 	while (m_running) {
 
-		m_queueCV.wait(lk, [this]{
-			return !m_running || m_flushNow || getTotalQueueBytes() >= m_bufferLimit;
+		// The producer notifies without holding the lock, so also wake up periodically in case a notification is missed
+		const bool ready = m_queueCV.wait_for(lk, std::chrono::milliseconds(100), [this]{
+			return !m_running || m_flushNow || queuesNeedFlush() || m_pendingSummaries.size() > 0 || m_dbTasks.size() > 0;
 		});
+		if (!ready) continue;
+		m_flushNow = false;
+		// Everything logged before the most recent flush request is already in the queues (drained below)
+		const uint64 fence = m_flushRequested;
+		// Likewise every record journaled before this position was queued first (so is drained below). Records queued after it
+		// may be drained too, so the journal sequence number of the last record of each type written is also stored in the
+		// results file (in the flush transaction), and replayJournal() skips records up to it.
+		const uint64 journalPos = notNull(m_journal) ? m_journal->writePosition() : 0;
+		// Use the session state as of now for the whole flush (beginSession() waits for a flush started after it changes it)
+		const String sessionId = m_sessionId;
+		const String clickToPhotonMode = m_clickToPhotonMode;
+		const shared_ptr<ColumnarWriter> columnar = m_columnar;
+		dbTasks = m_dbTasks;
+		m_dbTasks.fastClear();
 
-		// Move all the queues into temporary local copies.
-		// This is so we can release the lock and allow the queues to grow again while writing out the results.
-		// Also allocate new storage for each.
-		decltype(m_frameInfo) frameInfo;
-		frameInfo.swap(m_frameInfo, frameInfo);
-		m_frameInfo.reserve(frameInfo.size() * 2);
-
-		decltype(m_playerActions) playerActions;
-		playerActions.swap(m_playerActions, playerActions);
-		m_playerActions.reserve(playerActions.size() * 2);
-
-		decltype(m_questions) questions;
-		questions.swap(m_questions, questions);
-		m_questions.reserve(questions.size() * 2);
-
-		decltype(m_targetLocations) targetLocations;
-		targetLocations.swap(m_targetLocations, targetLocations);
-		m_targetLocations.reserve(targetLocations.size() * 2);
-
-		decltype(m_targets) targets;
-		targets.swap(m_targets, targets);
-		m_targets.reserve(targets.size() * 2);
+		// Release the lock while draining and writing out the results (the queues themselves don't need it)
+		lk.unlock();
 
-		decltype(m_trials) trials;
-		trials.swap(m_trials, trials);
-		m_trials.reserve(trials.size() * 2);
+		m_frameInfo.popAll(frameInfo);
+		m_playerActions.popAll(playerActions);
+		m_questions.popAll(questions);
+		m_targetLocations.popAll(targetLocations);
+		m_targets.popAll(targets);
+		m_trials.popAll(trials);
+		m_users.popAll(users);
+		m_hardwareEvents.popAll(hardwareEvents);
 
-		decltype(m_users) users;
-		users.swap(m_users, users);
-		m_users.reserve(users.size() * 2);
+		// Write the whole flush in a single transaction (avoids a journal commit per statement)
+		const auto flushStart = std::chrono::steady_clock::now();
+		beginTransactionInDB(m_db);
 
-		// Unlock all the now-empty queues and write out our temporary copies
-		lk.unlock();
+		for (const DBTask& task : dbTasks) task();
+		dbTasks.fastClear();
 
 		recordFrameInfo(frameInfo);
 		recordPlayerActions(playerActions);
 		recordTargetLocations(targetLocations);
 
-		insertRowsIntoDB(m_db, "Questions", questions);
-		insertRowsIntoDB(m_db, "Targets", targets);
-		insertRowsIntoDB(m_db, "Users", users);
-		insertRowsIntoDB(m_db, "Trials", trials);
+		recordQuestions(questions);
+		recordTargets(targets);
+		recordUsers(users);
+		recordTrials(trials, sessionId);
+		recordHardwareEvents(hardwareEvents, sessionId, clickToPhotonMode);
+
+		if (notNull(m_journal)) {
+			// Queues are drained in order, so the last record of each type has the highest sequence number
+			if (frameInfo.size() > 0) recordJournalCommit(JournalFrameInfo, frameInfo.last().journalSeq);
+			if (playerActions.size() > 0) recordJournalCommit(JournalPlayerAction, playerActions.last().journalSeq);
+			if (targetLocations.size() > 0) recordJournalCommit(JournalTargetLocation, targetLocations.last().journalSeq);
+		}
+
+		commitTransactionInDB(m_db);
+		if (notNull(m_journal)) m_journal->commit(journalPos);
+		if (notNull(columnar)) recordColumnar(*columnar, frameInfo, playerActions, targetLocations);
+		const double flushSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - flushStart).count();
+		const int rowCount = frameInfo.size() + playerActions.size() + questions.size() + targetLocations.size() + targets.size() + trials.size() + users.size() + hardwareEvents.size();
+
+		// Keep the storage around for the next flush
+		frameInfo.fastClear();
+		playerActions.fastClear();
+		questions.fastClear();
+		targetLocations.fastClear();
+		targets.fastClear();
+		trials.fastClear();
+		users.fastClear();
+		hardwareEvents.fastClear();
 
 		lk.lock();
+		m_flushStats.flushCount++;
+		m_flushStats.rowCount += rowCount;
+		m_flushStats.totalSecs += flushSecs;
+		m_flushStats.maxSecs = max(m_flushStats.maxSecs, flushSecs);
+		completeFlush(fence);
+
+		// Summarize any completed sessions (their results were written before the request was made)
+		if (m_pendingSummaries.size() > 0) {
+			const Array<SessionSummaryRequest> summaries = m_pendingSummaries;
+			m_pendingSummaries.fastClear();
+			lk.unlock();
+			for (const SessionSummaryRequest& session : summaries) buildSessionSummary(session);
+			lk.lock();
+		}
+	}
+
+	// Nothing more will be written, so release anyone still waiting on a flush
+	completeFlush(m_flushRequested);
+}
+
+void FPSciLogger::queueDBTask(const DBTask& task) {
+	{
+		std::lock_guard<std::mutex> lk(m_queueMutex);
+		m_dbTasks.append(task);
+	}
+	m_queueCV.notify_one();
+}
+
+void FPSciLogger::completeFlush(uint64 fence) {
+	if (fence <= m_flushCompleted) return;
+	m_flushCompleted = fence;
+	while (!m_flushPromises.empty() && m_flushPromises.front().first <= fence) {
+		m_flushPromises.front().second.set_value();
+		m_flushPromises.pop_front();
 	}
+	m_flushDoneCV.notify_all();
 }
 
 FPSciLogger::FPSciLogger(const String& filename, 
 	const String& subjectID, 
-	const String& expConfigFilename,
+	const ExperimentInfo& experiment,
 	const shared_ptr<SessionConfig>& sessConfig, 
 	const String& description 
-	) : m_db(nullptr), m_config(sessConfig->logger)
+	) : m_db(nullptr), m_config(sessConfig->logger),
+	m_frameInfo(m_config.queueCapacity, ringOverflowPolicyFromString(m_config.queueOverflowPolicy)),
+	m_playerActions(m_config.queueCapacity, ringOverflowPolicyFromString(m_config.queueOverflowPolicy)),
+	m_questions(m_lowRateQueueCapacity),
+	m_targetLocations(m_config.queueCapacity, ringOverflowPolicyFromString(m_config.queueOverflowPolicy)),
+	m_targets(m_lowRateQueueCapacity),
+	m_trials(m_lowRateQueueCapacity),
+	m_users(m_lowRateQueueCapacity),
+	m_hardwareEvents(m_lowRateQueueCapacity)
 {
-	// Reserve some space in these arrays here
-	m_playerActions.reserve(5000);
-	m_targetLocations.reserve(5000);
-	
 	// Create the results file
-	initResultsFile(filename, subjectID, expConfigFilename, sessConfig, description);
+	initResultsFile(filename, experiment, sessConfig);
 
 	// Thread management
 	m_running = true;
 	m_thread = std::thread(&FPSciLogger::loggerThreadEntry, this);
+
+	beginSession(subjectID, sessConfig, description);
 }
 
 FPSciLogger::~FPSciLogger()
 {
+	// Write out anything still queued (the thread doesn't start another flush once it is stopped)
+	flush(true);
 	{
 		std::lock_guard<std::mutex> lk(m_queueMutex);
 		m_running = false;
@@ -506,21 +1239,61 @@ FPSciLogger::~FPSciLogger()
 	m_queueCV.notify_one();
 	m_thread.join();
 
+	logQueueStats();
+	if (notNull(m_journal)) {
+		if (m_journal->skippedCount() > 0) {
+			logPrintf("Logger journal was full for %lld records (increase \"logRecoveryJournalSizeMB\" to journal them)\n", (long long)m_journal->skippedCount());
+		}
+		m_journal->close();
+	}
 	closeResultsFile();
 }
 
+void FPSciLogger::logQueueStats() const {
+	auto logStats = [](const char* name, const RingBufferStats& stats) {
+		logPrintf("Logger queue %-16s: capacity = %6d, high-water mark = %6d, dropped = %d, spilled = %d\n",
+			name, (int)stats.capacity, (int)stats.highWaterMark, (int)stats.dropped, (int)stats.spilled);
+	};
+	logStats("Frame_Info", m_frameInfo.stats());
+	logStats("Player_Action", m_playerActions.stats());
+	logStats("Target_Trajectory", m_targetLocations.stats());
+	logStats("Targets", m_targets.stats());
+	logStats("Trials", m_trials.stats());
+	logStats("Questions", m_questions.stats());
+	logStats("Users", m_users.stats());
+	logStats("Events", m_hardwareEvents.stats());
+}
+
 void FPSciLogger::flush(bool blockUntilDone)
 {
-	// Not implemented. Make another condition variable if this is needed.
-	assert(!blockUntilDone);
-	
-	{
-		std::lock_guard<std::mutex> lk(m_queueMutex);
-		m_flushNow = true;
+	std::unique_lock<std::mutex> lk(m_queueMutex);
+	const uint64 fence = requestFlush();
+	m_queueCV.notify_one();
+	if (blockUntilDone) {
+		m_flushDoneCV.wait(lk, [this, fence] { return m_flushCompleted >= fence; });
 	}
+}
+
+std::future<void> FPSciLogger::flushAsync()
+{
+	std::lock_guard<std::mutex> lk(m_queueMutex);
+	const uint64 fence = requestFlush();
+	m_flushPromises.emplace_back(fence, std::promise<void>());
+	std::future<void> done = m_flushPromises.back().second.get_future();
 	m_queueCV.notify_one();
+	return done;
 }
 
 void FPSciLogger::closeResultsFile() {
+	// Finalize the prepared statements before closing (otherwise the close fails w/ SQLITE_BUSY)
+	m_frameInfoInsert.reset();
+	m_playerActionInsert.reset();
+	m_targetLocationInsert.reset();
+	m_targetInsert.reset();
+	m_trialInsert.reset();
+	m_questionInsert.reset();
+	m_userInsert.reset();
+	m_eventInsert.reset();
+	m_clickLatencyInsert.reset();
 	sqlite3_close(m_db);
 }
\ No newline at end of file
@@ -1,9 +1,17 @@
 #pragma once
 #include <G3D/G3D.h>
 #include "sqlHelpers.h"
+#include "RingBuffer.h"
+#include "FPSciClock.h"
+#include "ColumnarWriter.h"
+#include "LogJournal.h"
+#include "HardwareEventLogger.h"
 #include "UserConfig.h"
 #include "Session.h"
 #include "Dialogs.h"
+#include <functional>
+#include <future>
+#include <deque>
 
 using RowEntry = Array<String>;
 using Columns = Array<Array<String>>;
@@ -11,75 +19,167 @@ using Columns = Array<Array<String>>;
 struct TargetLocation;
 struct PlayerAction;
 struct FrameInfo;
+class FrameTimeSchedule;
+struct TargetInfo;
+struct TrialValues;
+struct QuestionResult;
+struct UserValues;
 
-template<typename ItemType> static size_t queueBytes(Array<ItemType>& queue)
-{
-	return queue.size() * sizeof(ItemType);
-}
+/** The experiment a results file is created for (written to its Experiments table) */
+struct ExperimentInfo {
+	String	configFilename;				///< Experiment config filename (the file contents are stored in the table)
+	String	description;				///< Experiment description
+	String	hash;						///< Hash of the (loaded) experiment config as a hex string (see ExperimentConfig::hash())
+};
+
+/** Statistics for the writes performed by the logger thread */
+struct LoggerFlushStats {
+	int		flushCount = 0;				///< Number of flushes (transactions) written
+	int64	rowCount = 0;				///< Total number of rows written
+	double	totalSecs = 0.0;			///< Total time spent writing flushes
+	double	maxSecs = 0.0;				///< Longest time spent writing a single flush
+};
 
 /** Used to log data from experiments, sessions, trials and users
 	Uses SQLITE database output. */
 class FPSciLogger : public ReferenceCountedObject {
-public:
-	using TargetInfo = RowEntry;
-	using QuestionResult = RowEntry;
-	using TrialValues = RowEntry;
-	using UserValues = RowEntry;
-
 protected:
 	sqlite3* m_db = nullptr;						///< The db used for logging
 	
-	String m_openTimeStr;							///< Time string for database creation
+	String m_filename;								///< Name of the results file
+	String m_openTimeStr;							///< Start time string for the current session (empty if no session is open, only used from the main thread)
+	String m_sessionId;								///< ID of the session being logged (used for Trials table rows, protected by m_queueMutex)
+	String m_clickToPhotonMode;						///< Click-to-photon mode of the session being logged (used for Click_Latencies rows, protected by m_queueMutex)
 
 	// state of current database entries (not yet used)
 	long long int m_sessionRowID;
 	long long int m_userRowID;
 	long long int m_trialRowID;
 
-	const size_t m_bufferLimit = 1024 * 1024;		///< Flush every this many bytes
-	const LoggerConfig& m_config;					/// Logger configuration
+	const LoggerConfig m_config;					///< Logger configuration (copied since the logger can outlive the session that created it)
+	bool m_integerTimestamps = false;				///< Are timestamps in the high-rate tables stored as integer usec since epoch (in "_Raw" tables)?
+	const size_t m_lowRateQueueCapacity = 1024;		///< Capacity of the (low-rate) question, target, trial, and user queues
+
+	// Cached prepared statements for the high-rate tables (only used from the logger thread)
+	shared_ptr<PreparedInsert> m_frameInfoInsert;		///< Insert statement for the Frame_Info table
+	shared_ptr<PreparedInsert> m_playerActionInsert;	///< Insert statement for the Player_Action table
+	shared_ptr<PreparedInsert> m_targetLocationInsert;	///< Insert statement for the Target_Trajectory table
+	shared_ptr<PreparedInsert> m_targetInsert;			///< Insert statement for the Targets table
+	shared_ptr<PreparedInsert> m_trialInsert;			///< Insert statement for the Trials table
+	shared_ptr<PreparedInsert> m_questionInsert;		///< Insert statement for the Questions table
+	shared_ptr<PreparedInsert> m_userInsert;			///< Insert statement for the Users table
+	shared_ptr<PreparedInsert> m_eventInsert;			///< Insert statement for the Events table (created w/ the first hardware event)
+	shared_ptr<PreparedInsert> m_clickLatencyInsert;	///< Insert statement for the Click_Latencies table (created w/ the first hardware event)
+
+	shared_ptr<ColumnarWriter> m_columnar;				///< Columnar output for the high-rate tables (null unless logToColumnarFile is set, protected by m_queueMutex)
+
+	/** Record types stored in the recovery journal */
+	enum JournalRecordType : uint8 {
+		JournalFrameInfo = 1,
+		JournalPlayerAction = 2,
+		JournalTargetLocation = 3
+	};
+	shared_ptr<LogJournal> m_journal;					///< Recovery journal for the high-rate tables (null unless logRecoveryJournal is set)
+	Array<uint8> m_journalScratch;						///< Storage for serializing journal records (only used from the main thread)
+	uint64 m_journalSeq = 0;							///< Sequence number of the last journaled record (main thread only, continues past those in Journal_Commits)
 
 	bool m_running = false;
 	bool m_flushNow = false;
 	std::thread m_thread;
 	std::mutex m_queueMutex;
 	std::condition_variable m_queueCV;
+	LoggerFlushStats m_flushStats;						///< Flush statistics (protected by m_queueMutex)
 
-	// Output queues for reported data storage
-	Array<FrameInfo> m_frameInfo;						///< Storage for frame info (sdt, idt, rdt)
-	Array<PlayerAction> m_playerActions;				///< Storage for player action (hit, miss, aim)
-	Array<QuestionResult> m_questions;
-	Array<TargetLocation> m_targetLocations;			///< Storage for target trajectory (vector3 cartesian)
-	Array<TargetInfo> m_targets;
-	Array<TrialValues> m_trials;						///< Trial ID, start/end time etc.
-	Array<UserValues> m_users;
+	/** A (completed) session to build the summary tables for */
+	struct SessionSummaryRequest {
+		String sessionId;
+		String startTime;
+	};
+	Array<SessionSummaryRequest> m_pendingSummaries;	///< Sessions waiting to be summarized by the logger thread (protected by m_queueMutex)
 
-	size_t getTotalQueueBytes()
-	{
-		return queueBytes(m_frameInfo) +
-			queueBytes(m_playerActions) +
-			queueBytes(m_questions) +
-			queueBytes(m_targetLocations) +
-			queueBytes(m_targets) +
-			queueBytes(m_trials);
+	/** A write to the results file requested by the main thread. Once the logger thread is running it is the only thread
+		using m_db, so these are run (in order) by the logger thread at the start of its next flush. */
+	typedef std::function<void()> DBTask;
+	Array<DBTask> m_dbTasks;							///< Writes waiting to be run by the logger thread (protected by m_queueMutex)
+
+	// Flush fences (protected by m_queueMutex)
+	uint64 m_flushRequested = 0;						///< Sequence number of the most recently requested flush
+	uint64 m_flushCompleted = 0;						///< Sequence number of the most recent flush written (and committed) to the results file
+	std::condition_variable m_flushDoneCV;				///< Notified whenever m_flushCompleted advances
+	std::deque<std::pair<uint64, std::promise<void>>> m_flushPromises;	///< Pending flushAsync() requests (in sequence order)
+
+	// Output queues for reported data storage (produced by the main thread, consumed by the logger thread)
+	SpscRingBuffer<FrameInfo> m_frameInfo;				///< Storage for frame info (sdt, idt, rdt)
+	SpscRingBuffer<PlayerAction> m_playerActions;		///< Storage for player action (hit, miss, aim)
+	SpscRingBuffer<QuestionResult> m_questions;			///< Storage for question responses
+	SpscRingBuffer<TargetLocation> m_targetLocations;	///< Storage for target trajectory (vector3 cartesian)
+	SpscRingBuffer<TargetInfo> m_targets;				///< Storage for spawned target info
+	SpscRingBuffer<TrialValues> m_trials;				///< Trial ID, start/end time etc.
+	SpscRingBuffer<UserValues> m_users;					///< Storage for user settings
+	SpscRingBuffer<HardwareEvent> m_hardwareEvents;		///< Storage for hardware event logger events (produced by the event reader thread)
+
+	/** Is any of the high-rate queues full enough that the logger thread should write it out? */
+	bool queuesNeedFlush() const {
+		return m_frameInfo.size() >= m_frameInfo.capacity() / 2 ||
+			m_playerActions.size() >= m_playerActions.capacity() / 2 ||
+			m_targetLocations.size() >= m_targetLocations.capacity() / 2;
 	}
 
-	template<typename ItemType> void addToQueue(Array<ItemType>& queue, const ItemType& item)
+	template<typename ItemType> void addToQueue(SpscRingBuffer<ItemType>& queue, const ItemType& item)
 	{
-		{
-			std::lock_guard<std::mutex> lk(m_queueMutex);
-			queue.push_back(item);
+		// Wake up the logging thread once the queue is half full
+		if (queue.push(item) == queue.capacity() / 2) {
+			m_queueCV.notify_one();
 		}
+	}
 
-		// Wake up the logging thread if it needs to write out the results
-		size_t pendingBytes = getTotalQueueBytes();
-		if (pendingBytes >= m_bufferLimit) {
-			m_queueCV.notify_one();
+	/** Queue a record for a high-rate table, and append it to the recovery journal (if any) w/ the next sequence number */
+	template<typename ItemType> void addToQueueAndJournal(SpscRingBuffer<ItemType>& queue, const ItemType& item)
+	{
+		if (isNull(m_journal)) {
+			addToQueue(queue, item);
+			return;
 		}
+		ItemType journaled = item;
+		journaled.journalSeq = ++m_journalSeq;
+		addToQueue(queue, journaled);
+		journalRecord(journaled);
 	}
 
+	/** Append a record to the recovery journal (call after queueing the record, so a committed journal position never
+		covers a record the logger thread hasn't drained) */
+	void journalRecord(const FrameInfo& info);
+	void journalRecord(const PlayerAction& action);
+	void journalRecord(const TargetLocation& loc);
+
+	/** Create the Journal_Commits table (the sequence number of the last journaled record of each type in the results file) */
+	void createJournalCommitsTable();
+	/** Record that the journaled records of a type up to (and including) seq are in the results file (call in the same transaction) */
+	void recordJournalCommit(JournalRecordType type, uint64 seq);
+
+	/** Name of the recovery journal for the results file */
+	String journalFilename() const;
+
+	/** Write any uncommitted records from a previous run's recovery journal to the results file */
+	void replayJournal();
+
+	/** Write the high-water mark (and any dropped/spilled record counts) for each queue to the log */
+	void logQueueStats() const;
+
 	void loggerThreadEntry();
 
+	/** Request a flush, returns the sequence number of the flush (call w/ m_queueMutex held) */
+	uint64 requestFlush() {
+		m_flushNow = true;
+		return ++m_flushRequested;
+	}
+
+	/** Mark all flushes up to (and including) fence as complete, waking any waiters (call w/ m_queueMutex held) */
+	void completeFlush(uint64 fence);
+
+	/** Queue a write to the results file to run on the logger thread (see DBTask) */
+	void queueDBTask(const DBTask& task);
+
 	/** Record an array of frame timing info */
 	void recordFrameInfo(const Array<FrameInfo>& info);
 
@@ -89,19 +189,53 @@ protected:
 	/** Record an array of target locations */
 	void recordTargetLocations(const Array<TargetLocation>& locations);
 
+	/** Write the high-rate tables for a flush to the columnar output */
+	void recordColumnar(ColumnarWriter& columnar, const Array<FrameInfo>& frameInfo, const Array<PlayerAction>& actions, const Array<TargetLocation>& locations);
+
+	/** Record an array of spawned targets */
+	void recordTargets(const Array<TargetInfo>& targets);
+
+	/** Record an array of trial results (for session sessionId) */
+	void recordTrials(const Array<TrialValues>& trials, const String& sessionId);
+
+	/** Record an array of question responses */
+	void recordQuestions(const Array<QuestionResult>& questions);
+
+	/** Record an array of user settings */
+	void recordUsers(const Array<UserValues>& users);
+
+	/** Record an array of hardware logger events (and their click-to-photon latencies) for session sessionId */
+	void recordHardwareEvents(const Array<HardwareEvent>& events, const String& sessionId, const String& clickToPhotonMode);
+
 	/** Open a results file, or create it if it doesn't exist */
 	void initResultsFile(const String& filename, 
-		const String& subjectID, 
-		const String& expConfigFilename,
-		const shared_ptr<SessionConfig>& sessConfig, 
-		const String& description);
+		const ExperimentInfo& experiment,
+		const shared_ptr<SessionConfig>& sessConfig);
+
+	/** Apply the configured SQLite pragmas (journal mode and synchronous) to the open results file */
+	void applyPragmas();
+
+	/** Prepare the cached insert statements (called once the schema exists) */
+	void prepareInserts();
+
+	/** Name of the table rows are inserted into for a table w/ a (potentially integer) timestamp column */
+	String timedTableName(const String& tableName) const { return m_integerTimestamps ? tableName + "_Raw" : tableName; }
+
+	/** Create a table whose first column is a timestamp. When using integer timestamps this creates a "_Raw" table
+		storing usec since epoch, plus a view (w/ the original table name) presenting the time as formatted text */
+	void createTimedTable(const String& tableName, const Columns& columns);
+
+	/** Bind a timestamp to an insert for a table created using createTimedTable() */
+	PreparedInsert& bindTime(const shared_ptr<PreparedInsert>& insert, FPSciTimestamp time) const {
+		return m_integerTimestamps ? insert->bindInt(time) : insert->bindText(FPSciClock::format(time));
+	}
 
 	/** Close the results file */
 	void closeResultsFile(void);
 
 	// Functions that set up the database schema
 	/** Create a session table with columns as specified by the provided sessionConfig */
-	void createExperimentsTable(const String& expConfigFilename);
+	void createExperimentsTable(const ExperimentInfo& experiment);
 	void createSessionsTable(const shared_ptr<SessionConfig>& sessConfig);
 	void createTargetTypeTable();
 	void createTargetsTable();
@@ -109,8 +243,16 @@ protected:
 	void createTargetTrajectoryTable();
 	void createPlayerActionTable();
 	void createFrameInfoTable();
+	/** Add the frame timing columns to the frame info table of an existing results file (if it doesn't have them) */
+	void addFrameTimingColumns();
 	void createQuestionsTable();
 	void createUsersTable();
+	void createTrialSummaryTable();
+	void createHardwareEventTables();
+
+	/** Index the results file and write the Trial_Summary rows for a completed session (called from the logger thread, which
+		runs all writes to the results file, so nothing else can join the summary's transaction) */
+	void buildSessionSummary(const SessionSummaryRequest& session);
 
 	// Functions that assume the schema from above
 	//void insertSession(sessionInfo);
@@ -119,39 +261,64 @@ protected:
 
 public:
 
-	FPSciLogger(const String& filename, const String& subjectID, const String& expConfigFilename, const shared_ptr<SessionConfig>& sessConfig, const String& description);
+	FPSciLogger(const String& filename, const String& subjectID, const ExperimentInfo& experiment, const shared_ptr<SessionConfig>& sessConfig, const String& description);
 	virtual ~FPSciLogger();
 	
 	static shared_ptr<FPSciLogger> create(const String& filename, 
 		const String& subjectID, 
-		const String& expConfigFilename,
+		const ExperimentInfo& experiment,
 		const shared_ptr<SessionConfig>& sessConfig,
 		const String& description="None") 
 	{
-		return createShared<FPSciLogger>(filename, subjectID, expConfigFilename, sessConfig, description);
+		return createShared<FPSciLogger>(filename, subjectID, experiment, sessConfig, description);
 	}
 
+	/** Start a new session in this (already open) results file, ending any session that is still open */
+	void beginSession(const String& subjectID, const shared_ptr<SessionConfig>& sessConfig, const String& description);
+
+	/** End the current session, waiting until everything logged for it has been written to the results file */
+	void endSession();
+
+	/** Can this logger be reused for a session logging to filename w/ the provided logger config? */
+	bool canLogSession(const String& filename, const LoggerConfig& config) const;
+
+	const String& filename() const { return m_filename; }
+
 	void updateSessionEntry(bool complete, int trialCount);
 
-	void logFrameInfo(const FrameInfo& frameInfo) { addToQueue(m_frameInfo, frameInfo); }
-	void logPlayerAction(const PlayerAction& playerAction) { addToQueue(m_playerActions, playerAction); }
+	void logFrameInfo(const FrameInfo& frameInfo) { addToQueueAndJournal(m_frameInfo, frameInfo); }
+	void logPlayerAction(const PlayerAction& playerAction) { addToQueueAndJournal(m_playerActions, playerAction); }
 	void logQuestionResult(const QuestionResult& questionResult) { addToQueue(m_questions, questionResult); }
-	void logTargetLocation(const TargetLocation& targetLocation) { addToQueue(m_targetLocations, targetLocation); }
+	void logTargetLocation(const TargetLocation& targetLocation) { addToQueueAndJournal(m_targetLocations, targetLocation); }
 	void logTargetInfo(const TargetInfo& targetInfo) { addToQueue(m_targets, targetInfo); }
 	void logTrial(const TrialValues& trial) { addToQueue(m_trials, trial); }
+	/** Log an event from the hardware event logger (only call from a single thread, i.e. the event reader thread) */
+	void logHardwareEvent(const HardwareEvent& event) { addToQueue(m_hardwareEvents, event); }
 
 	void logUserConfig(const UserConfig& userConfig, const String& sessId, const Vector2& sessTurnScale);
-	void logTargetTypes(const Array<shared_ptr<TargetConfig>>& targets);
+	void logTargetTypes(const Array<shared_ptr<const TargetConfig>>& targets);
+	/** Log the (compiled) frame time schedule of a session (once, at the start of the session) */
+	void logFrameTimeSchedule(const String& sessId, const FrameTimeSchedule& schedule);
+	/** Log the seed of a session's random streams (once, at the start of the session) */
+	void logRandomSeed(const String& sessId, int64 seed);
 
-	/** Wakes up the logging thread and flushes even if the buffer limit is not reached yet. */
+	/** Wakes up the logging thread and flushes even if the buffer limit is not reached yet. If blockUntilDone is set
+		this waits until everything logged before the call has been committed to the results file. */
 	void flush(bool blockUntilDone);
+
+	/** Wakes up the logging thread and flushes, the returned future is ready once everything logged before the call
+		has been committed to the results file */
+	std::future<void> flushAsync();
+
+	/** Get the statistics for the flushes written so far */
+	LoggerFlushStats flushStats() {
+		std::lock_guard<std::mutex> lk(m_queueMutex);
+		return m_flushStats;
+	}
 	
 	/** Generate a timestamp for logging */
 	static String genUniqueTimestamp();
 
-	static FILETIME getFileTime();
-	static String formatFileTime(FILETIME ft);
-
 	/** Genearte a timestamp for filenames */
 	static String genFileTimestamp();
 
@@ -159,5 +326,5 @@ public:
 	void addQuestion(Question question, String session, const shared_ptr<DialogBase>& dialog);
 
 	/** Add a target to an experiment */
-	void addTarget(const String& name, const shared_ptr<TargetConfig>& targetConfig, const String& spawnTime, const float& size, const Point2& spawnEcc);
+	void addTarget(const String& name, const shared_ptr<const TargetConfig>& targetConfig, FPSciTimestamp spawnTime, const float& size, const Point2& spawnEcc);
 };
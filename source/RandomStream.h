@@ -0,0 +1,95 @@
+#pragma once
+#include <G3D/G3D.h>
+
+/** A seeded, counter-based random number stream.
+
+	Each value is a hash of the stream's seed and the value's index (the counter), so a stream's output only depends on its seed
+	and how many values were drawn from it (not on draws from any other stream or thread). Independent streams are derived
+	from a parent stream by id (see child()), which is how the session, trial, target, and weapon streams are organized (see
+	Session), so any of them can be regenerated from the logged session seed. */
+class RandomStream {
+protected:
+	uint64	m_seed = 0;			///< Key for this stream
+	uint64	m_counter = 0;		///< Index of the next value
+
+	/** SplitMix64 finalizer (a bijective 64-bit hash) */
+	static uint64 mix(uint64 x) {
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+public:
+	RandomStream() {}
+	explicit RandomStream(uint64 seed) : m_seed(seed) {}
+
+	uint64 seed() const { return m_seed; }
+	/** Number of values drawn so far */
+	uint64 counter() const { return m_counter; }
+
+	/** Derive an independent stream (the same id always gives the same stream) */
+	RandomStream child(uint64 id) const {
+		return RandomStream(mix(m_seed ^ mix(id + 0x9E3779B97F4A7C15ULL)));
+	}
+	RandomStream child(const String& name) const {
+		uint64 hash = 14695981039346656037ULL;		// FNV-1a
+		for (const char c : name) {
+			hash ^= (uint8)c;
+			hash *= 1099511628211ULL;
+		}
+		return child(hash);
+	}
+
+	/** Next 64 random bits */
+	uint64 bits() {
+		return mix(m_seed + (++m_counter) * 0x9E3779B97F4A7C15ULL);
+	}
+
+	/** Uniform in [0, 1) */
+	float uniform() {
+		return (float)(bits() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	/** Uniform in [low, high) */
+	float uniform(float low, float high) {
+		return low + (high - low) * uniform();
+	}
+
+	/** Uniform integer in [low, high] */
+	int integer(int low, int high) {
+		return low + (int)(bits() % (uint64)(high - low + 1));
+	}
+
+	/** Normally distributed (Box-Muller) */
+	float gaussian(float mean, float stdev) {
+		const float u1 = 1.0f - uniform();			// (0, 1] so the log is finite
+		const float u2 = uniform();
+		return mean + stdev * sqrtf(-2.0f * logf(u1)) * cosf(2.0f * pif() * u2);
+	}
+
+	/** -1 or 1 w/ equal probability */
+	float sign() {
+		return uniform() > 0.5f ? 1.0f : -1.0f;
+	}
+
+	/** Uniformly distributed unit vector */
+	Vector3 unitVector() {
+		while (true) {
+			const float x = uniform(-1.0f, 1.0f);		// Drawn in order (argument evaluation order is unspecified)
+			const float y = uniform(-1.0f, 1.0f);
+			const float z = uniform(-1.0f, 1.0f);
+			const Vector3 v(x, y, z);
+			const float length2 = v.dot(v);
+			if (length2 > 1e-6f && length2 <= 1.0f) return v / sqrtf(length2);
+		}
+	}
+
+	/** Uniformly distributed point inside a box */
+	Point3 interiorPoint(const AABox& box) {
+		const Vector3 extent = box.high() - box.low();
+		const float x = uniform();
+		const float y = uniform();
+		const float z = uniform();
+		return box.low() + Vector3(x * extent.x, y * extent.y, z * extent.z);
+	}
+};
@@ -0,0 +1,303 @@
+#include "ResultsMerger.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+const char* const ResultsMerger::sourceColumn = "source_file";
+
+/** Quote an identifier (table/column name) for use in a statement */
+static String quoteName(const String& name) {
+	String quoted = "\"";
+	for (char c : name) {
+		if (c == '"') quoted += '"';
+		quoted += c;
+	}
+	return quoted + "\"";
+}
+
+/** Is there a table or view w/ this name in the database? */
+static bool nameExistsInDB(sqlite3* db, const String& name) {
+	shared_ptr<PreparedQuery> query = PreparedQuery::create(db, "SELECT 1 FROM sqlite_master WHERE name = ?;");
+	query->bindText(name);
+	return query->step();
+}
+
+ResultsMerger::ResultsMerger(const String& outputFilename, int threadCount) : m_outputFilename(outputFilename) {
+	m_threadCount = threadCount > 0 ? threadCount : max(1, (int)std::thread::hardware_concurrency());
+}
+
+ResultsMerger::~ResultsMerger() {
+	// Finalize the prepared statements before closing
+	m_outputTables.clear();
+	m_mergedFileInsert.reset();
+	if (notNull(m_db)) sqlite3_close(m_db);
+}
+
+shared_ptr<ResultsMerger::InputFile> ResultsMerger::readInputFile(const String& filename) {
+	shared_ptr<InputFile> input = createShared<InputFile>();
+	input->filename = filename;
+
+	sqlite3* db = nullptr;
+	if (sqlite3_open_v2(filename.c_str(), &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+		logPrintf("Error opening results file %s: %s\n", filename.c_str(), sqlite3_errmsg(db));
+		sqlite3_close(db);
+		return input;
+	}
+
+	{
+		shared_ptr<PreparedQuery> schema = PreparedQuery::create(db,
+			"SELECT type, name, sql FROM sqlite_master WHERE type IN ('table', 'view') AND name NOT LIKE 'sqlite_%' ORDER BY rowid;");
+		input->valid = schema->valid();
+		while (schema->step()) {
+			const String name = schema->columnText(1);
+			if (schema->columnText(0) == "view") {
+				input->viewNames.append(name);
+				input->viewSql.append(schema->columnText(2));
+				continue;
+			}
+
+			if (name == "Journal_Commits") continue;		// Recovery journal bookkeeping for the input file (not results)
+
+			InputTable& table = input->tables.next();
+			table.name = name;
+			shared_ptr<PreparedQuery> columns = PreparedQuery::create(db, "PRAGMA table_info(" + quoteName(name) + ");");
+			while (columns->step()) {
+				table.columns.append(columns->columnText(1));
+				table.types.append(columns->columnText(2));
+			}
+
+			// Read every row (SQLite converts nothing here, values keep their storage class)
+			const int columnCount = table.columns.size();
+			shared_ptr<PreparedQuery> rows = PreparedQuery::create(db, "SELECT * FROM " + quoteName(name) + ";");
+			while (rows->step()) {
+				for (int col = 0; col < columnCount; col++) {
+					Cell& cell = table.cells.next();
+					cell.type = rows->columnType(col);
+					switch (cell.type) {
+					case SQLITE_INTEGER: cell.intValue = rows->columnInt(col); break;
+					case SQLITE_FLOAT: cell.realValue = rows->columnReal(col); break;
+					case SQLITE_NULL: break;
+					default: {
+						// Text (and any blobs, which FPSci doesn't write) are stored as text
+						const String text = rows->columnText(col);
+						cell.type = SQLITE_TEXT;
+						cell.textOffset = (uint32)table.textData.size();
+						cell.textLength = (uint32)text.size();
+						table.textData += text;
+						break;
+					}
+					}
+				}
+			}
+		}
+	}
+	sqlite3_close(db);
+	return input;
+}
+
+Array<String> ResultsMerger::findResultsFiles(const Array<String>& paths) {
+	Array<String> files;
+	Array<String> directories;
+	for (const String& path : paths) {
+		if (FileSystem::isDirectory(path)) directories.append(path);
+		else files.append(path);
+	}
+	while (directories.size() > 0) {
+		const String dir = FilePath::concat(directories.pop(), "");
+		Array<String> found;
+		FileSystem::getFiles(FilePath::concat(dir, "*.db"), found, true);
+		files.append(found);
+		Array<String> subdirectories;
+		FileSystem::getDirectories(FilePath::concat(dir, "*"), subdirectories, true);
+		directories.append(subdirectories);
+	}
+	files.sort();
+	return files;
+}
+
+ResultsMerger::OutputTable& ResultsMerger::prepareOutputTable(const InputTable& table) {
+	OutputTable* output = m_outputTables.getPointer(table.name);
+	if (isNull(output)) {
+		// Create the table w/ the input's columns (w/o any constraints, since not every input may have every column)
+		String createC = "CREATE TABLE " + quoteName(table.name) + " (";
+		for (int i = 0; i < table.columns.size(); i++) {
+			createC += quoteName(table.columns[i]) + " " + table.types[i] + ", ";
+		}
+		createC += quoteName(sourceColumn) + " TEXT);";
+		execStatementInDB(m_db, createC);
+
+		m_outputTables.set(table.name, OutputTable());
+		output = m_outputTables.getPointer(table.name);
+		output->columns = table.columns;
+		output->columns.append(sourceColumn);
+		return *output;
+	}
+
+	// Add any columns this table hasn't had before
+	for (int i = 0; i < table.columns.size(); i++) {
+		if (!output->columns.contains(table.columns[i])) {
+			execStatementInDB(m_db, "ALTER TABLE " + quoteName(table.name) + " ADD COLUMN " + quoteName(table.columns[i]) + " " + table.types[i] + ";");
+			output->columns.append(table.columns[i]);
+		}
+	}
+	return *output;
+}
+
+int64 ResultsMerger::writeTable(const InputTable& table, const String& sourceFile, Array<String>& experimentHashes) {
+	if (table.columns.size() == 0) return 0;
+	OutputTable& output = prepareOutputTable(table);
+
+	// Inputs that were themselves merged already say which file each row came from
+	const bool hasSource = table.columns.contains(sourceColumn);
+
+	// Get (or prepare) the insert for this set of input columns
+	String columnList;
+	for (int i = 0; i < table.columns.size(); i++) {
+		columnList += (i > 0 ? ", " : "") + quoteName(table.columns[i]);
+	}
+	if (!hasSource) columnList += ", " + quoteName(sourceColumn);
+	shared_ptr<PreparedInsert>* insertPtr = output.inserts.getPointer(columnList);
+	if (isNull(insertPtr)) {
+		output.inserts.set(columnList, PreparedInsert::create(m_db, quoteName(table.name), table.columns.size() + (hasSource ? 0 : 1), " (" + columnList + ")"));
+		insertPtr = output.inserts.getPointer(columnList);
+	}
+	PreparedInsert& insert = **insertPtr;
+
+	// Experiments rows are only written once per hash
+	const int hashCol = table.name == "Experiments" ? table.columns.findIndex("hash") : -1;
+
+	int64 rowsWritten = 0;
+	const int columnCount = table.columns.size();
+	for (int row = 0; row < table.rowCount(); row++) {
+		const Cell* cells = table.cells.getCArray() + row * columnCount;
+		if (hashCol >= 0) {
+			const Cell& hashCell = cells[hashCol];
+			const String hash = hashCell.type == SQLITE_TEXT ? table.textData.substr(hashCell.textOffset, hashCell.textLength) : "";
+			if (!experimentHashes.contains(hash)) experimentHashes.append(hash);
+			if (m_experimentHashes.containsKey(hash)) {
+				m_stats.duplicateExperiments++;
+				continue;
+			}
+			m_experimentHashes.set(hash, true);
+		}
+
+		for (int col = 0; col < columnCount; col++) {
+			const Cell& cell = cells[col];
+			switch (cell.type) {
+			case SQLITE_INTEGER: insert.bindInt(cell.intValue); break;
+			case SQLITE_FLOAT: insert.bindReal(cell.realValue); break;
+			case SQLITE_TEXT: insert.bindText(table.textData.c_str() + cell.textOffset, (int)cell.textLength); break;
+			default: insert.bindNull(); break;
+			}
+		}
+		if (!hasSource) insert.bindText(sourceFile);
+		if (insert.insert()) rowsWritten++;
+	}
+	return rowsWritten;
+}
+
+void ResultsMerger::writeInputFile(const InputFile& input) {
+	if (!input.valid) {
+		logPrintf("WARNING: Skipping unreadable results file: %s\n", input.filename.c_str());
+		m_stats.filesFailed++;
+		return;
+	}
+
+	Array<String> experimentHashes;
+	int64 rowCount = 0;
+	for (const InputTable& table : input.tables) {
+		rowCount += writeTable(table, input.filename, experimentHashes);
+	}
+	for (int i = 0; i < input.viewNames.size(); i++) {
+		if (!m_viewNames.contains(input.viewNames[i])) {
+			m_viewNames.append(input.viewNames[i]);
+			m_viewSql.append(input.viewSql[i]);
+		}
+	}
+
+	String hashes;
+	for (const String& hash : experimentHashes) hashes += (hashes.empty() ? "" : ",") + hash;
+	m_mergedFileInsert->bindText(input.filename)
+		.bindText(hashes)
+		.bindInt(rowCount)
+		.insert();
+
+	m_stats.filesMerged++;
+	m_stats.rowCount += rowCount;
+}
+
+ResultsMergeStats ResultsMerger::merge(const Array<String>& inputFilenames) {
+	const auto start = std::chrono::steady_clock::now();
+	m_stats = ResultsMergeStats();
+
+	// The merged file can always be rebuilt from the inputs, so don't pay for a journal or syncs while writing it
+	if (FileSystem::exists(m_outputFilename)) FileSystem::removeFile(m_outputFilename);
+	if (sqlite3_open(m_outputFilename.c_str(), &m_db)) {
+		logPrintf("Error opening merged results file: %s\n", m_outputFilename.c_str());
+		return m_stats;
+	}
+	execStatementInDB(m_db, "PRAGMA journal_mode = OFF;");
+	execStatementInDB(m_db, "PRAGMA synchronous = OFF;");
+
+	Array<Array<String>> mergedFileColumns = {
+		{ sourceColumn, "text" },
+		{ "experiment_hash", "text" },
+		{ "row_count", "integer" },
+	};
+	createTableInDB(m_db, "Merged_Files", mergedFileColumns);
+	m_mergedFileInsert = PreparedInsert::create(m_db, "Merged_Files", 3);
+
+	// Workers read the inputs (at most a few files ahead of the writer, to bound memory use)
+	const int fileCount = inputFilenames.size();
+	const int readAhead = m_threadCount;
+	std::atomic<int> nextToRead(0);
+	m_results.clear();
+	m_results.resize(fileCount);
+	m_nextToWrite = 0;
+	std::vector<std::thread> workers;		// (G3D::Array requires copyable elements)
+	for (int t = 0; t < min(m_threadCount, fileCount); t++) {
+		workers.push_back(std::thread([&] {
+			for (int idx = nextToRead++; idx < fileCount; idx = nextToRead++) {
+				{
+					std::unique_lock<std::mutex> lk(m_mutex);
+					m_cv.wait(lk, [&] { return idx < m_nextToWrite + readAhead; });
+				}
+				shared_ptr<InputFile> input = readInputFile(inputFilenames[idx]);
+				{
+					std::lock_guard<std::mutex> lk(m_mutex);
+					m_results[idx] = input;
+				}
+				m_cv.notify_all();
+			}
+		}));
+	}
+
+	// Write the inputs in order, in a single transaction
+	beginTransactionInDB(m_db);
+	for (int idx = 0; idx < fileCount; idx++) {
+		shared_ptr<InputFile> input;
+		{
+			std::unique_lock<std::mutex> lk(m_mutex);
+			m_cv.wait(lk, [&] { return notNull(m_results[idx]); });
+			input = m_results[idx];
+			m_results[idx].reset();
+			m_nextToWrite = idx + 1;
+		}
+		m_cv.notify_all();
+		writeInputFile(*input);
+	}
+	commitTransactionInDB(m_db);
+	for (std::thread& worker : workers) worker.join();
+
+	// Add views whose names weren't used by a table (e.g. text timestamp tables merged w/ integer timestamp views)
+	for (int i = 0; i < m_viewNames.size(); i++) {
+		if (nameExistsInDB(m_db, m_viewNames[i])) {
+			logPrintf("WARNING: Not creating view %s in the merged results (a table w/ this name exists)\n", m_viewNames[i].c_str());
+			continue;
+		}
+		execStatementInDB(m_db, m_viewSql[i]);
+	}
+
+	m_stats.totalSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return m_stats;
+}
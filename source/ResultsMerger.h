@@ -0,0 +1,106 @@
+#pragma once
+#include <G3D/G3D.h>
+#include "sqlHelpers.h"
+#include <condition_variable>
+#include <mutex>
+
+/** Statistics for a results merge */
+struct ResultsMergeStats {
+	int		filesMerged = 0;				///< Number of input files merged
+	int		filesFailed = 0;				///< Number of input files that couldn't be read
+	int64	rowCount = 0;					///< Total number of rows written
+	int		duplicateExperiments = 0;		///< Number of Experiments rows skipped because their hash was already merged
+	double	totalSecs = 0.0;				///< Total time spent merging
+};
+
+/** Merges many FPSci results files (e.g. one per session per user when "logToSingleDb" is false) into a single database.
+
+	Input files are read in parallel by a pool of worker threads, while the calling thread writes them (in input order) to
+	the output in a single transaction. Each output table has the union of the columns of the matching input tables, plus a
+	"source_file" column recording which input each row came from. Experiments rows are deduplicated by their hash, and a
+	Merged_Files table records the experiment hash(es) and row count of each input file. Views (e.g. those presenting
+	integer timestamps as text) are copied from the first input that has them. */
+class ResultsMerger : public ReferenceCountedObject {
+public:
+	/** A single value read from an input file (text is stored in the owning table's textData) */
+	struct Cell {
+		int			type = SQLITE_NULL;		///< SQLite storage class (SQLITE_INTEGER, SQLITE_FLOAT, SQLITE_TEXT, or SQLITE_NULL)
+		int64		intValue = 0;
+		double		realValue = 0.0;
+		uint32		textOffset = 0;
+		uint32		textLength = 0;
+	};
+
+	/** The contents of a table read from an input file */
+	struct InputTable {
+		String			name;
+		Array<String>	columns;
+		Array<String>	types;				///< Declared column types (used when the output table/column is created)
+		Array<Cell>		cells;				///< Row-major values (columns.size() per row)
+		String			textData;			///< Storage for all text values
+
+		int rowCount() const { return columns.size() == 0 ? 0 : cells.size() / columns.size(); }
+	};
+
+	/** The contents of an input file */
+	struct InputFile {
+		String				filename;
+		bool				valid = false;
+		Array<InputTable>	tables;
+		Array<String>		viewNames;
+		Array<String>		viewSql;
+	};
+
+protected:
+	/** An output table (and the insert statements used for the input column sets seen so far) */
+	struct OutputTable {
+		Array<String>							columns;
+		Table<String, shared_ptr<PreparedInsert>>	inserts;		///< Keyed by the input column list
+	};
+
+	String						m_outputFilename;
+	int							m_threadCount;
+	sqlite3*					m_db = nullptr;
+	Table<String, OutputTable>	m_outputTables;
+	Table<String, bool>			m_experimentHashes;				///< Hashes of the Experiments rows already written
+	shared_ptr<PreparedInsert>	m_mergedFileInsert;				///< Insert statement for the Merged_Files table
+	Array<String>				m_viewNames;					///< Views to create once all tables are written (first input w/ each view)
+	Array<String>				m_viewSql;
+	ResultsMergeStats			m_stats;
+
+	// Reordering of the worker results (so the output is written in input order)
+	std::mutex					m_mutex;
+	std::condition_variable		m_cv;
+	Array<shared_ptr<InputFile>>	m_results;					///< Read input files, indexed by input order (protected by m_mutex)
+	int							m_nextToWrite = 0;				///< Index of the next input file to write (protected by m_mutex)
+
+	/** Write a (read) input file to the output */
+	void writeInputFile(const InputFile& input);
+
+	/** Write the rows of an input table to the output, returns the number of rows written */
+	int64 writeTable(const InputTable& table, const String& sourceFile, Array<String>& experimentHashes);
+
+	/** Create the output table, or add any columns it is missing, for an input table */
+	OutputTable& prepareOutputTable(const InputTable& table);
+
+public:
+	/** Name of the column recording the input file each row came from */
+	static const char* const sourceColumn;
+
+	ResultsMerger(const String& outputFilename, int threadCount);
+	virtual ~ResultsMerger();
+
+	/** Merge into outputFilename (which is replaced if it exists) using threadCount worker threads (0 to use the hardware concurrency) */
+	static shared_ptr<ResultsMerger> create(const String& outputFilename, int threadCount = 0) {
+		return createShared<ResultsMerger>(outputFilename, threadCount);
+	}
+
+	/** Merge the input files into the output, returns statistics for the merge */
+	ResultsMergeStats merge(const Array<String>& inputFilenames);
+
+	/** Read the tables and views of an input file (thread safe) */
+	static shared_ptr<InputFile> readInputFile(const String& filename);
+
+	/** Expand a list of results files and/or directories (searched recursively for .db files) into a sorted list of files */
+	static Array<String> findResultsFiles(const Array<String>& paths);
+};
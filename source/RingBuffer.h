@@ -0,0 +1,165 @@
+#pragma once
+#include <G3D/G3D.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/** Behavior of a SpscRingBuffer when the producer pushes into a full buffer */
+enum class RingOverflowPolicy {
+	Block,				///< Wait (yield) until the consumer frees space (no data loss, but can stall the producer)
+	DropOldest,			///< Discard the oldest item in the buffer to make room for the new one
+	Spill				///< Append to an unbounded (locked) overflow array that the consumer drains after the ring
+};
+
+inline RingOverflowPolicy ringOverflowPolicyFromString(const String& policy) {
+	const String p = toLower(policy);
+	if (p == "block") return RingOverflowPolicy::Block;
+	if (p == "dropoldest") return RingOverflowPolicy::DropOldest;
+	return RingOverflowPolicy::Spill;
+}
+
+/** Counters describing how full a ring buffer has been */
+struct RingBufferStats {
+	size_t capacity = 0;				///< Number of items the ring can hold
+	size_t highWaterMark = 0;			///< Maximum number of items held at once
+	size_t dropped = 0;					///< Number of items discarded (DropOldest policy)
+	size_t spilled = 0;					///< Number of items written to the overflow array (Spill policy)
+};
+
+/** Fixed-capacity single-producer/single-consumer ring buffer.
+	push() must only be called from one (producer) thread and popAll() from one (consumer) thread.
+	While the ring has space, push() does not take any lock or allocate any memory. */
+template<typename T> class SpscRingBuffer {
+protected:
+	Array<T>					m_items;					///< Storage for the ring (fixed size, power of 2)
+	size_t						m_mask = 0;					///< Capacity - 1 (used to wrap indices)
+	RingOverflowPolicy			m_policy;					///< What to do when the ring is full
+
+	alignas(64) std::atomic<size_t> m_head{ 0 };				///< Next index to write (only written by the producer)
+	alignas(64) std::atomic<size_t> m_tail{ 0 };				///< Next index to read (only written by the consumer, or the producer when dropping)
+
+	std::mutex					m_overflowMutex;			///< Protects m_spill, and the tail in DropOldest mode
+	Array<T>					m_spill;					///< Overflow storage (Spill policy)
+	std::atomic<bool>			m_hasSpill{ false };			///< Are there items in m_spill? (keeps items in order)
+
+	std::atomic<size_t>			m_highWaterMark{ 0 };
+	std::atomic<size_t>			m_dropped{ 0 };
+	std::atomic<size_t>			m_spilled{ 0 };
+
+	inline void store(size_t head, const T& item) {
+		m_items[(int)(head & m_mask)] = item;
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	/** Move everything up to the current head of the ring into output (lock-free, not used w/ DropOldest) */
+	void drainRing(Array<T>& output) {
+		const size_t head = m_head.load(std::memory_order_acquire);
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		output.reserve(output.size() + (int)(head - tail));
+		for (; tail != head; tail++) {
+			output.append(m_items[(int)(tail & m_mask)]);
+		}
+		m_tail.store(tail, std::memory_order_release);
+	}
+
+public:
+	SpscRingBuffer(size_t capacity, RingOverflowPolicy policy = RingOverflowPolicy::Spill) : m_policy(policy) {
+		// Round the capacity up to a power of 2 so that indices wrap with a mask
+		size_t cap = 1;
+		while (cap < max(capacity, (size_t)2)) cap <<= 1;
+		m_items.resize((int)cap);
+		m_mask = cap - 1;
+	}
+
+	size_t capacity() const { return m_mask + 1; }
+
+	/** Approximate number of items in the ring (exact when called from the producer or consumer thread) */
+	size_t size() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+
+	/** Add an item to the buffer (producer thread only), handling a full buffer according to the overflow policy.
+		Returns the number of items in the ring after the push. */
+	size_t push(const T& item) {
+		const size_t head = m_head.load(std::memory_order_relaxed);
+		size_t tail = m_tail.load(std::memory_order_acquire);
+
+		if (m_policy == RingOverflowPolicy::Spill && m_hasSpill.load(std::memory_order_acquire)) {
+			// Items are already spilling, keep spilling to preserve ordering
+			std::lock_guard<std::mutex> lk(m_overflowMutex);
+			m_spill.append(item);
+			m_hasSpill.store(true, std::memory_order_release);
+			m_spilled.fetch_add(1, std::memory_order_relaxed);
+			return head - tail;
+		}
+
+		if (head - tail > m_mask) {
+			switch (m_policy) {
+			case RingOverflowPolicy::Block:
+				while (head - tail > m_mask) {
+					std::this_thread::yield();
+					tail = m_tail.load(std::memory_order_acquire);
+				}
+				break;
+			case RingOverflowPolicy::DropOldest: {
+				std::lock_guard<std::mutex> lk(m_overflowMutex);
+				tail = m_tail.load(std::memory_order_acquire);
+				if (head - tail > m_mask) {
+					m_tail.store(tail + 1, std::memory_order_release);		// Discard the oldest item (consumer reads under the same lock)
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					tail++;
+				}
+				break;
+			}
+			case RingOverflowPolicy::Spill: {
+				std::lock_guard<std::mutex> lk(m_overflowMutex);
+				m_spill.append(item);
+				m_hasSpill.store(true, std::memory_order_release);
+				m_spilled.fetch_add(1, std::memory_order_relaxed);
+				return head - tail;
+			}
+			}
+		}
+
+		store(head, item);
+		const size_t count = head + 1 - tail;
+		if (count > m_highWaterMark.load(std::memory_order_relaxed)) {
+			m_highWaterMark.store(count, std::memory_order_relaxed);
+		}
+		return count;
+	}
+
+	/** Move all items currently in the buffer (and any spilled items) to the end of output (consumer thread only) */
+	void popAll(Array<T>& output) {
+		if (m_policy == RingOverflowPolicy::DropOldest) {
+			// The producer may advance the tail when dropping, so read each item under the lock (at most one ring's worth per call)
+			for (size_t i = 0; i <= m_mask; i++) {
+				std::lock_guard<std::mutex> lk(m_overflowMutex);
+				const size_t tail = m_tail.load(std::memory_order_relaxed);
+				if (tail == m_head.load(std::memory_order_acquire)) break;
+				output.append(m_items[(int)(tail & m_mask)]);
+				m_tail.store(tail + 1, std::memory_order_release);
+			}
+		}
+		else {
+			drainRing(output);
+		}
+
+		// Spilled items are always newer than the ones in the ring. Once m_hasSpill is set the producer stops writing
+		// to the ring, so drain it again (to catch anything pushed since the drain above) before taking the spill.
+		if (m_hasSpill.load(std::memory_order_acquire)) {
+			drainRing(output);
+			std::lock_guard<std::mutex> lk(m_overflowMutex);
+			output.append(m_spill);
+			m_spill.fastClear();
+			m_hasSpill.store(false, std::memory_order_release);
+		}
+	}
+
+	RingBufferStats stats() const {
+		RingBufferStats s;
+		s.capacity = capacity();
+		s.highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+		s.dropped = m_dropped.load(std::memory_order_relaxed);
+		s.spilled = m_spilled.load(std::memory_order_relaxed);
+		return s;
+	}
+};
@@ -119,6 +119,17 @@ Array<String> SessionConfig::getUniqueTargetIds() const {
 
 Session::Session(FPSciApp* app, shared_ptr<SessionConfig> config) : m_app(app), m_config(config), m_weapon(app->weapon) {
 	m_hasSession = notNull(m_config);
+	if (m_hasSession) {
+		// Compile the frame time schedule (the below matches the functionality in FPSciApp::updateParameters())
+		const RenderConfig& render = m_config->render;
+		const float defaultFrameTime = render.frameRate > 0 ? 1.0f / render.frameRate : 1.0f / m_app->window()->settings().refreshRate;
+		// Seed the session's random streams (keyed by session id so sessions sharing a seed still draw different values)
+		m_randomSeed = m_config->timing.randomSeed >= 0 ? m_config->timing.randomSeed : FPSciClock::now();
+		m_random = RandomStream((uint64)m_randomSeed).child(m_config->id);
+
+		const uint32 seed = render.frameTimeSeed >= 0 ? (uint32)render.frameTimeSeed : (uint32)m_random.child("frameTimes").bits();
+		m_frameTimeSchedule = FrameTimeSchedule(render.frameTimeArray, render.frameTimeRandomize, frameTimeModeFromString(render.frameTimeMode), defaultFrameTime, seed);
+	}
 }
 
 Session::Session(FPSciApp* app) : m_app(app), m_weapon(app->weapon) {
@@ -134,32 +145,8 @@ bool Session::hasNextCondition() const{
 
 const RealTime Session::targetFrameTime()
 {
-	const RealTime defaultFrameTime = 1.0 / m_app->window()->settings().refreshRate;
-	if (!m_hasSession) return defaultFrameTime;
-
-	uint arraySize = m_config->render.frameTimeArray.size();
-	if (arraySize > 0) {
-		if ((m_config->render.frameTimeMode == "taskonly" || m_config->render.frameTimeMode == "restartwithtask") && currentState != PresentationState::trialTask) {
-			// We are in a frame time mode which specifies only to change frame time during the task
-			return 1.0f / m_config->render.frameRate;
-		}
-
-		if (m_config->render.frameTimeRandomize) {
-			return m_config->render.frameTimeArray.randomElement();
-		}
-		else {
-			RealTime targetTime =  m_config->render.frameTimeArray[m_frameTimeIdx % arraySize];
-			m_frameTimeIdx += 1;
-			m_frameTimeIdx %= arraySize;
-			return targetTime;
-		}
-	}
-
-	// The below matches the functionality in FPSciApp::updateParameters()
-	if (m_config->render.frameRate > 0) {
-		return 1.0f / m_config->render.frameRate;
-	}
-	return defaultFrameTime;
+	if (!m_hasSession) return 1.0 / m_app->window()->settings().refreshRate;
+	return m_frameTimeSchedule.next(currentState == PresentationState::trialTask);
 }
 
 bool Session::nextCondition() {
@@ -170,12 +157,16 @@ bool Session::nextCondition() {
 		}
 	}
 	if (unrunTrialIdxs.size() == 0) return false;
-	int idx = Random::common().integer(0, unrunTrialIdxs.size()-1);
+	int idx = m_random.integer(0, unrunTrialIdxs.size()-1);
 	m_currTrialIdx = unrunTrialIdxs[idx];
 
+	// Each trial (trial id and index) has its own stream, so it can be regenerated from the session seed alone
+	m_trialRandom = m_random.child(m_currTrialIdx).child(m_completedTrials[m_currTrialIdx]);
+	m_weapon->setRandom(m_trialRandom.child("weapon"));
+
 	// Produce (potentially random in range) pretrial duration
 	if (isNaN(m_config->timing.pretrialDurationLambda)) m_pretrialDuration = m_config->timing.pretrialDuration;
-	else m_pretrialDuration = drawTruncatedExp(m_config->timing.pretrialDurationLambda, m_config->timing.pretrialDurationRange[0], m_config->timing.pretrialDurationRange[1]);
+	else m_pretrialDuration = drawTruncatedExp(m_trialRandom, m_config->timing.pretrialDurationLambda, m_config->timing.pretrialDurationRange[0], m_config->timing.pretrialDurationRange[1]);
 	
 	return true;
 }
@@ -190,7 +181,7 @@ bool Session::blockComplete() const{
 
 bool Session::updateBlock(bool init) {
 	for (int i = 0; i < m_trials.size(); i++) {
-		const Array<shared_ptr<TargetConfig>>& targets = m_trials[i];
+		const Array<shared_ptr<const TargetConfig>>& targets = m_trials[i];
 		if (init) { // If this is the first block in the session
 			m_completedTrials.append(0);							// This increments across blocks (unique trial index)
 			m_remainingTrials.append(m_config->trials[i].count);	// This is reset across blocks (tracks progress)
@@ -221,12 +212,12 @@ void Session::onInit(String filename, String description) {
 	if (m_hasSession) {
 		if (m_config->logger.enable) {
 			UserConfig user = *m_app->currentUser();
-			// Setup the logger and create results file
-			logger = FPSciLogger::create(filename + ".db", user.id, 
-				m_app->startupConfig.experimentList[m_app->experimentIdx].experimentConfigFilename, 
-				m_config, description);
+			// Start this session in the results file (reusing the app's open logger where possible)
+			logger = m_app->openResultsLogger(filename + ".db", user.id, m_config, description);
 			logger->logTargetTypes(m_app->experimentConfig.getSessionTargets(m_config->id));			// Log target info at start of session
 			logger->logUserConfig(user, m_config->id, m_config->player.turnScale);						// Log user info at start of session
+			logger->logFrameTimeSchedule(m_config->id, m_frameTimeSchedule);							// Log the frame times for this session
+			logger->logRandomSeed(m_config->id, m_randomSeed);											// Log the seed for this session's random streams
 			m_dbFilename = filename;
 		}
 
@@ -243,17 +234,20 @@ void Session::onInit(String filename, String description) {
 
 void Session::randomizePosition(const shared_ptr<TargetEntity>& target) const {
 	static const Point3 initialSpawnPos = m_camera->frame().translation;
-	shared_ptr<TargetConfig> config = m_targetConfigs[m_currTrialIdx][target->paramIdx()];
+	shared_ptr<const TargetConfig> config = m_targetConfigs[m_currTrialIdx][target->paramIdx()];
 	const bool isWorldSpace = config->destSpace == "world";
+	RandomStream& random = target->spawnRandom();
 	Point3 loc;
 
 	if (isWorldSpace) {
-		loc = config->spawnBounds.randomInteriorPoint();		// Set a random position in the bounds
+		loc = random.interiorPoint(config->spawnBounds);		// Set a random position in the bounds
 		target->resetMotionParams();							// Reset the target motion behavior
 	}
 	else {
-		const float rot_pitch = (config->symmetricEccV ? randSign() : 1) * Random::common().uniform(config->eccV[0], config->eccV[1]);
-		const float rot_yaw = (config->symmetricEccH ? randSign() : 1) * Random::common().uniform(config->eccH[0], config->eccH[1]);
+		const float signV = config->symmetricEccV ? random.sign() : 1.0f;
+		const float rot_pitch = signV * random.uniform(config->eccV[0], config->eccV[1]);
+		const float signH = config->symmetricEccH ? random.sign() : 1.0f;
+		const float rot_yaw = signH * random.uniform(config->eccH[0], config->eccH[1]);
 		const CFrame f = CFrame::fromXYZYPRDegrees(initialSpawnPos.x, initialSpawnPos.y, initialSpawnPos.z, - 180.0f/(float)pi()*initialHeadingRadians - rot_yaw, rot_pitch, 0.0f);
 		loc = f.pointToWorldSpace(Point3(0, 0, -m_targetDistance));
 	}
@@ -314,18 +308,21 @@ void Session::spawnTrialTargets(Point3 initialSpawnPos, bool previewMode) {
 	// Iterate through the targets
 	for (int i = 0; i < m_targetConfigs[m_currTrialIdx].size(); i++) {
 		const Color3 previewColor = m_config->targetView.previewColor;
-		shared_ptr<TargetConfig> target = m_targetConfigs[m_currTrialIdx][i];
+		shared_ptr<const TargetConfig> target = m_targetConfigs[m_currTrialIdx][i];
 		const String name = format("%s_%d_%d_%s_%d", m_config->id, m_currTrialIdx, m_completedTrials[m_currTrialIdx], target->id, i);
 
-		const float spawn_eccV = (target->symmetricEccV ? randSign() : 1) * Random::common().uniform(target->eccV[0], target->eccV[1]);
-		const float spawn_eccH = (target->symmetricEccH ? randSign() : 1) * Random::common().uniform(target->eccH[0], target->eccH[1]);
-		const float targetSize = G3D::Random().common().uniform(target->size[0], target->size[1]);
+		// Each target draws from its own stream (by index in the trial), so it can be regenerated independent of other targets
+		RandomStream targetRandom = m_trialRandom.child(i);
+		const float signV = target->symmetricEccV ? targetRandom.sign() : 1.0f;
+		const float spawn_eccV = signV * targetRandom.uniform(target->eccV[0], target->eccV[1]);
+		const float signH = target->symmetricEccH ? targetRandom.sign() : 1.0f;
+		const float spawn_eccH = signH * targetRandom.uniform(target->eccH[0], target->eccH[1]);
+		const float targetSize = targetRandom.uniform(target->size[0], target->size[1]);
 		bool isWorldSpace = target->destSpace == "world";
 
 		// Log the target if desired
 		if (m_config->logger.enable) {
-			const String spawnTime = FPSciLogger::genUniqueTimestamp();
-			logger->addTarget(name, target, spawnTime, targetSize, Point2(spawn_eccH, spawn_eccV));
+			logger->addTarget(name, target, FPSciClock::now(), targetSize, Point2(spawn_eccH, spawn_eccV));
 		}
 
 		CFrame f = CFrame::fromXYZYPRDegrees(initialSpawnPos.x, initialSpawnPos.y, initialSpawnPos.z, -initialHeadingRadians * 180.0f / pif() - spawn_eccH, spawn_eccV, 0.0f);
@@ -334,16 +331,16 @@ void Session::spawnTrialTargets(Point3 initialSpawnPos, bool previewMode) {
 		shared_ptr<TargetEntity> t;
 		if (target->destinations.size() > 0) {
 			Point3 offset = isWorldSpace ? Point3(0.f, 0.f, 0.f) : f.pointToWorldSpace(Point3(0, 0, -m_targetDistance));
-			t = spawnDestTarget(target, offset, previewColor, i, name);
+			t = spawnDestTarget(target, offset, previewColor, i, targetRandom, name);
 		}
 		// Otherwise check if this is a jumping target
 		else if (target->jumpEnabled) {
-			Point3 offset = isWorldSpace ? target->spawnBounds.randomInteriorPoint() : f.pointToWorldSpace(Point3(0, 0, -m_targetDistance));
-			t = spawnJumpingTarget(target, offset, initialSpawnPos, previewColor, m_targetDistance, i, name);
+			Point3 offset = isWorldSpace ? targetRandom.interiorPoint(target->spawnBounds) : f.pointToWorldSpace(Point3(0, 0, -m_targetDistance));
+			t = spawnJumpingTarget(target, offset, initialSpawnPos, previewColor, m_targetDistance, i, targetRandom, name);
 		}
 		else {
-			Point3 offset = isWorldSpace ? target->spawnBounds.randomInteriorPoint() : f.pointToWorldSpace(Point3(0, 0, -m_targetDistance));
-			t = spawnFlyingTarget(target, offset, initialSpawnPos, previewColor, i, name);
+			Point3 offset = isWorldSpace ? targetRandom.interiorPoint(target->spawnBounds) : f.pointToWorldSpace(Point3(0, 0, -m_targetDistance));
+			t = spawnFlyingTarget(target, offset, initialSpawnPos, previewColor, i, targetRandom, name);
 		}
 
 		if (!previewMode) m_app->updateTargetColor(t);		// If this isn't a preview target update its color now
@@ -421,7 +418,7 @@ void Session::updatePresentationState()
 	{
 		if ((stateElapsedTime > m_config->timing.maxTrialDuration) || (remainingTargets <= 0) || (m_weapon->remainingAmmo() == 0))
 		{
-			m_taskEndTime = FPSciLogger::genUniqueTimestamp();
+			m_taskEndTime = FPSciClock::now();
 			processResponse();
 			clearTargets(); // clear all remaining targets
 			newState = PresentationState::trialFeedback;
@@ -543,10 +540,8 @@ void Session::updatePresentationState()
 	{ // handle state transition.
 		m_timer.startTimer();
 		if (newState == PresentationState::trialTask) {
-			if (m_config->render.frameTimeMode == "restartwithtask") {
-				m_frameTimeIdx = 0;		// Reset the frame time index with the task if requested
-			}
-			m_taskStartTime = FPSciLogger::genUniqueTimestamp();
+			m_frameTimeSchedule.startTask();		// Reset the frame time schedule with the task if requested
+			m_taskStartTime = FPSciClock::now();
 		}
 		currentState = newState;
 		//If we switched to task, call initTargetAnimation to handle new trial
@@ -582,23 +577,32 @@ void Session::onSimulation(RealTime rdt, SimTime sdt, SimTime idt)
 	accumulateFrameInfo(rdt, sdt, idt);
 }
 
+void Session::simulateTargets(SimTime sdt) {
+	m_flyingTargets.onSimulation(sdt);
+
+	// Targets are inserted/removed (and posed) by the scene on this thread, only their (independent) motion updates run on the workers
+	m_app->jobSystem->parallelFor(m_targetArray.size(), targetsPerJob, [this](int begin, int end) {
+		for (int i = begin; i < end; i++) m_targetArray[i]->simulateDeferredMotion();
+	});
+	// The workers only move each target's m_frame, set the new frames (w/ the Entity bookkeeping) here
+	for (const shared_ptr<TargetEntity>& target : m_targetArray) target->commitDeferredMotion();
+}
+
 void Session::recordTrialResponse(int destroyedTargets, int totalTargets)
 {
 	if (!m_config->logger.enable) return;		// Skip this if the logger is disabled
 	if (m_config->logger.logTrialResponse) {
 		// Trials table. Record trial start time, end time, and task completion time.
-		FPSciLogger::TrialValues trialValues = {
-			"'" + m_config->id + "'",
-			String(std::to_string(m_currTrialIdx)),
-			String(std::to_string(m_completedTrials[m_currTrialIdx])),
-			format("'Block %d'", m_currBlock),
-			"'" + m_taskStartTime + "'",
-			"'" + m_taskEndTime + "'",
-			String(std::to_string(m_pretrialDuration)),
-			String(std::to_string(m_taskExecutionTime)),
-			String(std::to_string(destroyedTargets)),
-			String(std::to_string(totalTargets))
-		};
+		TrialValues trialValues;
+		trialValues.trialId = m_currTrialIdx;
+		trialValues.trialIndex = m_completedTrials[m_currTrialIdx];
+		trialValues.block = m_currBlock;
+		trialValues.startTime = m_taskStartTime;
+		trialValues.endTime = m_taskEndTime;
+		trialValues.pretrialDuration = m_pretrialDuration;
+		trialValues.taskExecutionTime = (float)m_taskExecutionTime;
+		trialValues.destroyedTargets = destroyedTargets;
+		trialValues.totalTargets = totalTargets;
 		logger->logTrial(trialValues);
 	}
 }
@@ -610,7 +614,7 @@ void Session::accumulateTrajectories()
 			if (!target->isLogged()) continue;
 			String name = target->name();
 			Point3 pos = target->frame().translation;
-			TargetLocation location = TargetLocation(FPSciLogger::getFileTime(), name, currentState, pos);
+			TargetLocation location = TargetLocation(FPSciClock::now(), name, currentState, pos);
 			if (m_config->logger.logOnChange) {
 				// Check for target in logged position table
 				if (m_lastLogTargetLoc.containsKey(name)  && location.noChangeFrom(m_lastLogTargetLoc[name])) {	
@@ -654,7 +658,7 @@ void Session::accumulatePlayerAction(PlayerActionType action, String targetName)
 		// recording target trajectories
 		Point2 dir = getViewDirection();
 		Point3 loc = getPlayerLocation();
-		PlayerAction pa = PlayerAction(FPSciLogger::getFileTime(), dir, loc, currentState, action, targetName);
+		PlayerAction pa = PlayerAction(FPSciClock::now(), dir, loc, currentState, action, targetName);
 		// Check for log only on change condition
 		if (m_config->logger.logOnChange && pa.noChangeFrom(lastPA)) {
 			return;		// Early exit for (would be) duplicate log entry
@@ -667,10 +671,25 @@ void Session::accumulatePlayerAction(PlayerActionType action, String targetName)
 
 void Session::accumulateFrameInfo(RealTime t, float sdt, float idt) {
 	if (notNull(logger) && m_config->logger.logFrameInfo) {
-		logger->logFrameInfo(FrameInfo(FPSciLogger::getFileTime(), sdt));
+		if (!m_config->logger.logFrameTiming) {
+			logger->logFrameInfo(FrameInfo(FPSciClock::now(), sdt));
+			return;
+		}
+		// Hold the frame info until the frame's timing is known (any earlier simulation step this frame is logged w/o timing)
+		if (m_hasPendingFrameInfo) logger->logFrameInfo(m_pendingFrameInfo);
+		m_pendingFrameInfo = FrameInfo(FPSciClock::now(), sdt);
+		m_hasPendingFrameInfo = true;
 	}
 }
 
+void Session::accumulateFrameTiming(const FrameTiming& timing) {
+	if (!m_hasPendingFrameInfo) return;
+	m_hasPendingFrameInfo = false;
+	if (isNull(logger)) return;
+	m_pendingFrameInfo.timing = timing;
+	logger->logFrameInfo(m_pendingFrameInfo);
+}
+
 bool Session::inTask() {
 	return currentState == PresentationState::trialTask;
 }
@@ -833,24 +852,31 @@ void Session::endLogging() {
 	if (notNull(logger)) {
 
 		//m_logger->logUserConfig(*m_app->currentUser(), m_config->id, m_config->player.turnScale);
-		logger->flush(false);
-		logger.reset();
+		m_app->detachHardwareEventLogger();		// No more hardware events for this session (so they are all in the final flush)
+		if (m_hasPendingFrameInfo) {
+			logger->logFrameInfo(m_pendingFrameInfo);		// The last frame's timing won't be recorded
+			m_hasPendingFrameInfo = false;
+		}
+		logger->endSession();		// Wait for everything logged so far to be committed to the results file
+		logger.reset();				// The app keeps the logger (and results file) open for the next session
 	}
 }
 
 shared_ptr<TargetEntity> Session::spawnDestTarget(
-	shared_ptr<TargetConfig> config,
+	shared_ptr<const TargetConfig> config,
 	const Point3& offset,
 	const Color3& color,
 	const int paramIdx,
+	RandomStream& random,
 	const String& name)
 {
 	// Create the target
-	const float targetSize = G3D::Random().common().uniform(config->size[0], config->size[1]);
+	const float targetSize = random.uniform(config->size[0], config->size[1]);
 	const String nameStr = name.empty() ? format("target%03d", ++m_lastUniqueID) : name;
-	const int scaleIndex = clamp(iRound(log(targetSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+	const int scaleIndex = TargetModels::scaleIndex(targetSize);
 
-	const shared_ptr<TargetEntity>& target = TargetEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id][scaleIndex], offset, scaleIndex, paramIdx);
+	const shared_ptr<TargetEntity>& target = TargetEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id]->model(scaleIndex), offset, scaleIndex, paramIdx);
+	target->setRandom(random);
 
 	// Update parameters for the target
 	target->setHitSound(config->hitSound, m_app->soundTable, config->hitSoundVol);
@@ -870,7 +896,7 @@ shared_ptr<FlyingEntity> Session::spawnReferenceTarget(
 	const float size,
 	const Color3& color)
 {
-	const int scaleIndex = clamp(iRound(log(size) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+	const int scaleIndex = TargetModels::scaleIndex(size);
 
 	String refId = m_config->id + "_reference";
 	if (isNull(m_targetModels->getPointer(refId))) {
@@ -878,7 +904,7 @@ shared_ptr<FlyingEntity> Session::spawnReferenceTarget(
 		refId = "reference";
 	}
 
-	const shared_ptr<FlyingEntity>& target = FlyingEntity::create("reference", m_scene, (*m_targetModels)[refId][scaleIndex], CFrame());
+	const shared_ptr<FlyingEntity>& target = FlyingEntity::create("reference", m_scene, (*m_targetModels)[refId]->model(scaleIndex), CFrame());
 
 	// Setup additional target parameters
 	target->setFrame(position);
@@ -890,25 +916,30 @@ shared_ptr<FlyingEntity> Session::spawnReferenceTarget(
 }
 
 shared_ptr<FlyingEntity> Session::spawnFlyingTarget(
-	shared_ptr<TargetConfig> config,
+	shared_ptr<const TargetConfig> config,
 	const Point3& position,
 	const Point3& orbitCenter,
 	const Color3& color,
 	const int paramIdx,
+	RandomStream& random,
 	const String& name)
 {
-	const float targetSize = G3D::Random().common().uniform(config->size[0], config->size[1]);
-	const int scaleIndex = clamp(iRound(log(targetSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+	const float targetSize = random.uniform(config->size[0], config->size[1]);
+	const int scaleIndex = TargetModels::scaleIndex(targetSize);
 	const String nameStr = name.empty() ? format("target%03d", ++m_lastUniqueID) : name;
 	const bool isWorldSpace = config->destSpace == "world";
 
 	// Setup the target
-	const shared_ptr<FlyingEntity>& target = FlyingEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id][scaleIndex], orbitCenter, scaleIndex, paramIdx);
+	const shared_ptr<FlyingEntity>& target = FlyingEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id]->model(scaleIndex), orbitCenter, scaleIndex, paramIdx);
+	target->setRandom(random);
 	target->setFrame(position);
 	target->setWorldSpace(isWorldSpace);
 	if (isWorldSpace) {
 		target->setBounds(config->moveBounds);
 	}
+	else {
+		m_flyingTargets.add(target.get());
+	}
 	target->setHitSound(config->hitSound, m_app->soundTable,  config->hitSoundVol);
 	target->setDestoyedSound(config->destroyedSound, m_app->soundTable, config->destroyedSoundVol);
 
@@ -921,21 +952,22 @@ shared_ptr<FlyingEntity> Session::spawnFlyingTarget(
 }
 
 shared_ptr<JumpingEntity> Session::spawnJumpingTarget(
-	shared_ptr<TargetConfig> config,
+	shared_ptr<const TargetConfig> config,
 	const Point3& position,
 	const Point3& orbitCenter,
 	const Color3& color,
 	const float targetDistance,
 	const int paramIdx,
+	RandomStream& random,
 	const String& name)
 {
-	const float targetSize = G3D::Random().common().uniform(config->size[0], config->size[1]);
-	const int scaleIndex = clamp(iRound(log(targetSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+	const float targetSize = random.uniform(config->size[0], config->size[1]);
+	const int scaleIndex = TargetModels::scaleIndex(targetSize);
 	const String nameStr = name.empty() ? format("target%03d", ++m_lastUniqueID) : name;
 	const bool isWorldSpace = config->destSpace == "world";
 
 	// Setup the target
-	const shared_ptr<JumpingEntity>& target = JumpingEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id][scaleIndex], scaleIndex, orbitCenter, targetDistance, paramIdx);
+	const shared_ptr<JumpingEntity>& target = JumpingEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id]->model(scaleIndex), scaleIndex, orbitCenter, targetDistance, paramIdx, random);
 	target->setFrame(position);
 	target->setWorldSpace(isWorldSpace);
 	if (isWorldSpace) {
@@ -954,11 +986,15 @@ shared_ptr<JumpingEntity> Session::spawnJumpingTarget(
 
 void Session::insertTarget(shared_ptr<TargetEntity> target) {
 	target->setShouldBeSaved(false);
+	target->setDeferMotion(true);				// Moved by simulateTargets() (in parallel w/ the other targets)
 	m_targetArray.append(target);
 	m_scene->insert(target);
 }
 
 void Session::destroyTarget(shared_ptr<TargetEntity> target) {
+	// Stop moving the target
+	const shared_ptr<FlyingEntity> flyingTarget = dynamic_pointer_cast<FlyingEntity>(target);
+	if (notNull(flyingTarget)) m_flyingTargets.remove(flyingTarget.get());
 	// Remove target from the scene
 	m_scene->removeEntity(target->name());
 	// Remove target from master list
@@ -29,6 +29,11 @@
 
 #include <G3D/G3D.h>
 #include "FpsConfig.h"
+#include "FPSciClock.h"
+#include "FrameTimeSchedule.h"
+#include "FlyingTargetBatch.h"
+#include "RandomStream.h"
+#include "TargetModels.h"
 #include <ctime>
 
 class FPSciApp;
@@ -52,28 +57,44 @@ public:
 	};
 };
 
+/** Per-phase timing of a frame (in ms), from the stopwatches in FPSciApp::oneFrame() */
+struct FrameTiming {
+	float userInputMs = fnan();			///< Time spent processing user input
+	float networkMs = fnan();			///< Time spent in onNetwork()
+	float logicMs = fnan();				///< Time spent in onAI()
+	float simulationMs = fnan();		///< Time spent in simulation
+	float poseMs = fnan();				///< Time spent posing the scene
+	float waitMs = fnan();				///< Time spent waiting to hit the target frame time
+	float graphicsMs = fnan();			///< Time spent rendering
+	float overWaitMs = fnan();			///< Current estimate of how much the wait overshoots by
+	float targetFrameTimeMs = fnan();	///< Target frame time (from Session::targetFrameTime())
+};
+
  struct FrameInfo {
-	FILETIME time;
+	FPSciTimestamp time = 0;
 	//float idt = 0.0f;
 	float sdt = 0.0f;
+	FrameTiming timing;				///< Only logged when logFrameTiming is set (NaN values are written as NULL)
+	uint64 journalSeq = 0;			///< Recovery journal sequence number (set by FPSciLogger when journaled)
 
 	FrameInfo() {};
 
-	FrameInfo(FILETIME t, float simDeltaTime) {
+	FrameInfo(FPSciTimestamp t, float simDeltaTime) {
 		time = t;
 		sdt = simDeltaTime;
 	}
 };
 
 struct TargetLocation {
-	FILETIME time;
+	FPSciTimestamp time = 0;
 	String name = "";
 	PresentationState state;
 	Point3 position = Point3::zero();
+	uint64 journalSeq = 0;			///< Recovery journal sequence number (set by FPSciLogger when journaled)
 
 	TargetLocation() {};
 
-	TargetLocation(FILETIME t, String targetName, PresentationState trialState, Point3 targetPosition) {
+	TargetLocation(FPSciTimestamp t, String targetName, PresentationState trialState, Point3 targetPosition) {
 		time = t;
 		name = targetName;
 		state = trialState;
@@ -95,16 +116,17 @@ enum PlayerActionType{
 };
 
 struct PlayerAction {
-	FILETIME			time;
+	FPSciTimestamp		time = 0;
 	Point2				viewDirection = Point2::zero();
 	Point3				position = Point3::zero();
 	PresentationState	state;
 	PlayerActionType	action = PlayerActionType::None;
 	String				targetName = "";
+	uint64				journalSeq = 0;			///< Recovery journal sequence number (set by FPSciLogger when journaled)
 
 	PlayerAction() {};
 
-	PlayerAction(FILETIME t, Point2 playerViewDirection, Point3 playerPosition, PresentationState trialState, PlayerActionType playerAction, String name) {
+	PlayerAction(FPSciTimestamp t, Point2 playerViewDirection, Point3 playerPosition, PresentationState trialState, PlayerActionType playerAction, String name) {
 		time = t;
 		viewDirection = playerViewDirection;
 		position = playerPosition;
@@ -118,6 +140,72 @@ struct PlayerAction {
 	}
 };
 
+/** Record of a single target spawn (Targets table)
+
+	The Targets, Questions, and Users records are written a few times per trial (at most), so they keep their strings (and
+	the target config is shared rather than copied). Copying these strings when queueing is the only allocation left on the
+	main thread, all number formatting (and unparsing) happens on the logger thread. */
+struct TargetInfo {
+	FPSciTimestamp				spawnTime = 0;
+	String						name = "";
+	shared_ptr<const TargetConfig>	config;					///< Target type (config is shared, not copied)
+	float						size = 0.0f;
+	Point2						spawnEcc = Point2::zero();
+
+	TargetInfo() {};
+
+	TargetInfo(FPSciTimestamp t, const String& targetName, const shared_ptr<const TargetConfig>& targetConfig, float targetSize, Point2 eccentricity) {
+		spawnTime = t;
+		name = targetName;
+		config = targetConfig;
+		size = targetSize;
+		spawnEcc = eccentricity;
+	}
+};
+
+/** Record of a single completed trial (Trials table), the session ID is provided by the logger */
+struct TrialValues {
+	int				trialId = 0;				///< Index of the trial (type) within the session
+	int				trialIndex = 0;				///< Number of times this trial has been completed
+	int				block = 0;					///< Block index (1-based)
+	FPSciTimestamp	startTime = 0;
+	FPSciTimestamp	endTime = 0;
+	float			pretrialDuration = 0.0f;
+	float			taskExecutionTime = 0.0f;
+	int				destroyedTargets = 0;
+	int				totalTargets = 0;
+
+	TrialValues() {};
+};
+
+/** Record of a question and its response (Questions table) */
+struct QuestionResult {
+	FPSciTimestamp	time = 0;
+	String			sessionId = "";
+	Question		question;						///< The question asked (including its result)
+	Array<String>	presentedOptions;				///< Options in the order presented (multiple choice/rating only)
+
+	QuestionResult() {};
+};
+
+/** Record of a user's settings at the start of a session (Users table), only the logged fields of the user config are copied */
+struct UserValues {
+	FPSciTimestamp	time = 0;
+	String			sessionId = "";
+	String			userId = "";
+	double			mouseDPI = 0.0;
+	double			mouseDegPerMm = 0.0;
+	Vector2			turnScale = Vector2(1.0f, 1.0f);
+	bool			invertY = false;
+	int				reticleIndex = 0;
+	float			reticleScale[2] = { 1.0f, 1.0f };		///< Reticle scale (min size, max size)
+	Color4			reticleColor[2];						///< Reticle color (min size color, max size color)
+	float			reticleChangeTimeS = 0.0f;
+	Vector2			sessTurnScale = Vector2(1.0f, 1.0f);
+
+	UserValues() {};
+};
+
 /** Trial count class (optional for alternate TargetConfig/count table lookup) */
 class TrialCount {
 public:
@@ -175,32 +263,39 @@ protected:
 	int m_trialShotsHit = 0;									///< Count of total hits in this trial
 	bool m_hasSession;									///< Flag indicating whether psych helper has loaded a valid session
 	int	m_currBlock = 1;								///< Index to the current block of trials
-	Array<Array<shared_ptr<TargetConfig>>> m_trials;	///< Storage for trials (to repeat over blocks)
+	Array<Array<shared_ptr<const TargetConfig>>> m_trials;	///< Storage for trials (to repeat over blocks)
 	String m_feedbackMessage;							///< Message to show when trial complete
 
 	// Target management
-	Table<String, Array<shared_ptr<ArticulatedModel>>>* m_targetModels;
+	Table<String, shared_ptr<TargetModels>>* m_targetModels;
 	int m_lastUniqueID = 0;									///< Counter for creating unique names for various entities
 	
 	Array<shared_ptr<TargetEntity>> m_targetArray;			///< Array of drawn targets
 	Array<shared_ptr<TargetEntity>> m_hittableTargets;		///< Array of targets that can be hit
 	Array<shared_ptr<TargetEntity>> m_unhittableTargets;	///< Array of targets that can't be hit
+	FlyingTargetBatch m_flyingTargets;						///< Motion state for the player space flying targets
 
 	Table<String, TargetLocation> m_lastLogTargetLoc;		///< Last logged target location (used for logOnChange)
 	Point3 m_lastRefTargetPos;								///< Last reference target location (used for aim invalidation)
-
-	int m_frameTimeIdx = 0;									///< Frame time index
+	FrameInfo m_pendingFrameInfo;							///< Frame info waiting for its frame timing (used for logFrameTiming)
+	bool m_hasPendingFrameInfo = false;						///< Is m_pendingFrameInfo waiting to be logged?
+
+	FrameTimeSchedule m_frameTimeSchedule;					///< Target frame times for this session
+	int64 m_randomSeed = 0;									///< Seed for this session's random streams (see the randomSeed timing setting)
+	RandomStream m_random;									///< Session random stream (trial order)
+	RandomStream m_trialRandom;								///< Current trial's random stream (pretrial duration, targets, weapon spread)
+	static const int targetsPerJob = 32;					///< Targets per job when simulating targets in parallel (see simulateTargets)
 	int m_currTrialIdx;										///< Current trial
 	int m_currQuestionIdx = -1;								///< Current question index
 	Array<int> m_remainingTrials;							///< Completed flags
 	Array<int> m_completedTrials;								///< Count of completed trials
-	Array<Array<shared_ptr<TargetConfig>>> m_targetConfigs;	///< Target configurations by trial
+	Array<Array<shared_ptr<const TargetConfig>>> m_targetConfigs;	///< Target configurations by trial
 
 	// Time-based parameters
 	float m_pretrialDuration;							///< (Possibly) randomized pretrial duration
 	RealTime m_taskExecutionTime;						///< Task completion time for the most recent trial
-	String m_taskStartTime;								///< Recorded task start timestamp							
-	String m_taskEndTime;								///< Recorded task end timestamp
+	FPSciTimestamp m_taskStartTime = 0;				///< Recorded task start timestamp
+	FPSciTimestamp m_taskEndTime = 0;					///< Recorded task end timestamp
 	Timer m_timer;										///< Timer used for timing tasks	
 	// Could move timer above to stopwatch in future
 	//Stopwatch stopwatch;			
@@ -268,7 +363,7 @@ protected:
 	/** Get the total target count for the current trial */
 	int totalTrialTargets() const {
 		int totalTargets = 0;
-		for (shared_ptr<TargetConfig> target : m_targetConfigs[m_currTrialIdx]) {
+		for (shared_ptr<const TargetConfig> target : m_targetConfigs[m_currTrialIdx]) {
 			if (target->respawnCount == -1) {
 				totalTargets = -1;		// Ininite spawn case
 				break;
@@ -281,10 +376,11 @@ protected:
 	}
 
 	shared_ptr<TargetEntity> spawnDestTarget(
-		shared_ptr<TargetConfig> config,
+		shared_ptr<const TargetConfig> config,
 		const Point3& offset,
 		const Color3& color,
 		const int paramIdx,
+		RandomStream& random,
 		const String& name = "");
 
 	shared_ptr<FlyingEntity> spawnReferenceTarget(
@@ -295,26 +391,28 @@ protected:
 	);
 
 	shared_ptr<FlyingEntity> spawnFlyingTarget(
-		shared_ptr<TargetConfig> config,
+		shared_ptr<const TargetConfig> config,
 		const Point3& position,
 		const Point3& orbitCenter,
 		const Color3& color,
 		const int paramIdx,
+		RandomStream& random,
 		const String& name = ""
 	);
 
 	shared_ptr<JumpingEntity> spawnJumpingTarget(
-		shared_ptr<TargetConfig> config,
+		shared_ptr<const TargetConfig> config,
 		const Point3& position,
 		const Point3& orbitCenter,
 		const Color3& color,
 		const float targetDistance,
 		const int paramIdx,
+		RandomStream& random,
 		const String& name = ""
 	);
 
-	inline float drawTruncatedExp(float lambda, float min, float max) {
-		const float p = Random::common().uniform();
+	inline float drawTruncatedExp(RandomStream& random, float lambda, float min, float max) {
+		const float p = random.uniform();
 		const float R = max - min;
 		if (lambda == 0.f) return min + p * R;
 		if (lambda < -88.f) return max;				// This prevents against numerical errors in the expression below
@@ -400,22 +498,17 @@ public:
 
 	void endLogging();
 
-	/** randomly returns either +1 or -1 **/	
-	static float randSign() {
-		if (Random::common().uniform() > 0.5) {
-			return 1;
-		} else {
-			return -1;
-		}
-	}
-	
 	void updatePresentationState();
 	void onInit(String filename, String description);
 	void onSimulation(RealTime rdt, SimTime sdt, SimTime idt);
+	/** Move the player space flying targets, then run the targets' deferred motion updates in parallel (called after the scene is simulated) */
+	void simulateTargets(SimTime sdt);
 	void processResponse();
 	void recordTrialResponse(int destroyedTargets, int totalTargets);
 	void accumulateTrajectories();
 	void accumulateFrameInfo(RealTime rdt, float sdt, float idt);
+	/** Add the timing of the frame just completed to its frame info (when logFrameTiming is set), then log it */
+	void accumulateFrameTiming(const FrameTiming& timing);
 
 	void countDestroy() {
 		m_destroyedTargets++;
@@ -87,6 +87,8 @@ StartupConfig::StartupConfig(const Any& any) {
 		reader.getIfPresent("fullscreen", fullscreen);
 		reader.getIfPresent("windowSize", windowSize);
 		reader.getIfPresent("jsonAnyOutput", jsonAnyOutput);
+		reader.getIfPresent("configCacheDir", configCacheDir);
+		configCacheDir = ConfigFiles::formatDirPath(configCacheDir);
 
 		foundDefault = reader.getIfPresent("defaultExperiment", defaultExperiment);
 		if (!foundDefault) {
@@ -148,6 +150,7 @@ Any StartupConfig::toAny(const bool forceAll) const {
 	if (forceAll || def.fullscreen != fullscreen)									a["fullscreen"] = fullscreen;
 	if (forceAll || def.audioEnable != audioEnable)									a["audioEnable"] = audioEnable;
 	if (forceAll || def.jsonAnyOutput != jsonAnyOutput)									a["jsonAnyOutput"] = jsonAnyOutput;
+	if (forceAll || def.configCacheDir != configCacheDir)							a["configCacheDir"] = configCacheDir;
 	a["defaultExperiment"] = defaultExperiment;
 	a["experimentList"] = experimentList;
 
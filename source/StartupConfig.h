@@ -34,6 +34,7 @@ public:
 	bool	fullscreen = true;									///< Whether the app runs in windowed mode
 	Vector2 windowSize = { 1920, 980 };							///< Window size (when not run in fullscreen)
 	bool	jsonAnyOutput = true;									///< Write all outputs as fully JSON compatible .Any files
+	String	configCacheDir = "configCache/";					///< Directory for the binary cache of parsed experiment/user configs (empty to disable)
 
 	ConfigFiles defaultExperiment = ConfigFiles::defaults();	///< Setup default list
 	Array<ConfigFiles> experimentList;							///< List of configs (for various experiments)
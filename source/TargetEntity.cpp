@@ -43,6 +43,11 @@ TargetConfig::TargetConfig(const Any& any) {
 
 		reader.getIfPresent("destSpace", destSpace);
 		reader.getIfPresent("destinations", destinations);
+		reader.getIfPresent("pathInterpolation", pathInterpolation);
+		PathInterpolation interpolation;
+		if (!pathInterpolationFromString(pathInterpolation, interpolation)) {
+			throw format("Unknown \"pathInterpolation\" value \"%s\" for target \"%s\" (must be \"linear\", \"catmullRom\", or \"hermite\")!", pathInterpolation.c_str(), id.c_str());
+		}
 		reader.getIfPresent("respawnCount", respawnCount);
 		if (destSpace == "world" && destinations.size() == 0) {
 			reader.get("moveBounds", moveBounds, format("A world-space target must either specify destinations or a movement bounding box. See target: \"%s\"", id));
@@ -99,7 +104,10 @@ Any TargetConfig::toAny(const bool forceAll) const {
 	if (forceAll || def.size != size)										a["visualSize"] = size;
 	if (forceAll || def.logTargetTrajectory != logTargetTrajectory)			a["logTargetTrajectory"] = logTargetTrajectory;
 	// Destination-based target
-	if (destinations.size() > 0) 											a["destinations"] = destinations;
+	if (destinations.size() > 0) {
+		a["destinations"] = destinations;
+		if (forceAll || def.pathInterpolation != pathInterpolation)			a["pathInterpolation"] = pathInterpolation;
+	}
 	// Parametric target
 	else {
 		if (forceAll || def.upperHemisphereOnly != upperHemisphereOnly)		a["upperHemisphereOnly"] = upperHemisphereOnly;
@@ -129,10 +137,10 @@ Any TargetConfig::toAny(const bool forceAll) const {
 
 // Find an arbitrary vector perpendicular to and in equal length as inputV.
 // The sampling distribution is uniform along the circular line, the set of possible candidates of a perpendicular vector.,
-Point3 findPerpendicularVector(Point3 inputV) { // Note that the output vector has equal length as the input vector.
+Point3 findPerpendicularVector(Point3 inputV, RandomStream& random) { // Note that the output vector has equal length as the input vector.
 	Point3 perpen;
 	while (true) {
-		Point3 r = Point3::random();
+		Point3 r = random.unitVector();
 		if (r.dot(inputV) > 0.1) { // avoid r being sharply aligned with the position vector
 			// calculate a perpendicular vector
 			perpen = r.cross(inputV.direction()) * inputV.length();
@@ -168,7 +176,7 @@ shared_ptr<TargetEntity> TargetEntity::create(
 }
 
 shared_ptr<TargetEntity> TargetEntity::create(
-	shared_ptr<TargetConfig>		config,
+	shared_ptr<const TargetConfig>		config,
 	const String&					name,
 	Scene*							scene,
 	const shared_ptr<Model>&		model,
@@ -179,7 +187,9 @@ shared_ptr<TargetEntity> TargetEntity::create(
 	const shared_ptr<TargetEntity>& target = createShared<TargetEntity>();
 	target->Entity::init(name, scene, CFrame(config->destinations[0].position), shared_ptr<Entity::Track>(), true, true);
 	target->VisibleEntity::init(model, true, Surface::ExpressiveLightScatteringProperties(), ArticulatedModel::PoseSpline());
-	target->TargetEntity::init(config->destinations, paramIdx, offset, config->respawnCount, scaleIdx, config->logTargetTrajectory);
+	PathInterpolation interpolation = PathInterpolation::Linear;
+	pathInterpolationFromString(config->pathInterpolation, interpolation);
+	target->TargetEntity::init(config->destinations, paramIdx, offset, config->respawnCount, scaleIdx, config->logTargetTrajectory, interpolation);
 	target->m_id = config->id;
 	return target;
 }
@@ -216,49 +226,36 @@ void TargetEntity::drawHealthBar(RenderDevice* rd, const Camera& camera, const F
 
 void TargetEntity::setDestinations(const Array<Destination> destinationArray) {
 	m_destinations = destinationArray;
+	m_path = WaypointPath(destinationArray, m_path.interpolation());
 }
 
 void TargetEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
+	scheduleMotion(absoluteTime, deltaTime);
+
+#ifdef DRAW_BOUNDING_SPHERES
+	// Draw a 1m sphere at this position
+	debugDraw(Sphere(m_frame, BOUNDING_SPHERE_RADIUS), 0.0f, Color4::clear(), Color3::black());
+#endif
+}
+
+void TargetEntity::simulateMotion(SimTime absoluteTime, SimTime deltaTime) {
 	// Check whether we have any destinations yet...
 	if (m_destinations.size() < 2) {
-		setFrame(m_destinations[0].position + m_offset);
+		moveTo(m_destinations[0].position + m_offset);
 		return;
 	}
 
 	if (m_spawnTime == 0) m_spawnTime = absoluteTime;						// Get a spawn time (if we don't have one already)
 	SimTime time = fmod(absoluteTime-m_spawnTime, getPathTime());			// Compute a local time (modulus the path time)
-	
-	int nextDestIdx = (destinationIdx + 1) % m_destinations.size();			// Get the next destination's index
 
-	// Check if its time to move to the next segment
-	while(time < m_destinations[destinationIdx].time || time >= m_destinations[nextDestIdx].time) {
-		destinationIdx = nextDestIdx;										// Increment the desintation index
-		nextDestIdx = (destinationIdx + 1) % m_destinations.size();			// Update next destination index
-	}
-	
-	// Get the current and next destination index
-	Destination currDest = m_destinations[destinationIdx];
-	Destination nextDest = m_destinations[nextDestIdx];
-
-	// Compute the position by interpolating
-	float duration = nextDest.time - currDest.time;			// Get the total time for this "step"
-	float prog = 0.0f;										// Use no progress for the "wrap" case (duration < 0 above)
-	if (duration > 0.0f) {
-		prog = 1 - ((nextDest.time - time) / duration);		// Get the ratio of time in this step completed
-	}
-	
-	Point3 delta = nextDest.position - currDest.position; 	// Get the delta vector to move along
-	setFrame((prog*delta) + currDest.position + m_offset);	// Set the new positions
+	// Evaluate the path at this time (finds the segment w/ a search of the destination times)
+	const Point3 position = m_path.evaluate(time) + m_offset;
 
 	// Set changed time if target moved
-	if (delta != Point3(0.f, 0.f, 0.f)) {
+	if (position != m_frame.translation) {
 		m_lastChangeTime = System::time();
 	}
-
-#ifdef DRAW_BOUNDING_SPHERES
-	// Draw a 1m sphere at this position
-	debugDraw(Sphere(m_frame, BOUNDING_SPHERE_RADIUS), 0.0f, Color4::clear(), Color3::black());
-#endif
+	moveTo(position);
 }
 
 shared_ptr<Entity> FlyingEntity::create(
@@ -301,7 +298,7 @@ shared_ptr<FlyingEntity> FlyingEntity::create(
 }
 
 shared_ptr<FlyingEntity> FlyingEntity::create(
-	shared_ptr<TargetConfig>		config,
+	shared_ptr<const TargetConfig>		config,
 	const String&					name,
 	Scene*							scene,
 	const shared_ptr<Model>&		model,
@@ -357,6 +354,7 @@ void FlyingEntity::init(Vector2 angularSpeedRange, Vector2 motionChangePeriodRan
 }
 
 void FlyingEntity::setDestinations(const Array<Point3>& destinationArray, const Point3 orbitCenter) {
+	if (notNull(m_batch)) m_batch->remove(this);		// Explicit destinations are only supported in onSimulation
 	m_destinationPoints.fastClear();
 	if (destinationArray.size() > 0) {
 		const float distance = (destinationArray[0] - orbitCenter).length();
@@ -395,18 +393,26 @@ void FlyingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 	}
 
 	simulatePose(absoluteTime, deltaTime);
+	scheduleMotion(absoluteTime, deltaTime);
 
+#ifdef DRAW_BOUNDING_SPHERES
+	// Draw a 1m sphere at this position
+	debugDraw(Sphere(m_frame.translation, BOUNDING_SPHERE_RADIUS), 0.0f, Color4::clear(), Color3::black());
+#endif
+}
+
+void FlyingEntity::simulateMotion(SimTime absoluteTime, SimTime deltaTime) {
 	if (m_worldSpace) {
 		Point3 pos = m_frame.translation;
 		// Handle world-space target here
 		// Check for change in direction
 		if (absoluteTime > m_nextChangeTime) {
 			// Update the next change time
-			float motionChangeTime = Random::common().uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
+			float motionChangeTime = m_random.uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
 			m_nextChangeTime = absoluteTime + motionChangeTime;
 			// Velocity to use for this next interval
-			float vel = Random::common().uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
-			Point3 destination = m_bounds.randomInteriorPoint();
+			float vel = m_random.uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
+			Point3 destination = m_random.interiorPoint(m_bounds);
 			if (m_axisLocks[0]) {
 				destination.x = pos.x;
 			}
@@ -445,20 +451,20 @@ void FlyingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 
 		// Update the position and set the frame
 		pos += m_velocity*deltaTime;		
-		setFrame(pos);
+		moveTo(pos);
 
 		// Set changed time if it moved
 		if (m_velocity != Vector3(0.f, 0.f, 0.f)) {
 			m_lastChangeTime = System::time();
 		}
 	}
-	else {
-		// Handle non-world space (player projection here)
+	else if (isNull(m_batch)) {
+		// Handle non-world space (player projection here), batched targets are moved by FlyingTargetBatch::onSimulation
 		while ((deltaTime > 0.000001f) && m_angularSpeedRange[0] > 0.0f) {
 			if (m_destinationPoints.empty()) {
 				// Add destimation points if no destination points.
-				float motionChangePeriod = Random::common().uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
-				float angularSpeed = Random::common().uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
+				float motionChangePeriod = m_random.uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
+				float angularSpeed = m_random.uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
 				float angularDistance = motionChangePeriod * angularSpeed;
 				angularDistance = angularDistance > 170.f ? 170.0f : angularDistance; // replace with 170 deg if larger than 170.
 
@@ -469,7 +475,7 @@ void FlyingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 				// relative position to orbit center
 				Point3 relPos = m_frame.translation - m_orbitCenter;
 				// find a vector perpendicular to the current position
-				Point3 perpen = findPerpendicularVector(relPos);
+				Point3 perpen = findPerpendicularVector(relPos, m_random);
 				// calculate destination point
 				Point3 dest = m_orbitCenter + rotateToward(relPos, perpen, angularDistance);
 				// add destination point.
@@ -518,7 +524,7 @@ void FlyingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 				const Vector3& U = currentVector;
 				const Vector3& V = (destinationVector - currentVector * projection).direction();
 
-				setFrame(m_orbitCenter + (cos(angleChange) * U + sin(angleChange) * V) * radius);
+				moveTo(m_orbitCenter + (cos(angleChange) * U + sin(angleChange) * V) * radius);
 
 				// Set changed time if it moved
 				if (angleChange != 0.f) {
@@ -540,10 +546,6 @@ void FlyingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 			}
 		}
 	}
-#ifdef DRAW_BOUNDING_SPHERES
-	// Draw a 1m sphere at this position
-	debugDraw(Sphere(m_frame.translation, BOUNDING_SPHERE_RADIUS), 0.0f, Color4::clear(), Color3::black());
-#endif
 }
 
 
@@ -569,17 +571,19 @@ shared_ptr<Entity> JumpingEntity::create(
 }
 
 shared_ptr<JumpingEntity> JumpingEntity::create(
-	shared_ptr<TargetConfig>		config,
+	shared_ptr<const TargetConfig>		config,
 	const String&					name,
 	Scene*							scene,
 	const shared_ptr<Model>&		model,
 	int								scaleIdx,
 	const Point3&					orbitCenter,
 	float							targetDistance,
-	int								paramIdx)
+	int								paramIdx,
+	const RandomStream&				random)
 {
 	// Don't initialize in the constructor, where it is unsafe to throw Any parse exceptions
 	const shared_ptr<JumpingEntity>& jumpingEntity = createShared<JumpingEntity>();
+	jumpingEntity->setRandom(random);		// Set before init (which draws the initial motion)
 
 	// Initialize each base class, which parses its own fields
 	jumpingEntity->Entity::init(name, scene, CFrame(), shared_ptr<Entity::Track>(), true, true);
@@ -644,9 +648,9 @@ void JumpingEntity::init(
 		m_axisLocks[i] = axisLock[i];
 	}
 	m_orbitRadius = orbitRadius;
-	float angularSpeed = Random::common().uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
+	float angularSpeed = m_random.uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
 	m_planarSpeedGoal = m_orbitRadius * (angularSpeed * pif() / 180.0f);
-	if (Random::common().uniform() > 0.5f) {
+	if (m_random.uniform() > 0.5f) {
 		m_planarSpeedGoal = -m_planarSpeedGoal;
 	}
 	// [m/s] = [m/radians] * [radians/s]
@@ -654,8 +658,8 @@ void JumpingEntity::init(
 	m_speed.y = 0.0f;
 
 	m_inJump = false;
-	m_motionChangeTimer = Random::common().uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
-	m_jumpTimer = Random::common().uniform(m_jumpPeriodRange[0], m_jumpPeriodRange[1]);
+	m_motionChangeTimer = m_random.uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
+	m_jumpTimer = m_random.uniform(m_jumpPeriodRange[0], m_jumpPeriodRange[1]);
 }
 
 Any JumpingEntity::toAny(const bool forceAll) const {
@@ -672,13 +676,21 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 	}
 
 	simulatePose(absoluteTime, deltaTime);
+	scheduleMotion(absoluteTime, deltaTime);
 
+#ifdef DRAW_BOUNDING_SPHERES
+	// Draw a 1m sphere at this position
+	debugDraw(Sphere(m_frame.translation, BOUNDING_SPHERE_RADIUS), 0.0f, Color4::clear(), Color3::black());
+#endif
+}
+
+void JumpingEntity::simulateMotion(SimTime absoluteTime, SimTime deltaTime) {
 	if (m_isFirstFrame) {
 		m_simulatedPos = m_frame.translation;
 		m_standingHeight = m_frame.translation.y;
 		m_isFirstFrame = false;
-		m_acc.y = -Random::common().uniform(m_gravityRange[0], m_gravityRange[1]);
-		m_jumpSpeed = Random::common().uniform(m_jumpSpeedRange[0], m_jumpSpeedRange[1]);
+		m_acc.y = -m_random.uniform(m_gravityRange[0], m_gravityRange[1]);
+		m_jumpSpeed = m_random.uniform(m_jumpSpeedRange[0], m_jumpSpeedRange[1]);
 	}
 
 	if (m_worldSpace) {
@@ -687,11 +699,11 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 		// Check for time for motion (direction) change
 		if (absoluteTime > m_nextChangeTime) {
 			// Update the next change time
-			float motionChangeTime = Random::common().uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
+			float motionChangeTime = m_random.uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
 			m_nextChangeTime = absoluteTime + motionChangeTime;
 			// Velocity to use for this next interval
-			float vel = Random::common().uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
-			Point3 destination = m_moveBounds.randomInteriorPoint();
+			float vel = m_random.uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
+			Point3 destination = m_random.interiorPoint(m_moveBounds);
 			if (m_axisLocks[0]) {
 				destination.x = frame().translation.x;
 			}
@@ -739,7 +751,7 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 				m_jumpTime = 0;
 				pos.y = m_standingHeight;		// Reset to the original height
 				// Schedule the next jump here
-				float nextJump = Random::common().uniform(m_jumpPeriodRange[0], m_jumpPeriodRange[1]);
+				float nextJump = m_random.uniform(m_jumpPeriodRange[0], m_jumpPeriodRange[1]);
 				m_nextJumpTime = absoluteTime + nextJump;
 			}
 			else {
@@ -749,7 +761,7 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 		}
 
 		// Update the position
-		setFrame(pos);
+		moveTo(pos);
 
 		// Set changed time if it moved
 		if (m_velocity != Vector3(0.f, 0.f, 0.f) || m_inJump) {
@@ -823,7 +835,7 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 
 			/// Update motion state (includes updating acceleration)
 			if (t == m_motionChangeTimer) { // changing motion direction
-				float new_AngularSpeedGoal = Random::common().uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
+				float new_AngularSpeedGoal = m_random.uniform(m_angularSpeedRange[0], m_angularSpeedRange[1]);
 				float new_planarSpeedGoal = m_orbitRadius * (new_AngularSpeedGoal * pif() / 180.0f);
 				// change direction
 				if (m_planarSpeedGoal > 0) {
@@ -837,7 +849,7 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 				else { // if not in jump, immediately apply direction change
 					m_speed.x = m_planarSpeedGoal;
 				}
-				m_motionChangeTimer = Random::common().uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
+				m_motionChangeTimer = m_random.uniform(m_motionChangePeriodRange[0], m_motionChangePeriodRange[1]);
 			}
 			if (t == nextJumpStateChange) { // either starting or finishing jump
 				if (m_inJump) { // finishing jump
@@ -845,13 +857,13 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 					m_acc.y = 0; // remove gravity effect
 					m_speed.x = m_planarSpeedGoal; // instantly gain the running speed. (general behavior in games)
 					m_inJump = false;
-					m_jumpTimer = Random::common().uniform(m_jumpPeriodRange[0], m_jumpPeriodRange[1]);
+					m_jumpTimer = m_random.uniform(m_jumpPeriodRange[0], m_jumpPeriodRange[1]);
 				}
 				else { // starting jump
 					m_acc.x = sign(m_planarSpeedGoal) * m_planarAcc;
-					float gravity = -Random::common().uniform(m_gravityRange[0], m_gravityRange[1]);
-					float jumpSpeed = Random::common().uniform(m_jumpSpeedRange[0], m_jumpSpeedRange[1]);
-					float distance = Random::common().uniform(m_distanceRange[0], m_distanceRange[1]);
+					float gravity = -m_random.uniform(m_gravityRange[0], m_gravityRange[1]);
+					float jumpSpeed = m_random.uniform(m_jumpSpeedRange[0], m_jumpSpeedRange[1]);
+					float distance = m_random.uniform(m_distanceRange[0], m_distanceRange[1]);
 					m_acc.y = gravity * m_orbitRadius / distance;
 					m_speed.y = jumpSpeed * m_orbitRadius / distance;
 					m_planarAcc = m_acc.y / 3.f;
@@ -865,9 +877,5 @@ void JumpingEntity::onSimulation(SimTime absoluteTime, SimTime deltaTime) {
 			m_motionChangeTimer -= t;
 		}
 	}
-#ifdef DRAW_BOUNDING_SPHERES
-	// Draw a 1m sphere at this position
-	debugDraw(Sphere(m_frame.translation, BOUNDING_SPHERE_RADIUS), 0.0f, Color4::clear(), Color3::black());
-#endif
 }
 
@@ -1,49 +1,9 @@
 #pragma once
 #include <G3D/G3D.h>
 #include "FPSciAnyTableReader.h"
-
-struct Destination {
-public:
-	Point3 position = Point3(0, 0, 0);
-	SimTime time = 0.0;
-
-	Destination() {
-		position = Point3(0, 0, 0);
-		time = 0.0;
-	}
-
-	Destination(Point3 pos, SimTime t) {
-		position = pos;
-		time = t;
-	}
-
-	Destination(const Any& any) {
-		int settingsVersion = 1;
-		FPSciAnyTableReader reader(any);
-		reader.getIfPresent("settingsVersion", settingsVersion);
-
-		switch (settingsVersion) {
-		case 1:
-			reader.get("t", time);
-			reader.get("xyz", position);
-			break;
-		default:
-			debugPrintf("Settings version '%d' not recognized in Destination configuration");
-			break;
-		}
-	}
-
-	Any toAny(const bool forceAll = true) const {
-		Any a(Any::TABLE);
-		a["t"] = time;
-		a["xyz"] = position;
-		return a;
-	}
-
-	size_t hash(void) {
-		return HashTrait<Point3>::hashCode(position) ^ (int)time;
-	}
-};
+#include "FlyingTargetBatch.h"
+#include "WaypointPath.h"
+#include "RandomStream.h"
 
 /** Class for representing a given target configuration */
 class TargetConfig : public ReferenceCountedObject {
@@ -65,6 +25,7 @@ public:
 	Array<float>	jumpSpeed = { 2.0f, 5.5f };				///< Range of jump speeds in meters/s
 	Array<float>	accelGravity = { 9.8f, 9.8f };			///< Range of acceleration due to gravity in meters/s^2
 	Array<Destination> destinations;						///< Array of destinations to traverse
+	String			pathInterpolation = "linear";			///< Interpolation between destinations ("linear", "catmullRom", or "hermite")
 	String			destSpace = "world";					///< Space to use for destinations (implies offset) can be "world" or "player"
 	int				respawnCount = 0;						///< Number of times to respawn
 	AABox			spawnBounds;							///< Spawn position bounding box
@@ -116,12 +77,16 @@ public:
 // Number of target model sizes
 #define TARGET_MODEL_SCALE_COUNT 50
 
+/** Find an arbitrary vector perpendicular to (and of equal length as) inputV */
+Point3 findPerpendicularVector(Point3 inputV, RandomStream& random);
+/** Rotate inputV toward destinationV by ang_deg degrees */
+Point3 rotateToward(Point3 inputV, Point3 destinationV, float ang_deg);
+
 class TargetEntity : public VisibleEntity {
 protected:
 	String	m_id;									///< Target ID
 	float	m_health			= 1.0f;				///< Target health
 	Color3	m_color				= Color3::red();	///< Default color
-	int		destinationIdx		= 0;				///< Current index into the destination array
 	SimTime m_spawnTime			= 0;				///< Time initiatlly spawned
 	int		m_respawnCount		= 0;				///< Number of times to respawn
 	int		m_paramIdx			= -1;				///< Parameter index of this item
@@ -131,15 +96,49 @@ protected:
 	Point3	m_offset;								///< Offset for initial spawn
 	bool	m_canHit			= true;				///< Can this target be hit?	
 	Array<Destination> m_destinations;				///< Array of destinations to visit
+	WaypointPath m_path;							///< Path through m_destinations (evaluated in onSimulation)
 	shared_ptr<Sound> m_hitSound;					///< Sound to play when hit
 	float m_hitSoundVol;							///< Volume to play hit sound at
 	shared_ptr<Sound> m_destroyedSound;				///< Sound to play when destroyed
 	float m_destroyedSoundVol;						///< Volume to play destroyed sound at
+	RandomStream m_random;							///< Random stream for this target's motion
+	RandomStream m_spawnRandom;						///< Random stream for this target's respawn positions
+
+	bool	m_deferMotion		= false;			///< Run the motion update in simulateDeferredMotion() (rather than onSimulation)?
+	bool	m_motionPending		= false;			///< Has onSimulation deferred a motion update?
+	SimTime m_pendingAbsoluteTime = 0;				///< Times of the deferred motion update
+	SimTime m_pendingDeltaTime	= 0;
+	bool	m_framePending		= false;			///< Has a deferred motion update moved m_frame w/o calling setFrame()?
 
 	// Only used for flying/jumping entities
 	SimTime m_nextChangeTime = 0;
 	Vector3 m_velocity = Vector3::zero();
 
+	/** Move the target (called from onSimulation, or simulateDeferredMotion when deferred), must only change this target's state */
+	virtual void simulateMotion(SimTime absoluteTime, SimTime deltaTime);
+
+	/** Move the target (from simulateMotion). Deferred updates run on worker threads, so they only write this target's m_frame and
+		leave setFrame() (and the Entity bookkeeping it does) to commitDeferredMotion(), called on the main thread. */
+	void moveTo(const CFrame& frame) {
+		if (!m_deferMotion) {
+			setFrame(frame);
+			return;
+		}
+		m_frame = frame;
+		m_framePending = true;
+	}
+
+	/** Run simulateMotion() now, or save the times for simulateDeferredMotion() */
+	void scheduleMotion(SimTime absoluteTime, SimTime deltaTime) {
+		if (!m_deferMotion) {
+			simulateMotion(absoluteTime, deltaTime);
+			return;
+		}
+		m_pendingAbsoluteTime = absoluteTime;
+		m_pendingDeltaTime = deltaTime;
+		m_motionPending = true;
+	}
+
 public:
 	TargetEntity() {}
 
@@ -154,7 +153,7 @@ public:
 	);
 
 	static shared_ptr<TargetEntity> create(
-		shared_ptr<TargetConfig>		config,
+		shared_ptr<const TargetConfig>	config,
 		const String&					name,
 		Scene*							scene,
 		const shared_ptr<Model>&		model,
@@ -163,14 +162,15 @@ public:
 		int								paramIdx
 	);
 
-	void init(Array<Destination> dests, int paramIdx, Point3 staticOffset = Point3(0.0, 0.0, 0.0), int respawnCount = 0, int scaleIdx = 0, bool isLogged = true) {
+	void init(Array<Destination> dests, int paramIdx, Point3 staticOffset = Point3(0.0, 0.0, 0.0), int respawnCount = 0, int scaleIdx = 0, bool isLogged = true,
+		PathInterpolation interpolation = PathInterpolation::Linear) {
 		m_offset = staticOffset;
 		m_respawnCount = respawnCount;
 		m_paramIdx = paramIdx;
 		m_scaleIdx = scaleIdx;
 		m_isLogged = isLogged;
 		m_destinations = dests;
-		destinationIdx = 0;
+		m_path = WaypointPath(dests, interpolation);
 	}
 
 	void setColor(const Color3& color, const Color4& gloss = Color4()) {
@@ -184,6 +184,29 @@ public:
 		setPose(amPose);
 	}
 
+	/** Set the target's random stream (motion and respawn positions are drawn from separate children of it) */
+	void setRandom(const RandomStream& random) {
+		m_random = random.child("motion");
+		m_spawnRandom = random.child("spawn");
+	}
+	RandomStream& spawnRandom() { return m_spawnRandom; }
+
+	/** Defer this target's motion update from onSimulation (called by the scene) to simulateDeferredMotion(), which the session
+		runs for all of its targets in parallel (see Session::simulateTargets) */
+	void setDeferMotion(bool defer) { m_deferMotion = defer; }
+	/** Run the motion update deferred by the last onSimulation call (if any), safe to call for different targets in parallel */
+	void simulateDeferredMotion() {
+		if (!m_motionPending) return;
+		m_motionPending = false;
+		simulateMotion(m_pendingAbsoluteTime, m_pendingDeltaTime);
+	}
+	/** Set the frame moved to by simulateDeferredMotion() (if any) through setFrame(), must be called on the main thread */
+	void commitDeferredMotion() {
+		if (!m_framePending) return;
+		m_framePending = false;
+		setFrame(m_frame);
+	}
+
 	void setWorldSpace(bool worldSpace) { m_worldSpace = worldSpace; }
 	void setCanHit(bool active) { m_canHit = active; }
 
@@ -302,7 +325,13 @@ protected:
 	AABox			m_bounds = AABox();							///< Bounds (for world space motion)
 	bool			m_axisLocks[3] = { false };					///< Axis locks (for world space motion)
 
+	FlyingTargetBatch* m_batch = nullptr;						///< Batch moving this (player space) target, if any (see FlyingTargetBatch)
+	int				m_batchSlot = -1;							///< Slot index of this target in m_batch
+
+	friend class FlyingTargetBatch;
+
 	FlyingEntity() {}
+	virtual void simulateMotion(SimTime absoluteTime, SimTime deltaTime) override;
     void init(AnyTableReader& propertyTable);
 
 	void init();
@@ -310,12 +339,20 @@ protected:
 	void init(Vector2 angularSpeedRange, Vector2 motionChangePeriodRange, bool upperHemisphereOnly, Point3 orbitCenter, int paramIdx, Array<bool> axisLock, int respawns = 0, int scaleIdx=0, bool isLogged=true);
 
 public:
+	~FlyingEntity() {
+		if (notNull(m_batch)) m_batch->remove(this);
+	}
+
 	bool tryRespawn() {
 		m_destinationPoints.fastClear();				// clear all destination points
+		if (notNull(m_batch)) m_batch->clearDestination(m_batchSlot);
 		return TargetEntity::tryRespawn();
 	}
 
-    /** Destinations must be no more than 170 degrees apart to avoid ambiguity in movement direction */
+	/** Is this target moved by a FlyingTargetBatch (rather than in onSimulation)? */
+	bool isBatched() const { return notNull(m_batch); }
+
+    /** Destinations must be no more than 170 degrees apart to avoid ambiguity in movement direction (removes the target from its batch) */
     void setDestinations(const Array<Point3>& destinationArray, const Point3 orbitCenter);
 
 	void setBounds(AABox bounds) { m_bounds = bounds; }
@@ -344,7 +381,7 @@ public:
 	);
 
 	static shared_ptr<FlyingEntity> create(
-		shared_ptr<TargetConfig>		config,
+		shared_ptr<const TargetConfig>	config,
 		const String&					name,
 		Scene*							scene,
 		const shared_ptr<Model>&		model,
@@ -407,6 +444,7 @@ protected:
 
 
 	JumpingEntity() {}
+	virtual void simulateMotion(SimTime absoluteTime, SimTime deltaTime) override;
 
 	void init(AnyTableReader& propertyTable);
 	void init();
@@ -445,14 +483,15 @@ public:
 
 	/** For programmatic construction at runtime */
 	static shared_ptr<JumpingEntity> create(
-		shared_ptr<TargetConfig>		config,
+		shared_ptr<const TargetConfig>	config,
 		const String&					name,
 		Scene*							scene,
 		const shared_ptr<Model>&		model,
 		int								scaleIdx,
 		const Point3&					orbitCenter,
 		float							targetDistance,
-		int								paramIdx
+		int								paramIdx,
+		const RandomStream&				random
 	);
 
 	/** Converts the current VisibleEntity to an Any.  Subclasses should
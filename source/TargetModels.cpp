@@ -0,0 +1,73 @@
+#include "TargetModels.h"
+#include "TargetEntity.h"
+
+TargetModels::TargetModels(const String& id, const TargetModelSpec& spec) : m_modelSpec(spec.modelSpec), m_explosionScale(spec.explosionScale) {
+	m_explosionSpec = Any::parse(format(
+		"ArticulatedModel::Specification {\
+			filename = \"ifs/square.ifs\";\
+			preprocess = {\
+				transformGeometry(all(), Matrix4::scale(0.1, 0.1, 0.1));\
+				setMaterial(all(), UniversalMaterial::Specification{\
+					lambertian = Texture::Specification {\
+						filename = \"%s\";\
+						encoding = Color3(1, 1, 1);\
+					};\
+				});\
+			};\
+		}", spec.explosionDecal.c_str()));
+
+	// Get the bounding box to scale to size rather than arbitrary factor
+	shared_ptr<ArticulatedModel> sizeModel = ArticulatedModel::create(ArticulatedModel::Specification(m_modelSpec));
+	AABox bbox;
+	sizeModel->getBoundingBox(bbox);
+	const Vector3 extent = bbox.extent();
+	logPrintf("%20s bounding box: [%2.2f, %2.2f, %2.2f]\n", id.c_str(), extent[0], extent[1], extent[2]);
+
+	m_defaultScale = 1.0f / extent[0];							// Setup scale so that default model is 1m across
+
+	m_models.resize(TARGET_MODEL_SCALE_COUNT + 1);
+	m_explosionModels.resize(TARGET_MODEL_SCALE_COUNT + 1);
+}
+
+float TargetModels::scale(int scaleIdx) {
+	return pow(1.0f + TARGET_MODEL_ARRAY_SCALING, float(scaleIdx) - TARGET_MODEL_ARRAY_OFFSET);
+}
+
+int TargetModels::scaleIndex(float size) {
+	return clamp(iRound(log(size) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+}
+
+const shared_ptr<ArticulatedModel>& TargetModels::model(int scaleIdx) {
+	shared_ptr<ArticulatedModel>& model = m_models[scaleIdx];
+	if (isNull(model)) {
+		Any spec = m_modelSpec;
+		spec.set("scale", scale(scaleIdx) * m_defaultScale);
+		model = ArticulatedModel::create(spec);
+	}
+	return model;
+}
+
+const shared_ptr<ArticulatedModel>& TargetModels::explosionModel(int scaleIdx) {
+	shared_ptr<ArticulatedModel>& model = m_explosionModels[scaleIdx];
+	if (isNull(model)) {
+		Any spec = m_explosionSpec;
+		spec.set("scale", 20.0 * scale(scaleIdx) * m_explosionScale);
+		model = ArticulatedModel::create(spec);
+	}
+	return model;
+}
+
+void TargetModels::preload(float minSize, float maxSize) {
+	for (int i = scaleIndex(minSize); i <= scaleIndex(maxSize); i++) {
+		model(i);
+		explosionModel(i);
+	}
+}
+
+int TargetModels::loadedCount() const {
+	int count = 0;
+	for (const shared_ptr<ArticulatedModel>& model : m_models) {
+		if (notNull(model)) count++;
+	}
+	return count;
+}
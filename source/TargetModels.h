@@ -0,0 +1,52 @@
+#pragma once
+#include <G3D/G3D.h>
+
+/** The specification a target's (scaled) models are built from, used to only rebuild models whose specification changed */
+struct TargetModelSpec {
+	Any		modelSpec;				///< Target model specification
+	String	explosionDecal;			///< Explosion decal filename
+	float	explosionScale = 1.0f;	///< Explosion decal scale
+
+	bool operator==(const TargetModelSpec& other) const {
+		return modelSpec == other.modelSpec && explosionDecal == other.explosionDecal && explosionScale == other.explosionScale;
+	}
+};
+
+/** The target and explosion models for a target type at each model scale (see TargetEntity::size()).
+
+	Targets can't be scaled through their (rigid) frame, so each scale is a separate model. Rather than creating the models for
+	all TARGET_MODEL_SCALE_COUNT+1 scales up front, the models for a scale are created the first time it is used (or preloaded
+	for the scales a target's size range can use, see preload()). */
+class TargetModels : public ReferenceCountedObject {
+protected:
+	Any		m_modelSpec;										///< Target model specification (w/o scale)
+	Any		m_explosionSpec;									///< Explosion model specification (w/o scale)
+	float	m_defaultScale = 1.0f;								///< Model scale that makes the (unscaled) target 1m across
+	float	m_explosionScale = 1.0f;							///< Explosion decal scale (relative to the target)
+
+	Array<shared_ptr<ArticulatedModel>>	m_models;				///< Target models by scale index (null until created)
+	Array<shared_ptr<ArticulatedModel>>	m_explosionModels;		///< Explosion models by scale index (null until created)
+
+	TargetModels(const String& id, const TargetModelSpec& spec);
+
+	/** Model scale (relative to the target's default size) for a scale index */
+	static float scale(int scaleIdx);
+
+public:
+	static shared_ptr<TargetModels> create(const String& id, const TargetModelSpec& spec) {
+		return createShared<TargetModels>(id, spec);
+	}
+
+	/** Scale index for a target size (clamped to the model scales) */
+	static int scaleIndex(float size);
+
+	/** Get the target model for a scale index (creating it if needed) */
+	const shared_ptr<ArticulatedModel>& model(int scaleIdx);
+	/** Get the explosion model for a scale index (creating it if needed) */
+	const shared_ptr<ArticulatedModel>& explosionModel(int scaleIdx);
+
+	/** Create the models for the scales used by sizes in [minSize, maxSize], so they aren't created while a trial runs */
+	void preload(float minSize, float maxSize);
+	/** Number of scales whose target model has been created */
+	int loadedCount() const;
+};
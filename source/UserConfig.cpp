@@ -1,5 +1,6 @@
 #include "UserConfig.h"
 #include "FPSciAnyTableReader.h"
+#include "ConfigCache.h"
 
 template <class T>
 static bool operator!=(Array<T> a1, Array<T> a2) {
@@ -124,7 +125,7 @@ UserTable UserTable::load(const String& filename, bool saveJSON) {
 		defTable.save(filename, saveJSON);				// Save the .any file
 		return defTable;
 	}
-	return Any::fromFile(System::findDataFile(filename));
+	return ConfigCache::loadConfig<UserTable>(System::findDataFile(filename));
 }
 
 Any UserTable::toAny(const bool forceAll) const {
@@ -1,5 +1,6 @@
 #include "UserStatus.h"
 #include "FPSciAnyTableReader.h"
+#include "ConfigCache.h"
 
 UserSessionStatus::UserSessionStatus(const Any& any) {
 	FPSciAnyTableReader reader(any);
@@ -44,7 +45,7 @@ UserStatusTable UserStatusTable::load(const String& filename, bool saveJSON) {
 		status.currentUser = user.id;							// Set "default" user as current user
 		status.save(filename, saveJSON);						// Save .any file
 	}
-	else status = Any::fromFile(filename);
+	else status = ConfigCache::loadConfig<UserStatusTable>(filename);
 
 	// Populate completed session log name if missing (use user status filename as base)
 	if (status.completedLogFilename.empty()) {
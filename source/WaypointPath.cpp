@@ -0,0 +1,92 @@
+#include "WaypointPath.h"
+
+/** Centripetal Catmull-Rom knot spacing (square root of the distance), kept positive for repeated points */
+static float knotInterval(const Point3& a, const Point3& b) {
+	return max(sqrtf((b - a).length()), 1e-4f);
+}
+
+WaypointPath::WaypointPath(const Array<Destination>& destinations, PathInterpolation interpolation) : m_interpolation(interpolation) {
+	const int n = destinations.size();
+	m_times.resize(n);
+	m_positions.resize(n);
+	for (int i = 0; i < n; i++) {
+		m_times[i] = destinations[i].time;
+		m_positions[i] = destinations[i].position;
+	}
+
+	if (m_interpolation != PathInterpolation::Hermite || n < 2) return;
+
+	// Velocity at each destination from its neighbors (one-sided at the ends), zero next to stationary segments so pauses hold still
+	m_velocities.resize(n);
+	for (int i = 0; i < n; i++) {
+		const int prev = max(i - 1, 0);
+		const int next = min(i + 1, n - 1);
+		const SimTime dt = m_times[next] - m_times[prev];
+		const bool stationary = (i > 0 && m_positions[i - 1] == m_positions[i]) || (i < n - 1 && m_positions[i + 1] == m_positions[i]);
+		m_velocities[i] = (dt > 0.0 && !stationary) ? (m_positions[next] - m_positions[prev]) / (float)dt : Vector3::zero();
+	}
+}
+
+int WaypointPath::findSegment(SimTime time) {
+	const int n = m_times.size();
+	if (n == 0 || time < m_times[0]) return -1;
+	if (time >= m_times[n - 1]) return n - 1;
+
+	// Check the last segment and the one after it (sequential evaluation) before searching
+	for (int s = m_segment; s < min(m_segment + 2, n - 1); s++) {
+		if (time >= m_times[s] && time < m_times[s + 1]) {
+			m_segment = s;
+			return s;
+		}
+	}
+
+	// Last destination w/ a time <= time
+	m_segment = (int)(std::upper_bound(m_times.begin(), m_times.end(), time) - m_times.begin()) - 1;
+	return m_segment;
+}
+
+Point3 WaypointPath::evaluate(SimTime time) {
+	const int segment = findSegment(time);
+	if (segment < 0 || segment >= size() - 1) return size() > 0 ? m_positions.last() : Point3::zero();
+
+	const float u = (float)((time - m_times[segment]) / (m_times[segment + 1] - m_times[segment]));
+	switch (m_interpolation) {
+	case PathInterpolation::CatmullRom: return catmullRom(segment, u);
+	case PathInterpolation::Hermite: return hermite(segment, u);
+	default: return m_positions[segment] + u * (m_positions[segment + 1] - m_positions[segment]);
+	}
+}
+
+Point3 WaypointPath::catmullRom(int segment, float u) const {
+	const Point3& p1 = m_positions[segment];
+	const Point3& p2 = m_positions[segment + 1];
+	if (p1 == p2) return p1;		// Hold position (don't overshoot) for stationary segments
+
+	// Reflect the end points to get neighbors for the first/last segments
+	const Point3 p0 = (segment > 0) ? m_positions[segment - 1] : p1 + (p1 - p2);
+	const Point3 p3 = (segment + 2 < size()) ? m_positions[segment + 2] : p2 + (p2 - p1);
+
+	// Barry and Goldman's pyramidal formulation w/ centripetal knots
+	const float k0 = 0.0f;
+	const float k1 = k0 + knotInterval(p0, p1);
+	const float k2 = k1 + knotInterval(p1, p2);
+	const float k3 = k2 + knotInterval(p2, p3);
+	const float k = k1 + u * (k2 - k1);
+
+	const Point3 a1 = ((k1 - k) * p0 + (k - k0) * p1) / (k1 - k0);
+	const Point3 a2 = ((k2 - k) * p1 + (k - k1) * p2) / (k2 - k1);
+	const Point3 a3 = ((k3 - k) * p2 + (k - k2) * p3) / (k3 - k2);
+	const Point3 b1 = ((k2 - k) * a1 + (k - k0) * a2) / (k2 - k0);
+	const Point3 b2 = ((k3 - k) * a2 + (k - k1) * a3) / (k3 - k1);
+	return ((k2 - k) * b1 + (k - k1) * b2) / (k2 - k1);
+}
+
+Point3 WaypointPath::hermite(int segment, float u) const {
+	const float h = (float)(m_times[segment + 1] - m_times[segment]);
+	const float u2 = u * u;
+	const float u3 = u2 * u;
+	return (2.0f * u3 - 3.0f * u2 + 1.0f) * m_positions[segment]
+		+ (u3 - 2.0f * u2 + u) * h * m_velocities[segment]
+		+ (-2.0f * u3 + 3.0f * u2) * m_positions[segment + 1]
+		+ (u3 - u2) * h * m_velocities[segment + 1];
+}
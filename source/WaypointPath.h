@@ -0,0 +1,105 @@
+#pragma once
+#include <G3D/G3D.h>
+#include "FPSciAnyTableReader.h"
+
+struct Destination {
+public:
+	Point3 position = Point3(0, 0, 0);
+	SimTime time = 0.0;
+
+	Destination() {
+		position = Point3(0, 0, 0);
+		time = 0.0;
+	}
+
+	Destination(Point3 pos, SimTime t) {
+		position = pos;
+		time = t;
+	}
+
+	Destination(const Any& any) {
+		int settingsVersion = 1;
+		FPSciAnyTableReader reader(any);
+		reader.getIfPresent("settingsVersion", settingsVersion);
+
+		switch (settingsVersion) {
+		case 1:
+			reader.get("t", time);
+			reader.get("xyz", position);
+			break;
+		default:
+			debugPrintf("Settings version '%d' not recognized in Destination configuration");
+			break;
+		}
+	}
+
+	Any toAny(const bool forceAll = true) const {
+		Any a(Any::TABLE);
+		a["t"] = time;
+		a["xyz"] = position;
+		return a;
+	}
+
+	size_t hash(void) {
+		return HashTrait<Point3>::hashCode(position) ^ (int)time;
+	}
+};
+
+/** Interpolation between the destinations of a path (the "pathInterpolation" target setting) */
+enum class PathInterpolation {
+	Linear,				///< Straight lines between destinations
+	CatmullRom,			///< Centripetal Catmull-Rom spline through the destinations
+	Hermite				///< Cubic Hermite spline through the destinations w/ velocities from neighboring destinations
+};
+
+/** Parse a "pathInterpolation" value, returns false if it isn't recognized */
+inline bool pathInterpolationFromString(const String& str, PathInterpolation& interpolation) {
+	const String s = toLower(str);
+	if (s == "linear") interpolation = PathInterpolation::Linear;
+	else if (s == "catmullrom") interpolation = PathInterpolation::CatmullRom;
+	else if (s == "hermite") interpolation = PathInterpolation::Hermite;
+	else return false;
+	return true;
+}
+
+inline String pathInterpolationToString(PathInterpolation interpolation) {
+	switch (interpolation) {
+	case PathInterpolation::CatmullRom: return "catmullRom";
+	case PathInterpolation::Hermite: return "hermite";
+	default: return "linear";
+	}
+}
+
+/** A destination-based target path, evaluated at any time by searching a (precomputed) array of the destination times.
+
+	The segment evaluated last is checked first, so sequential evaluation (i.e. once per frame) is constant time, and seeks,
+	respawns, and time wraps are a binary search (rather than a scan of the destinations). Destination times must be
+	non-decreasing. */
+class WaypointPath {
+protected:
+	Array<SimTime>		m_times;									///< Time of each destination (the search index)
+	Array<Point3>		m_positions;								///< Position of each destination
+	Array<Vector3>		m_velocities;								///< Velocity at each destination (for Hermite interpolation)
+	PathInterpolation	m_interpolation = PathInterpolation::Linear;
+	int					m_segment = 0;								///< Segment found by the last findSegment() call
+
+	Point3 catmullRom(int segment, float u) const;
+	Point3 hermite(int segment, float u) const;
+
+public:
+	WaypointPath() {}
+	WaypointPath(const Array<Destination>& destinations, PathInterpolation interpolation = PathInterpolation::Linear);
+
+	int size() const { return m_times.size(); }
+	PathInterpolation interpolation() const { return m_interpolation; }
+	/** Time of the last destination */
+	SimTime duration() const { return m_times.size() > 0 ? m_times.last() : 0.0; }
+
+	/** Find the segment (index of its first destination) containing a time, -1 if before the first destination or size() - 1
+		if at or after the last */
+	int findSegment(SimTime time);
+
+	/** Position along the path at a time (from 0 to duration()). Times before the first destination use the last destination
+		(as when wrapping), times after the last destination use the last destination. */
+	Point3 evaluate(SimTime time);
+};
@@ -118,6 +118,7 @@ Any WeaponConfig::toAny(const bool forceAll) const {
 void Weapon::loadDecals() {
 	if (m_config->missDecal.empty()) {
 		m_missDecalModel.reset();
+		m_missDecalSpec = "";
 	}
 	else {
 		String missDecalSpec = format("\
@@ -134,11 +135,15 @@ void Weapon::loadDecals() {
 				};\
 				scale = %f;\
 			};", m_config->missDecal.c_str(), m_config->missDecalScale);
-		m_missDecalModel = ArticulatedModel::create(Any::parse(missDecalSpec), "missDecalModel");
+		if (isNull(m_missDecalModel) || missDecalSpec != m_missDecalSpec) {		// Only recreate the model if it changed
+			m_missDecalModel = ArticulatedModel::create(Any::parse(missDecalSpec), "missDecalModel");
+			m_missDecalSpec = missDecalSpec;
+		}
 	}
 
 	if (m_config->hitDecal.empty()) {
 		m_hitDecalModel.reset();
+		m_hitDecalSpec = "";
 	}
 	else {
 		const float cmul = m_config->hitDecalColorMult;
@@ -156,7 +161,10 @@ void Weapon::loadDecals() {
 				};\
 				scale = %f;\
 			};", m_config->hitDecal.c_str(), cmul, cmul, cmul, m_config->hitDecalScale);
-		m_hitDecalModel = ArticulatedModel::create(Any::parse(hitDecalSpec), "hitDecalModel");
+		if (isNull(m_hitDecalModel) || hitDecalSpec != m_hitDecalSpec) {
+			m_hitDecalModel = ArticulatedModel::create(Any::parse(hitDecalSpec), "hitDecalModel");
+			m_hitDecalSpec = hitDecalSpec;
+		}
 	}
 }
 
@@ -164,23 +172,23 @@ void Weapon::loadModels() {
 	// Load decals
 	loadDecals();
 
-	// Create the view model
-	if (m_config->modelSpec.filename != "") {
-		m_viewModel = ArticulatedModel::create(m_config->modelSpec, "viewModel");
-	}
-	else {
-		const static Any modelSpec = PARSE_ANY(ArticulatedModel::Specification{
-			filename = "model/sniper/sniper.obj";
-			preprocess = {
-				transformGeometry(all(), Matrix4::yawDegrees(90));
-				transformGeometry(all(), Matrix4::scale(1.2,1,0.4));
-			};
-			scale = 0.25;
-			});
-		m_viewModel = ArticulatedModel::create(modelSpec, "viewModel");
+	// Create the view model (if its specification changed)
+	const static Any defaultModelSpec = PARSE_ANY(ArticulatedModel::Specification{
+		filename = "model/sniper/sniper.obj";
+		preprocess = {
+			transformGeometry(all(), Matrix4::yawDegrees(90));
+			transformGeometry(all(), Matrix4::scale(1.2,1,0.4));
+		};
+		scale = 0.25;
+		});
+	const Any modelSpec = (m_config->modelSpec.filename != "") ? m_config->modelSpec.toAny() : defaultModelSpec;
+	if (isNull(m_viewModel) || modelSpec != m_viewModelSpec) {
+		m_viewModel = ArticulatedModel::create(ArticulatedModel::Specification(modelSpec), "viewModel");
+		m_viewModelSpec = modelSpec;
 	}
 
-	// Create the bullet model
+	// Create the bullet model (this never changes)
+	if (notNull(m_bulletModel)) return;
 	const static Any bulletSpec = PARSE_ANY(ArticulatedModel::Specification{
 		filename = "ifs/d10.ifs";
 		preprocess = {
@@ -359,10 +367,14 @@ shared_ptr<TargetEntity> Weapon::fire(
 	// Apply random rotation (for fire spread)
 	Matrix3 rotMat = Matrix3::fromEulerAnglesXYZ(0.f,0.f,0.f);
 	if (m_config->fireSpreadShape == "uniform") {
-		rotMat = Matrix3::fromEulerAnglesXYZ(m_rand.uniform(-spread / 2, spread / 2), m_rand.uniform(-spread / 2, spread / 2), 0);
+		const float rotX = m_random.uniform(-spread / 2, spread / 2);
+		const float rotY = m_random.uniform(-spread / 2, spread / 2);
+		rotMat = Matrix3::fromEulerAnglesXYZ(rotX, rotY, 0);
 	}
 	else if (m_config->fireSpreadShape == "gaussian") {
-		rotMat = Matrix3::fromEulerAnglesXYZ(m_rand.gaussian(0, spread / 3), m_rand.gaussian(0, spread / 3), 0);
+		const float rotX = m_random.gaussian(0, spread / 3);
+		const float rotY = m_random.gaussian(0, spread / 3);
+		rotMat = Matrix3::fromEulerAnglesXYZ(rotX, rotY, 0);
 	}
 	Vector3 dir = Vector3(0.f, 0.f, -1.f) * rotMat;
 	ray.set(ray.origin(), m_camera->frame().rotation * dir);
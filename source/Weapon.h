@@ -134,6 +134,9 @@ protected:
 	shared_ptr<ArticulatedModel>    m_bulletModel;						///< Model for the "bullet"
 	shared_ptr<Sound>               m_fireSound;						///< Sound for weapon firing
 	shared_ptr<AudioChannel>		m_fireAudio;						///< Audio channel for fire sound
+	Any								m_viewModelSpec;					///< Specification m_viewModel was created from (models are only recreated when it changes)
+	String							m_missDecalSpec, m_hitDecalSpec;	///< Specifications the decal models were created from
+	String							m_fireSoundSpec;					///< Filename (and looping) m_fireSound was created from
 	WeaponConfig*					m_config;							///< Weapon configuration
 
 	Array<shared_ptr<Projectile>>	m_projectiles;						///< Arrray of drawn projectiles
@@ -159,7 +162,7 @@ protected:
 	Array<shared_ptr<VisibleEntity>>		m_currentMissDecals;				///< Pointers to miss decals
 	Array<SimTime>							m_missDecalTimesRemaining;				///< Create times for miss decals
 
-	Random									m_rand;
+	RandomStream							m_random;							///< Fire spread random stream (set per trial by the session)
 
 public:
 	bool drawsDecals = true;		///< Controls whether or not the weapon draws miss decals
@@ -223,6 +226,10 @@ public:
 		if (notNull(m_fireAudio)) { 
 			m_fireAudio->stop(); 
 		}
+		// Keep the loaded sound if it hasn't changed
+		const String fireSoundSpec = format("%s:%d", m_config->fireSound.c_str(), m_config->loopAudio());
+		if (notNull(m_fireSound) && fireSoundSpec == m_fireSoundSpec) return;
+		m_fireSoundSpec = fireSoundSpec;
 		if (!m_config->fireSound.empty()) {
 			m_fireSound = Sound::create(System::findDataFile(m_config->fireSound), m_config->loopAudio());
 			// Play the sound with 0 volume to load it
@@ -243,6 +250,7 @@ public:
 	void setCamera(const shared_ptr<Camera>& cam) { m_camera = cam; }
 	void setScene(const shared_ptr<Scene>& scene) { m_scene = scene; }
 	void setScoped(bool state = true) { m_scoped = state; }
+	void setRandom(const RandomStream& random) { m_random = random; }
 
 	void simulateProjectiles(SimTime sdt, const Array<shared_ptr<TargetEntity>>& targets, const Array<shared_ptr<Entity>>& dontHit = {});
 	void drawDecal(const Point3& point, const Vector3& normal, bool hit = false);
@@ -1,6 +1,7 @@
 /** \file main.cpp */
 
 #include "FPSciApp.h"
+#include "ConfigCache.h"
 
 // Tells C++ to invoke command-line main() function even on OS X and Win32.
 G3D_START_AT_MAIN();
@@ -8,6 +9,7 @@ G3D_START_AT_MAIN();
 int main(int argc, const char* argv[]) {
 
 	FPSciApp::startupConfig = StartupConfig::load("startupconfig.Any");
+	ConfigCache::directory() = FPSciApp::startupConfig.configCacheDir;
 
 	{
 		G3DSpecification spec;
@@ -80,3 +80,162 @@ bool insertRowsIntoDB(sqlite3* db, const String tableName, const Array<Array<Str
 	return ret == SQLITE_OK;
 }
 
+
+
+bool execStatementInDB(sqlite3* db, const String& statement) {
+	char* errmsg;
+	int ret = sqlite3_exec(db, statement.c_str(), 0, 0, &errmsg);
+	if (ret != SQLITE_OK) {
+		logPrintf("Error in SQL statement (%s): %s\n", statement.c_str(), errmsg);
+		sqlite3_free(errmsg);
+	}
+	return ret == SQLITE_OK;
+}
+
+bool beginTransactionInDB(sqlite3* db) {
+	return execStatementInDB(db, "BEGIN TRANSACTION;");
+}
+
+bool commitTransactionInDB(sqlite3* db) {
+	return execStatementInDB(db, "COMMIT;");
+}
+
+bool createViewInDB(sqlite3* db, const String& viewName, const String& selectStatement) {
+	const String createViewC = "CREATE VIEW IF NOT EXISTS " + viewName + " AS " + selectStatement + ";";
+	logPrintf("Creating view %s w/ SQL query:%s\n\n", viewName.c_str(), createViewC.c_str());
+	return execStatementInDB(db, createViewC);
+}
+
+bool tableExistsInDB(sqlite3* db, const String& tableName) {
+	sqlite3_stmt* stmt = nullptr;
+	if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?;", -1, &stmt, nullptr) != SQLITE_OK) {
+		logPrintf("Error querying for table %s: %s\n", tableName.c_str(), sqlite3_errmsg(db));
+		return false;
+	}
+	sqlite3_bind_text(stmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT);
+	const bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+	sqlite3_finalize(stmt);
+	return exists;
+}
+
+bool columnExistsInDB(sqlite3* db, const String& tableName, const String& columnName) {
+	sqlite3_stmt* stmt = nullptr;
+	if (sqlite3_prepare_v2(db, "SELECT 1 FROM pragma_table_info(?) WHERE name = ?;", -1, &stmt, nullptr) != SQLITE_OK) {
+		logPrintf("Error querying for column %s of table %s: %s\n", columnName.c_str(), tableName.c_str(), sqlite3_errmsg(db));
+		return false;
+	}
+	sqlite3_bind_text(stmt, 1, tableName.c_str(), -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt, 2, columnName.c_str(), -1, SQLITE_TRANSIENT);
+	const bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+	sqlite3_finalize(stmt);
+	return exists;
+}
+
+bool createIndexInDB(sqlite3* db, const String& indexName, const String& tableName, const String& columns) {
+	return execStatementInDB(db, "CREATE INDEX IF NOT EXISTS " + indexName + " ON " + tableName + " (" + columns + ");");
+}
+
+PreparedInsert::PreparedInsert(sqlite3* db, const String& tableName, int columnCount, const String& colNames) : m_tableName(tableName) {
+	// Build up a query with the format "INSERT INTO {tableName}{colNames} VALUES(?,?,...);" (one parameter per column)
+	String insertC = "INSERT INTO " + tableName + colNames + " VALUES(";
+	for (int i = 0; i < columnCount; i++) {
+		insertC += "?";
+		if (i < columnCount - 1) insertC += ",";
+	}
+	insertC += ");";
+	int ret = sqlite3_prepare_v2(db, insertC.c_str(), -1, &m_stmt, nullptr);
+	if (ret != SQLITE_OK) {
+		logPrintf("Error preparing INSERT INTO statement (%s): %s\n", insertC.c_str(), sqlite3_errmsg(db));
+		m_stmt = nullptr;
+	}
+}
+
+PreparedInsert::~PreparedInsert() {
+	// Statements must be finalized before the database can be closed
+	sqlite3_finalize(m_stmt);
+}
+
+PreparedInsert& PreparedInsert::bindText(const String& value) {
+	// SQLITE_TRANSIENT makes SQLite copy the string, so the caller's value doesn't need to outlive the insert
+	sqlite3_bind_text(m_stmt, ++m_bindIdx, value.c_str(), (int)value.length(), SQLITE_TRANSIENT);
+	return *this;
+}
+
+PreparedInsert& PreparedInsert::bindText(const char* value, int length) {
+	sqlite3_bind_text(m_stmt, ++m_bindIdx, value, length, SQLITE_TRANSIENT);
+	return *this;
+}
+
+PreparedInsert& PreparedInsert::bindReal(double value) {
+	sqlite3_bind_double(m_stmt, ++m_bindIdx, value);
+	return *this;
+}
+
+PreparedInsert& PreparedInsert::bindInt(int64 value) {
+	sqlite3_bind_int64(m_stmt, ++m_bindIdx, (sqlite3_int64)value);
+	return *this;
+}
+
+PreparedInsert& PreparedInsert::bindNull() {
+	sqlite3_bind_null(m_stmt, ++m_bindIdx);
+	return *this;
+}
+
+bool PreparedInsert::insert() {
+	if (!valid()) return false;
+	int ret = sqlite3_step(m_stmt);
+	if (ret != SQLITE_DONE) {
+		logPrintf("Error in prepared INSERT INTO %s: %s\n", m_tableName.c_str(), sqlite3_errmsg(sqlite3_db_handle(m_stmt)));
+	}
+	// Reset the statement (and its bindings) for the next row
+	sqlite3_reset(m_stmt);
+	sqlite3_clear_bindings(m_stmt);
+	m_bindIdx = 0;
+	return ret == SQLITE_DONE;
+}
+
+PreparedQuery::PreparedQuery(sqlite3* db, const String& query) {
+	if (sqlite3_prepare_v2(db, query.c_str(), -1, &m_stmt, nullptr) != SQLITE_OK) {
+		logPrintf("Error preparing query (%s): %s\n", query.c_str(), sqlite3_errmsg(db));
+		m_stmt = nullptr;
+	}
+}
+
+PreparedQuery::~PreparedQuery() {
+	sqlite3_finalize(m_stmt);
+}
+
+PreparedQuery& PreparedQuery::bindText(const String& value) {
+	sqlite3_bind_text(m_stmt, ++m_bindIdx, value.c_str(), (int)value.length(), SQLITE_TRANSIENT);
+	return *this;
+}
+
+PreparedQuery& PreparedQuery::bindReal(double value) {
+	sqlite3_bind_double(m_stmt, ++m_bindIdx, value);
+	return *this;
+}
+
+PreparedQuery& PreparedQuery::bindInt(int64 value) {
+	sqlite3_bind_int64(m_stmt, ++m_bindIdx, (sqlite3_int64)value);
+	return *this;
+}
+
+bool PreparedQuery::step() {
+	if (!valid()) return false;
+	const int ret = sqlite3_step(m_stmt);
+	if (ret != SQLITE_ROW && ret != SQLITE_DONE) {
+		logPrintf("Error in query (%s): %s\n", sqlite3_sql(m_stmt), sqlite3_errmsg(sqlite3_db_handle(m_stmt)));
+	}
+	return ret == SQLITE_ROW;
+}
+
+String PreparedQuery::columnText(int col) const {
+	const unsigned char* text = sqlite3_column_text(m_stmt, col);
+	return isNull(text) ? String() : String((const char*)text, sqlite3_column_bytes(m_stmt, col));
+}
+
+void PreparedQuery::reset() {
+	sqlite3_reset(m_stmt);
+	sqlite3_clear_bindings(m_stmt);
+	m_bindIdx = 0;
+}
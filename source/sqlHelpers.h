@@ -7,3 +7,82 @@
 bool createTableInDB(sqlite3* db, const String tableName, const Array<Array<String>>& columns);
 bool insertRowIntoDB(sqlite3* db, const String tableName, const Array<String>& values, const String colNames = "");
 bool insertRowsIntoDB(sqlite3* db, const String tableName, const Array<Array<String>>& valueVector, const String colNames = "");
+
+/** Run a single SQL statement that doesn't return rows (PRAGMA, BEGIN, COMMIT, etc.), errors are written to the log */
+bool execStatementInDB(sqlite3* db, const String& statement);
+bool beginTransactionInDB(sqlite3* db);
+bool commitTransactionInDB(sqlite3* db);
+
+/** Create a view (if it doesn't already exist) with the format "CREATE VIEW {viewName} AS {selectStatement};" */
+bool createViewInDB(sqlite3* db, const String& viewName, const String& selectStatement);
+/** Check whether a table with the provided name exists in the database */
+bool tableExistsInDB(sqlite3* db, const String& tableName);
+/** Check whether a table (or view) has a column with the provided name */
+bool columnExistsInDB(sqlite3* db, const String& tableName, const String& columnName);
+/** Create an index (if it doesn't already exist) with the format "CREATE INDEX {indexName} ON {tableName} ({columns});" */
+bool createIndexInDB(sqlite3* db, const String& indexName, const String& tableName, const String& columns);
+
+/** A cached INSERT statement for a single table. The SQL is parsed once (using sqlite3_prepare_v2) and values are then
+	bound natively for each row, avoiding building (and re-parsing) a query string for every insert.
+	Usage is: bind every column (in order) using the bind*() methods, then call insert() to write the row. */
+class PreparedInsert : public ReferenceCountedObject {
+protected:
+	sqlite3_stmt*	m_stmt = nullptr;			///< The prepared statement (null if preparation failed)
+	String			m_tableName;				///< Name of the table this statement inserts into
+	int				m_bindIdx = 0;				///< Index of the last bound column (SQLite bind indices are 1-based)
+
+public:
+	PreparedInsert(sqlite3* db, const String& tableName, int columnCount, const String& colNames = "");
+	virtual ~PreparedInsert();
+
+	static shared_ptr<PreparedInsert> create(sqlite3* db, const String& tableName, int columnCount, const String& colNames = "") {
+		return createShared<PreparedInsert>(db, tableName, columnCount, colNames);
+	}
+
+	bool valid() const { return notNull(m_stmt); }
+
+	PreparedInsert& bindText(const String& value);
+	PreparedInsert& bindText(const char* value, int length);
+	PreparedInsert& bindReal(double value);
+	PreparedInsert& bindInt(int64 value);
+	PreparedInsert& bindBool(bool value) { return bindInt(value ? 1 : 0); }
+	PreparedInsert& bindNull();
+
+	/** Execute the insert with the currently bound values, then reset the statement for the next row */
+	bool insert();
+};
+
+/** A prepared SELECT statement. Usage is: bind any parameters (in order) using the bind*() methods, then call step()
+	until it returns false, reading the columns of each row using the column*() methods. Call reset() to run it again. */
+class PreparedQuery : public ReferenceCountedObject {
+protected:
+	sqlite3_stmt*	m_stmt = nullptr;			///< The prepared statement (null if preparation failed)
+	int				m_bindIdx = 0;				///< Index of the last bound parameter (SQLite bind indices are 1-based)
+
+public:
+	PreparedQuery(sqlite3* db, const String& query);
+	virtual ~PreparedQuery();
+
+	static shared_ptr<PreparedQuery> create(sqlite3* db, const String& query) {
+		return createShared<PreparedQuery>(db, query);
+	}
+
+	bool valid() const { return notNull(m_stmt); }
+
+	PreparedQuery& bindText(const String& value);
+	PreparedQuery& bindReal(double value);
+	PreparedQuery& bindInt(int64 value);
+
+	/** Step to the next row of results, returns false once there are no more rows (or on error) */
+	bool step();
+
+	// Column values for the current row (columns are 0-indexed)
+	int columnType(int col) const { return sqlite3_column_type(m_stmt, col); }
+	bool columnIsNull(int col) const { return sqlite3_column_type(m_stmt, col) == SQLITE_NULL; }
+	String columnText(int col) const;
+	double columnReal(int col) const { return sqlite3_column_double(m_stmt, col); }
+	int64 columnInt(int col) const { return sqlite3_column_int64(m_stmt, col); }
+
+	/** Reset the statement (and its bindings) to run it again */
+	void reset();
+};
@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <ColumnarWriter.h>
+#include <cmath>
+#include <cstring>
+
+/** A (still encoded) column read back from a columnar results file */
+struct ColumnarTestColumn {
+	String			name;
+	uint8			type = 0;
+	Array<uint8>	data;
+};
+
+/** A row group read back from a columnar results file */
+struct ColumnarTestRowGroup {
+	String						table;
+	int							rowCount = 0;
+	Array<ColumnarTestColumn>	columns;
+
+	const ColumnarTestColumn* column(const String& name) const {
+		for (const ColumnarTestColumn& col : columns) {
+			if (col.name == name) return &col;
+		}
+		return nullptr;
+	}
+};
+
+static uint64 readVarint(const Array<uint8>& buf, int& pos) {
+	uint64 value = 0;
+	for (int shift = 0; pos < buf.size(); shift += 7) {
+		const uint8 b = buf[pos++];
+		value |= (uint64)(b & 0x7f) << shift;
+		if (b < 0x80) break;
+	}
+	return value;
+}
+
+static String readString(const Array<uint8>& buf, int& pos) {
+	const int length = (int)readVarint(buf, pos);
+	const String str((const char*)buf.getCArray() + pos, length);
+	pos += length;
+	return str;
+}
+
+static uint32 readUint32(const Array<uint8>& buf, int& pos) {
+	uint32 value = 0;
+	for (int i = 0; i < 4; i++) value |= (uint32)buf[pos++] << (8 * i);
+	return value;
+}
+
+static int64 unzigzag(uint64 value) {
+	return (int64)(value >> 1) ^ -(int64)(value & 1);
+}
+
+/** Read a columnar results file (see docs/resultsFiles.md) into its (encoded) row groups */
+static Array<ColumnarTestRowGroup> readColumnarFile(const String& filename, String& magic, uint32& version) {
+	Array<uint8> buf;
+	FILE* f = fopen(filename.c_str(), "rb");
+	if (notNull(f)) {
+		uint8 chunk[4096];
+		size_t count;
+		while ((count = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+			const int start = buf.size();
+			buf.resize(start + (int)count);
+			memcpy(buf.getCArray() + start, chunk, count);
+		}
+		fclose(f);
+	}
+
+	Array<ColumnarTestRowGroup> groups;
+	if (buf.size() < 12) return groups;
+	magic = String((const char*)buf.getCArray(), 8);
+	int pos = 8;
+	version = readUint32(buf, pos);
+	while (pos + 8 <= buf.size()) {
+		EXPECT_EQ(String("RGRP"), String((const char*)buf.getCArray() + pos, 4));
+		pos += 4;
+		const int length = (int)readUint32(buf, pos);
+		const int end = pos + length;
+		ColumnarTestRowGroup& group = groups.next();
+		group.table = readString(buf, pos);
+		group.rowCount = (int)readVarint(buf, pos);
+		const int columnCount = (int)readVarint(buf, pos);
+		for (int c = 0; c < columnCount; c++) {
+			ColumnarTestColumn& col = group.columns.next();
+			col.name = readString(buf, pos);
+			col.type = buf[pos++];
+			const int size = (int)readVarint(buf, pos);
+			col.data.resize(size);
+			memcpy(col.data.getCArray(), buf.getCArray() + pos, size);
+			pos += size;
+		}
+		EXPECT_EQ(end, pos);
+		pos = end;
+	}
+	return groups;
+}
+
+static Array<int64> decodeTimes(const ColumnarTestColumn& col, int rowCount) {
+	Array<int64> values;
+	int pos = 0;
+	int64 last = 0;
+	for (int i = 0; i < rowCount; i++) {
+		last += unzigzag(readVarint(col.data, pos));
+		values.append(last);
+	}
+	return values;
+}
+
+static Array<float> decodeFloats(const ColumnarTestColumn& col, int rowCount) {
+	Array<float> values;
+	int pos = 0;
+	for (int i = 0; i < rowCount; i++) {
+		const uint32 bits = readUint32(col.data, pos);
+		float v;
+		memcpy(&v, &bits, sizeof(v));
+		values.append(v);
+	}
+	return values;
+}
+
+static Array<String> decodeStrings(const ColumnarTestColumn& col, int rowCount) {
+	int pos = 0;
+	Array<String> dictionary;
+	const int dictionarySize = (int)readVarint(col.data, pos);
+	for (int i = 0; i < dictionarySize; i++) dictionary.append(readString(col.data, pos));
+	Array<String> values;
+	for (int i = 0; i < rowCount; i++) values.append(dictionary[(int)readVarint(col.data, pos)]);
+	return values;
+}
+
+/** Decode a quantized delta column, lastValues holds the last quantized value of each key (stream) from earlier row groups */
+static Array<double> decodeQuantized(const ColumnarTestColumn& col, int rowCount, const Array<String>& keys,
+	Table<String, int64>& lastValues, Array<bool>& keyframes)
+{
+	int pos = 0;
+	double step;
+	memcpy(&step, col.data.getCArray(), sizeof(step));		// Written little-endian (as is the host)
+	pos += sizeof(step);
+	readString(col.data, pos);								// Key column name
+	Array<double> values;
+	for (int i = 0; i < rowCount; i++) {
+		const uint64 packed = readVarint(col.data, pos);
+		const bool keyframe = (packed & 1) != 0;
+		const int64 v = unzigzag(packed >> 1);
+		const String key = keys.size() > 0 ? keys[i] : "";
+		int64* last = lastValues.getPointer(key);
+		EXPECT_TRUE(keyframe || notNull(last)) << "The first sample of a stream must be a keyframe";
+		const int64 q = (keyframe || isNull(last)) ? v : *last + v;
+		lastValues.set(key, q);
+		keyframes.append(keyframe);
+		values.append(q * step);
+	}
+	return values;
+}
+
+TEST(ColumnarWriter, ReadsBackWrittenColumns) {
+	const String filename = "test_columnar.fpcol";
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+
+	const Array<int64> times = { 1600000000000000LL, 1600000000001000LL, 1600000000000500LL, 1600000010000000LL };
+	const Array<float> sdt = { 0.001f, -2.5f, 1e-20f, 123456.789f };
+	const Array<String> events = { "aim", "hit", "aim", "" };
+	{
+		shared_ptr<ColumnarWriter> writer = ColumnarWriter::create(filename);
+		ASSERT_TRUE(writer->valid());
+		writer->beginRowGroup("Frame_Info", times.size());
+		writer->addTimeColumn("time", times);
+		writer->addFloatColumn("sdt", sdt);
+		ASSERT_TRUE(writer->endRowGroup());
+		writer->beginRowGroup("Player_Action", 2);
+		writer->addTimeColumn("time", { times[0], times[1] });
+		writer->addStringColumn("event", { events[0], events[1] });
+		ASSERT_TRUE(writer->endRowGroup());
+	}
+	{
+		// Opening the file again appends to it (w/o another header)
+		shared_ptr<ColumnarWriter> writer = ColumnarWriter::create(filename);
+		writer->beginRowGroup("Player_Action", events.size());
+		writer->addTimeColumn("time", times);
+		writer->addStringColumn("event", events);
+		ASSERT_TRUE(writer->endRowGroup());
+	}
+
+	String magic;
+	uint32 version = 0;
+	const Array<ColumnarTestRowGroup> groups = readColumnarFile(filename, magic, version);
+	EXPECT_EQ(String("FPSCICOL"), magic);
+	EXPECT_EQ((uint32)ColumnarWriter::version, version);
+	ASSERT_EQ(3, groups.size());
+
+	EXPECT_EQ(String("Frame_Info"), groups[0].table);
+	EXPECT_EQ(times.size(), groups[0].rowCount);
+	ASSERT_EQ(2, groups[0].columns.size());
+	EXPECT_EQ(String("time"), groups[0].columns[0].name);
+	EXPECT_EQ(ColumnarWriter::TimeDeltaVarint, groups[0].columns[0].type);
+	EXPECT_EQ(String("sdt"), groups[0].columns[1].name);
+	EXPECT_EQ(ColumnarWriter::Float32, groups[0].columns[1].type);
+	const Array<int64> readTimes = decodeTimes(groups[0].columns[0], groups[0].rowCount);
+	const Array<float> readSdt = decodeFloats(groups[0].columns[1], groups[0].rowCount);
+	for (int i = 0; i < times.size(); i++) {
+		EXPECT_EQ(times[i], readTimes[i]);
+		EXPECT_EQ(sdt[i], readSdt[i]);
+	}
+
+	EXPECT_EQ(String("Player_Action"), groups[1].table);
+	EXPECT_EQ(2, groups[1].rowCount);
+	EXPECT_EQ(String("Player_Action"), groups[2].table);
+	ASSERT_EQ(2, groups[2].columns.size());
+	EXPECT_EQ(ColumnarWriter::StringDictionary, groups[2].columns[1].type);
+	const Array<String> readEvents = decodeStrings(groups[2].columns[1], groups[2].rowCount);
+	ASSERT_EQ(events.size(), readEvents.size());
+	for (int i = 0; i < events.size(); i++) EXPECT_EQ(events[i], readEvents[i]);
+
+	FileSystem::removeFile(filename);
+}
+
+TEST(ColumnarWriter, QuantizedDeltasRoundTripAcrossRowGroups) {
+	const String filename = "test_columnar_delta.fpcol";
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+	const double step = 1e-3;
+	const int keyframeInterval = 8;
+	const int groupCount = 3;
+	const int samplesPerTarget = 13;		// Per row group (not a multiple of the keyframe interval)
+	const Array<String> targets = { "target0", "target1" };
+
+	// Interleaved samples of each target's (smooth) motion, split across several row groups (logger flushes)
+	Array<Array<float>> writtenValues;
+	Array<Array<String>> writtenKeys;
+	{
+		shared_ptr<ColumnarWriter> writer = ColumnarWriter::create(filename);
+		for (int g = 0; g < groupCount; g++) {
+			Array<float>& values = writtenValues.next();
+			Array<String>& keys = writtenKeys.next();
+			for (int s = 0; s < samplesPerTarget; s++) {
+				for (int t = 0; t < targets.size(); t++) {
+					const float time = (g * samplesPerTarget + s) * 0.01f;
+					values.append(10.0f * sinf(time + t) + 0.1234567f * t);
+					keys.append(targets[t]);
+				}
+			}
+			writer->beginRowGroup("Target_Trajectory", values.size());
+			writer->addStringColumn("target_id", keys);
+			writer->addQuantizedDeltaColumn("position_x", values, step, "target_id", keys, keyframeInterval);
+			ASSERT_TRUE(writer->endRowGroup());
+		}
+	}
+
+	String magic;
+	uint32 version = 0;
+	const Array<ColumnarTestRowGroup> groups = readColumnarFile(filename, magic, version);
+	ASSERT_EQ(groupCount, groups.size());
+	Table<String, int64> lastValues;
+	Table<String, int> sampleCounts;
+	for (int g = 0; g < groupCount; g++) {
+		const ColumnarTestColumn* keyColumn = groups[g].column("target_id");
+		const ColumnarTestColumn* valueColumn = groups[g].column("position_x");
+		ASSERT_TRUE(notNull(keyColumn) && notNull(valueColumn));
+		EXPECT_EQ(ColumnarWriter::QuantizedDelta, valueColumn->type);
+
+		const Array<String> keys = decodeStrings(*keyColumn, groups[g].rowCount);
+		Array<bool> keyframes;
+		const Array<double> values = decodeQuantized(*valueColumn, groups[g].rowCount, keys, lastValues, keyframes);
+		ASSERT_EQ(writtenValues[g].size(), values.size());
+		for (int i = 0; i < values.size(); i++) {
+			EXPECT_EQ(writtenKeys[g][i], keys[i]);
+			// Reconstructed to within half a quantization step
+			EXPECT_LE(fabs(values[i] - (double)writtenValues[g][i]), step / 2 + 1e-12);
+			// Keyframes land every keyframeInterval samples of each target, continuing across row groups
+			const int* count = sampleCounts.getPointer(keys[i]);
+			const int sampleIdx = isNull(count) ? 0 : *count;
+			EXPECT_EQ(sampleIdx % keyframeInterval == 0, keyframes[i]) << "sample " << sampleIdx << " of " << keys[i].c_str();
+			sampleCounts.set(keys[i], sampleIdx + 1);
+		}
+	}
+	FileSystem::removeFile(filename);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <ConfigCache.h>
+
+static void writeFile(const String& filename, const String& contents) {
+	FILE* f = fopen(filename.c_str(), "wb");
+	fwrite(contents.c_str(), 1, contents.size(), f);
+	fclose(f);
+}
+
+TEST(ConfigCache, RoundTripsAnyTree) {
+	Any destinations(Any::ARRAY, "");
+	for (int i = 0; i < 100; i++) {
+		Any destination(Any::TABLE, "");
+		destination.set("t", i * 0.1);
+		Any position(Any::ARRAY, "Point3");
+		position.append(Any(i * 1.0));
+		position.append(Any(-0.5));
+		position.append(Any(1e-9));
+		destination.set("xyz", position);
+		destinations.append(destination);
+	}
+	Any target(Any::TABLE, "");
+	target.set("id", Any(String("waypoint target")));
+	target.set("respawnCount", Any(-1.0));
+	target.set("logTargetTrajectory", Any(true));
+	target.set("destinations", destinations);
+	target.set("modelSpec", Any(Any::EMPTY_CONTAINER, "ArticulatedModel::Specification"));
+	Any config(Any::TABLE, "");
+	config.set("description", Any(String("cache test")));
+	config.set("targets", destinations);
+	config.set("target", target);
+
+	const String binary = ConfigCache::toBinary(config);
+	EXPECT_TRUE(ConfigCache::fromBinary(binary) == config);
+
+	// Truncated or padded data is rejected (rather than returning a partial config)
+	EXPECT_ANY_THROW(ConfigCache::fromBinary(binary.substr(0, binary.size() - 1)));
+	EXPECT_ANY_THROW(ConfigCache::fromBinary(binary + "x"));
+}
+
+TEST(ConfigCache, HashCoversIncludes) {
+	writeFile("configcache_test.Any", "{ frameTimeArray = (#include(\"configcache_test.csv\")); }");
+	writeFile("configcache_test.csv", "0.004, 0.008");
+	uint64 hash, sameHash, changedHash;
+	ASSERT_TRUE(ConfigCache::hashSource("configcache_test.Any", hash));
+	ASSERT_TRUE(ConfigCache::hashSource("configcache_test.Any", sameHash));
+	EXPECT_EQ(hash, sameHash);
+
+	// Changing (only) the included file changes the hash
+	writeFile("configcache_test.csv", "0.004, 0.016");
+	ASSERT_TRUE(ConfigCache::hashSource("configcache_test.Any", changedHash));
+	EXPECT_NE(hash, changedHash);
+
+	// A missing include can't be hashed (so the file is parsed instead of cached)
+	FileSystem::removeFile("configcache_test.csv");
+	EXPECT_FALSE(ConfigCache::hashSource("configcache_test.Any", hash));
+	FileSystem::removeFile("configcache_test.Any");
+}
+
+/** A config that rejects negative values (w/ a parse error at the location of the Any it was constructed from) */
+struct ConfigCacheTestConfig {
+	double value = 0.0;
+	ConfigCacheTestConfig(const Any& any) {
+		value = any["value"].number();
+		any.verify(value >= 0.0, "value must be non-negative");
+	}
+};
+
+TEST(ConfigCache, ErrorsInCachedConfigsReportTheSourceFile) {
+	const String cacheDir = ConfigCache::directory();
+	ConfigCache::directory() = "configcache_test_cache";
+	writeFile("configcache_error_test.Any", "{\n\tvalue = -1;\n}");
+
+	// The first load parses the source (and caches it), the second reads the cache then parses the source to report the error
+	for (int i = 0; i < 2; i++) {
+		try {
+			ConfigCache::loadConfig<ConfigCacheTestConfig>("configcache_error_test.Any");
+			ADD_FAILURE() << "Invalid config loaded w/o an error";
+		}
+		catch (const ParseError& e) {
+			EXPECT_NE(std::string::npos, e.filename.find("configcache_error_test.Any")) << "load " << i;
+			EXPECT_GT(e.line, 0) << "load " << i;
+		}
+	}
+
+	// A valid config is still read from the cache
+	writeFile("configcache_error_test.Any", "{\n\tvalue = 2;\n}");
+	EXPECT_EQ(2.0, ConfigCache::loadConfig<ConfigCacheTestConfig>("configcache_error_test.Any").value);
+	bool fromCache = false;
+	ConfigCache::load("configcache_error_test.Any", &fromCache);
+	EXPECT_TRUE(fromCache);
+
+	FileSystem::removeFile("configcache_error_test.Any");
+	FileSystem::removeFile(ConfigCache::directory());
+	ConfigCache::directory() = cacheDir;
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <FlyingTargetBatch.h>
+
+TEST(FlyingTargetBatch, MovesAlongOrbit) {
+	FlyingTargetBatch batch;
+	FlyingTargetBatch::Params params;
+	params.angularSpeedRange = Vector2(10.0f, 30.0f);
+	params.motionChangePeriodRange = Vector2(0.5f, 1.0f);
+	const Point3 center(1.0f, 2.0f, 3.0f);
+	const int moving = batch.add(center, center + Vector3(0.0f, 0.5f, -10.0f), params, RandomStream(1));
+	params.angularSpeedRange = Vector2(0.0f, 30.0f);
+	const int still = batch.add(center, center + Vector3(0.0f, 0.0f, -10.0f), params);
+
+	const float radius = sqrtf(0.25f + 100.0f);
+	const float dt = 1.0f / 240.0f;
+	for (int f = 0; f < 1000; f++) {
+		const Vector3 before = (batch.position(moving) - center).direction();
+		batch.advance(dt);
+		const Vector3 after = (batch.position(moving) - center).direction();
+
+		// Stays on its sphere and never exceeds the maximum angular speed
+		EXPECT_NEAR((batch.position(moving) - center).length(), radius, 1e-3f);
+		EXPECT_LE(2.0f * asinf(0.5f * (after - before).length()), 30.0f * pif() / 180.0f * dt * 1.01f);
+		EXPECT_TRUE(batch.moved(moving));
+
+		// Targets w/ a zero minimum speed don't move
+		EXPECT_FALSE(batch.moved(still));
+	}
+	EXPECT_NEAR((batch.position(still) - (center + Vector3(0.0f, 0.0f, -10.0f))).length(), 0.0f, 1e-5f);
+
+	// Removing a slot moves the last slot into it
+	const Point3 stillPosition = batch.position(still);
+	batch.remove(moving);
+	ASSERT_EQ(batch.size(), 1);
+	EXPECT_NEAR((batch.position(0) - stillPosition).length(), 0.0f, 1e-6f);
+}
+
+TEST(FlyingTargetBatch, UpperHemisphereOnly) {
+	FlyingTargetBatch batch;
+	FlyingTargetBatch::Params params;
+	params.angularSpeedRange = Vector2(90.0f, 180.0f);
+	params.motionChangePeriodRange = Vector2(1.0f, 2.0f);
+	params.upperHemisphereOnly = true;
+	const Point3 center(0.0f, 1.5f, 0.0f);
+	for (int i = 0; i < 20; i++) batch.add(center, center + Vector3(0.0f, 0.0f, -5.0f), params, RandomStream(i));
+
+	for (int f = 0; f < 500; f++) {
+		batch.advance(1.0 / 60.0);
+		for (int i = 0; i < batch.size(); i++) {
+			EXPECT_GE(batch.position(i).y, center.y - 1e-4f);
+		}
+	}
+}
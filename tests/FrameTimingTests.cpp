@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <FrameTimeSchedule.h>
+#include <FramePacer.h>
+
+static const Array<float> s_frameTimes = { 1.0f / 240.0f, 1.0f / 360.0f, 1.0f / 500.0f };
+static const float s_defaultFrameTime = 1.0f / 60.0f;
+
+TEST(FrameTimeSchedules, SequentialCyclesInOrder) {
+	FrameTimeSchedule schedule(s_frameTimes, false, FrameTimeMode::Always, s_defaultFrameTime, 1);
+	EXPECT_FALSE(schedule.randomized());
+	for (int i = 0; i < 7; i++) {
+		EXPECT_EQ(s_frameTimes[i % s_frameTimes.size()], schedule.next(i % 2 == 0));
+	}
+}
+
+TEST(FrameTimeSchedules, EmptyArrayUsesDefault) {
+	FrameTimeSchedule schedule(Array<float>(), true, FrameTimeMode::Always, s_defaultFrameTime, 1);
+	EXPECT_EQ(s_defaultFrameTime, schedule.next(true));
+	EXPECT_EQ(s_defaultFrameTime, schedule.next(false));
+}
+
+TEST(FrameTimeSchedules, TaskModes) {
+	// Task only continues where the previous task left off, and uses the default outside the task
+	FrameTimeSchedule taskOnly(s_frameTimes, false, FrameTimeMode::TaskOnly, s_defaultFrameTime, 1);
+	EXPECT_EQ(s_defaultFrameTime, taskOnly.next(false));
+	taskOnly.startTask();
+	EXPECT_EQ(s_frameTimes[0], taskOnly.next(true));
+	EXPECT_EQ(s_frameTimes[1], taskOnly.next(true));
+	EXPECT_EQ(s_defaultFrameTime, taskOnly.next(false));
+	taskOnly.startTask();
+	EXPECT_EQ(s_frameTimes[2], taskOnly.next(true));
+
+	// Restart with task starts over at each task
+	FrameTimeSchedule restart(s_frameTimes, false, FrameTimeMode::RestartWithTask, s_defaultFrameTime, 1);
+	restart.startTask();
+	EXPECT_EQ(s_frameTimes[0], restart.next(true));
+	EXPECT_EQ(s_frameTimes[1], restart.next(true));
+	EXPECT_EQ(s_defaultFrameTime, restart.next(false));
+	restart.startTask();
+	EXPECT_EQ(s_frameTimes[0], restart.next(true));
+}
+
+TEST(FrameTimeSchedules, RandomizedIsReproducibleFromSeed) {
+	FrameTimeSchedule a(s_frameTimes, true, FrameTimeMode::Always, s_defaultFrameTime, 1234);
+	FrameTimeSchedule b(s_frameTimes, true, FrameTimeMode::Always, s_defaultFrameTime, 1234);
+	FrameTimeSchedule c(s_frameTimes, true, FrameTimeMode::Always, s_defaultFrameTime, 4321);
+	ASSERT_TRUE(a.randomized());
+	EXPECT_TRUE(a.frameTimes() == s_frameTimes);
+
+	// Every value is drawn from the array (and each is drawn roughly equally often), the same seed draws the same sequence
+	const int frameCount = 30000;
+	Array<float> sequence;
+	Array<int> counts = { 0, 0, 0 };
+	int differences = 0;
+	for (int i = 0; i < frameCount; i++) {
+		const float frameTime = a.next(true);
+		EXPECT_EQ(frameTime, b.next(true));
+		if (frameTime != c.next(true)) differences++;
+		const int idx = s_frameTimes.findIndex(frameTime);
+		ASSERT_GE(idx, 0);
+		counts[idx]++;
+		sequence.append(frameTime);
+	}
+	EXPECT_LT(0, differences);
+	for (int count : counts) EXPECT_NEAR(frameCount / 3, count, frameCount / 10);
+
+	// The sequence doesn't repeat (i.e. after a fixed number of frames)
+	for (int period : { 1024, 4096, 8192 }) {
+		int repeats = 0;
+		for (int i = 0; i + period < frameCount; i++) {
+			if (sequence[i] == sequence[i + period]) repeats++;
+		}
+		EXPECT_LT(repeats, (frameCount - period) / 2) << "period " << period;
+	}
+}
+
+TEST(FrameTimeSchedules, RandomizedTaskModesKeepDrawing) {
+	// Frames outside the task don't draw, and starting a task doesn't restart the (random) sequence
+	FrameTimeSchedule always(s_frameTimes, true, FrameTimeMode::Always, s_defaultFrameTime, 99);
+	FrameTimeSchedule restart(s_frameTimes, true, FrameTimeMode::RestartWithTask, s_defaultFrameTime, 99);
+	for (int i = 0; i < 100; i++) {
+		if (i % 10 == 0) {
+			restart.startTask();
+			EXPECT_EQ(s_defaultFrameTime, restart.next(false));
+		}
+		EXPECT_EQ(always.next(true), restart.next(true));
+	}
+}
+
+TEST(FramePacers, HybridHitsDeadlines) {
+	// Deadline accuracy depends on the machine (and its load), so only check the schedule is kept here (see FPSci.pacerbench for the error)
+	for (bool timingThread : { false, true }) {
+		shared_ptr<FramePacer> pacer = FramePacer::create("hybrid", 1.0f, timingThread);
+		pacer->wait(0.0);
+		const FramePacer::Clock::time_point start = FramePacer::Clock::now();
+		const int frameCount = 50;
+		for (int i = 0; i < frameCount; i++) pacer->wait(0.002);
+		const double elapsed = std::chrono::duration<double>(FramePacer::Clock::now() - start).count();
+
+		// The schedule is kept from deadline to deadline (starting just before start), so no frame ends before its deadline
+		// and (other than late frames restarting the schedule) the total doesn't grow with the number of frames
+		EXPECT_GE(elapsed, frameCount * 0.002 - 0.0005) << "timingThread " << timingThread;
+		EXPECT_LT(elapsed, frameCount * 0.002 + 0.5) << "timingThread " << timingThread;
+		EXPECT_GE(pacer->overWait(), 0.0) << "timingThread " << timingThread;
+	}
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <JobSystem.h>
+
+TEST(JobSystem, CoversRangeOnce) {
+	for (int workers : { 0, 1, 3 }) {
+		JobSystem jobs(workers);
+		EXPECT_EQ(jobs.workerCount(), workers);
+		for (int count : { 0, 1, 7, 100, 1001 }) {
+			Array<std::atomic<int>*> visits;
+			for (int i = 0; i < count; i++) visits.append(new std::atomic<int>(0));
+
+			// Uneven job costs (so workers steal from each other)
+			jobs.parallelFor(count, 8, [&](int begin, int end) {
+				if (workers > 0) EXPECT_LE(end - begin, 8);		// W/o workers the whole range is run directly
+				for (int i = begin; i < end; i++) {
+					if (i % 50 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+					(*visits[i])++;
+				}
+			});
+
+			for (int i = 0; i < count; i++) EXPECT_EQ(visits[i]->load(), 1);
+			visits.deleteAll();
+		}
+	}
+}
+
+TEST(JobSystem, RethrowsJobExceptions) {
+	JobSystem jobs(2);
+	std::atomic<int> completed(0);
+	EXPECT_THROW(jobs.parallelFor(64, 4, [&](int begin, int end) {
+		if (begin == 32) throw std::runtime_error("job failed");
+		completed += end - begin;
+	}), std::runtime_error);
+	EXPECT_EQ(completed.load(), 60);		// All other jobs still run
+
+	// The job system is still usable afterwards
+	std::atomic<int> sum(0);
+	jobs.parallelFor(10, 1, [&](int begin, int end) { for (int i = begin; i < end; i++) sum += i; });
+	EXPECT_EQ(sum.load(), 45);
+}
@@ -0,0 +1,723 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <sqlHelpers.h>
+#include <RingBuffer.h>
+#include <FPSciClock.h>
+#include <LogJournal.h>
+#include <HardwareEventLogger.h>
+#include <Logger.h>
+#include <FPSciApp.h>
+#include <chrono>
+#include <cstddef>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/** Columns matching the Player_Action table */
+static const Array<Array<String>> s_playerActionColumns = {
+	{ "time", "text" },
+	{ "position_az", "real" },
+	{ "position_el", "real" },
+	{ "position_x", "real"},
+	{ "position_y", "real"},
+	{ "position_z", "real"},
+	{ "state", "text"},
+	{ "event", "text" },
+	{ "target_id", "text" },
+};
+
+/** Open a fresh (empty) database w/ a Player_Action table created */
+static sqlite3* openPlayerActionDb(const String& filename) {
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	createTableInDB(db, "Player_Action", s_playerActionColumns);
+	return db;
+}
+
+static int64 countRows(sqlite3* db, const String& tableName) {
+	sqlite3_stmt* stmt = nullptr;
+	sqlite3_prepare_v2(db, ("SELECT COUNT(*) FROM " + tableName + ";").c_str(), -1, &stmt, nullptr);
+	sqlite3_step(stmt);
+	const int64 count = sqlite3_column_int64(stmt, 0);
+	sqlite3_finalize(stmt);
+	return count;
+}
+
+// The prepared/transaction-batched insert (used by FPSciLogger) writes the same rows as the string-built multi-row insert
+// (FPSci.bench insertPath=both compares their rows/s)
+TEST(LoggerQueries, PreparedInsertMatchesStringInsert) {
+	const String dir = "test_logger_inserts";
+	if (!FileSystem::exists(dir)) FileSystem::createDirectory(dir);
+	const String stringFilename = dir + "/string.db";
+	const String preparedFilename = dir + "/prepared.db";
+	const int flushCount = 4;				// Number of logger "flushes" to simulate
+	const int rowsPerFlush = 250;			// Rows written per flush
+
+	// String path (what FPSciLogger used to do for every flush)
+	sqlite3* stringDb = openPlayerActionDb(stringFilename);
+	for (int f = 0; f < flushCount; f++) {
+		Array<Array<String>> rows;
+		for (int i = 0; i < rowsPerFlush; i++) {
+			rows.append({
+				format("'2020-01-01 00:00:%02d.%06d'", f, i),
+				format("%.17g", (double)(0.1f * i)),
+				format("%.17g", (double)(0.2f * i)),
+				"1",
+				"2",
+				"3",
+				"'trialTask'",
+				"'aim'",
+				format("'target%d'", i)
+			});
+		}
+		insertRowsIntoDB(stringDb, "Player_Action", rows);
+	}
+
+	// Prepared statement path (one transaction per flush)
+	sqlite3* preparedDb = openPlayerActionDb(preparedFilename);
+	{
+		shared_ptr<PreparedInsert> insert = PreparedInsert::create(preparedDb, "Player_Action", s_playerActionColumns.size());
+		ASSERT_TRUE(insert->valid());
+		for (int f = 0; f < flushCount; f++) {
+			beginTransactionInDB(preparedDb);
+			for (int i = 0; i < rowsPerFlush; i++) {
+				insert->bindText(format("2020-01-01 00:00:%02d.%06d", f, i))
+					.bindReal(0.1f * i)
+					.bindReal(0.2f * i)
+					.bindReal(1.0f)
+					.bindReal(2.0f)
+					.bindReal(3.0f)
+					.bindText("trialTask")
+					.bindText("aim")
+					.bindText(format("target%d", i))
+					.insert();
+			}
+			commitTransactionInDB(preparedDb);
+		}
+	}
+
+	EXPECT_EQ(flushCount * rowsPerFlush, countRows(stringDb, "Player_Action"));
+	EXPECT_EQ(flushCount * rowsPerFlush, countRows(preparedDb, "Player_Action"));
+	{
+		const String selectQ = "SELECT * FROM Player_Action ORDER BY time;";
+		shared_ptr<PreparedQuery> stringRows = PreparedQuery::create(stringDb, selectQ);
+		shared_ptr<PreparedQuery> preparedRows = PreparedQuery::create(preparedDb, selectQ);
+		while (stringRows->step()) {
+			ASSERT_TRUE(preparedRows->step());
+			for (int col = 0; col < s_playerActionColumns.size(); col++) {
+				if (s_playerActionColumns[col][1] == "real") EXPECT_EQ(stringRows->columnReal(col), preparedRows->columnReal(col));
+				else EXPECT_EQ(stringRows->columnText(col), preparedRows->columnText(col));
+			}
+		}
+		EXPECT_FALSE(preparedRows->step());
+	}
+	sqlite3_close(stringDb);
+	sqlite3_close(preparedDb);
+
+	FileSystem::removeFile(stringFilename);
+	FileSystem::removeFile(preparedFilename);
+	FileSystem::removeFile(dir);
+}
+
+// Push from a producer thread while a consumer thread drains, checking that nothing is lost or reordered
+static void ringBufferProducerConsumer(RingOverflowPolicy policy, size_t capacity, int count, Array<int>& output) {
+	SpscRingBuffer<int> ring(capacity, policy);
+	std::atomic<bool> done{ false };
+	std::thread consumer([&] {
+		while (!done) { ring.popAll(output); }
+		ring.popAll(output);
+	});
+	for (int i = 0; i < count; i++) { ring.push(i); }
+	done = true;
+	consumer.join();
+}
+
+TEST(LoggerQueues, RingBufferBlockKeepsEveryItem) {
+	Array<int> output;
+	ringBufferProducerConsumer(RingOverflowPolicy::Block, 64, 100000, output);
+	ASSERT_EQ(100000, output.size());
+	for (int i = 0; i < output.size(); i++) { EXPECT_EQ(i, output[i]); }
+}
+
+TEST(LoggerQueues, RingBufferSpillKeepsEveryItem) {
+	Array<int> output;
+	ringBufferProducerConsumer(RingOverflowPolicy::Spill, 64, 100000, output);
+	ASSERT_EQ(100000, output.size());
+	for (int i = 0; i < output.size(); i++) { EXPECT_EQ(i, output[i]); }
+}
+
+TEST(LoggerQueues, RingBufferDropOldestKeepsNewestItems) {
+	// Without a consumer, only the newest (capacity) items survive
+	SpscRingBuffer<int> ring(8, RingOverflowPolicy::DropOldest);
+	for (int i = 0; i < 20; i++) { ring.push(i); }
+	Array<int> output;
+	ring.popAll(output);
+	ASSERT_EQ(8, output.size());
+	for (int i = 0; i < output.size(); i++) { EXPECT_EQ(12 + i, output[i]); }
+
+	const RingBufferStats stats = ring.stats();
+	EXPECT_EQ(8, (int)stats.capacity);
+	EXPECT_EQ(8, (int)stats.highWaterMark);
+	EXPECT_EQ(12, (int)stats.dropped);
+
+	// Dropped items are still in order when racing a consumer
+	output.fastClear();
+	ringBufferProducerConsumer(RingOverflowPolicy::DropOldest, 64, 100000, output);
+	for (int i = 1; i < output.size(); i++) { EXPECT_LT(output[i - 1], output[i]); }
+}
+
+TEST(LoggerQueues, RingBufferSpillStats) {
+	SpscRingBuffer<int> ring(4, RingOverflowPolicy::Spill);
+	for (int i = 0; i < 10; i++) { ring.push(i); }
+	const RingBufferStats stats = ring.stats();
+	EXPECT_EQ(4, (int)stats.highWaterMark);
+	EXPECT_EQ(6, (int)stats.spilled);
+	Array<int> output;
+	ring.popAll(output);
+	ASSERT_EQ(10, output.size());
+	for (int i = 0; i < output.size(); i++) { EXPECT_EQ(i, output[i]); }
+}
+
+TEST(LoggerClock, FormatsTimestamps) {
+	const FPSciTimestamp t = 1600000000000042LL;		// 2020-09-13 12:26:40 UTC + 42 usec
+	EXPECT_EQ(String("2020-09-13 12:26:40.000042"), FPSciClock::format(t));
+	EXPECT_EQ(String("2020_09_13-12_26_40"), FPSciClock::formatForFilename(t));
+}
+
+TEST(LoggerClock, ParsesFormattedTimestamps) {
+	const FPSciTimestamp t = 1600000000000042LL;
+	FPSciTimestamp parsed = 0;
+	ASSERT_TRUE(FPSciClock::parse(FPSciClock::format(t), parsed));
+	EXPECT_EQ(t, parsed);
+	ASSERT_TRUE(FPSciClock::parse("2020-09-13 12:26:40", parsed));
+	EXPECT_EQ(1600000000000000LL, parsed);
+	ASSERT_TRUE(FPSciClock::parse("2020-09-13 12:26:40.5", parsed));
+	EXPECT_EQ(1600000000500000LL, parsed);
+	EXPECT_FALSE(FPSciClock::parse("not a time", parsed));
+}
+
+TEST(LoggerClock, IsMonotonic) {
+	FPSciTimestamp last = FPSciClock::now();
+	for (int i = 0; i < 100000; i++) {
+		const FPSciTimestamp t = FPSciClock::now();
+		ASSERT_GE(t, last);
+		last = t;
+	}
+}
+
+TEST(LoggerQueries, PreparedQueryReadsRows) {
+	sqlite3* db = openPlayerActionDb("query_test.db");
+	shared_ptr<PreparedInsert> insert = PreparedInsert::create(db, "Player_Action", 9);
+	for (int i = 0; i < 10; i++) {
+		insert->bindText(format("2020-01-01 00:00:%02d.000000", i)).bindReal(i).bindReal(0).bindReal(0).bindReal(0).bindReal(0)
+			.bindText("trialTask").bindText(i % 2 ? "hit" : "aim").bindText("target").insert();
+	}
+	ASSERT_TRUE(createIndexInDB(db, "Player_Action_time", "Player_Action", "time"));
+
+	shared_ptr<PreparedQuery> query = PreparedQuery::create(db, "SELECT position_az, event FROM Player_Action WHERE time >= ? AND time <= ? ORDER BY time;");
+	ASSERT_TRUE(query->valid());
+	query->bindText("2020-01-01 00:00:03.000000").bindText("2020-01-01 00:00:06.000000");
+	int count = 0;
+	while (query->step()) {
+		EXPECT_EQ(3 + count, (int)query->columnReal(0));
+		EXPECT_EQ(String((3 + count) % 2 ? "hit" : "aim"), query->columnText(1));
+		count++;
+	}
+	EXPECT_EQ(4, count);
+
+	// Run it again w/ a different range
+	query->reset();
+	query->bindText("2020-01-01 00:00:08.000000").bindText("2020-01-01 00:00:20.000000");
+	count = 0;
+	while (query->step()) count++;
+	EXPECT_EQ(2, count);
+
+	query.reset();
+	insert.reset();
+	sqlite3_close(db);
+	FileSystem::removeFile("query_test.db");
+}
+
+TEST(LoggerQueries, AddsMissingColumns) {
+	sqlite3* db = openPlayerActionDb("columns_test.db");
+	const Array<Array<String>> frameInfoColumns = { { "time", "text" }, { "sdt", "real" } };
+	ASSERT_TRUE(createTableInDB(db, "Frame_Info", frameInfoColumns));
+	EXPECT_TRUE(columnExistsInDB(db, "Frame_Info", "sdt"));
+	EXPECT_FALSE(columnExistsInDB(db, "Frame_Info", "wait_ms"));
+	EXPECT_FALSE(columnExistsInDB(db, "Missing_Table", "sdt"));
+
+	// Rows written before the column was added (or w/ NaN values) read back as NULL
+	PreparedInsert::create(db, "Frame_Info", 2)->bindText("2020-01-01 00:00:00.000000").bindReal(0.001).insert();
+	ASSERT_TRUE(execStatementInDB(db, "ALTER TABLE Frame_Info ADD COLUMN wait_ms real;"));
+	EXPECT_TRUE(columnExistsInDB(db, "Frame_Info", "wait_ms"));
+	shared_ptr<PreparedInsert> insert = PreparedInsert::create(db, "Frame_Info", 3, " (time, sdt, wait_ms)");
+	insert->bindText("2020-01-01 00:00:01.000000").bindReal(0.001).bindReal(2.5).insert();
+	insert->bindText("2020-01-01 00:00:02.000000").bindReal(0.001).bindReal(fnan()).insert();
+	insert.reset();
+
+	shared_ptr<PreparedQuery> query = PreparedQuery::create(db, "SELECT wait_ms FROM Frame_Info ORDER BY time;");
+	ASSERT_TRUE(query->step());
+	EXPECT_EQ(SQLITE_NULL, query->columnType(0));
+	ASSERT_TRUE(query->step());
+	EXPECT_EQ(2.5, query->columnReal(0));
+	ASSERT_TRUE(query->step());
+	EXPECT_EQ(SQLITE_NULL, query->columnType(0));
+
+	query.reset();
+	sqlite3_close(db);
+	FileSystem::removeFile("columns_test.db");
+}
+
+/** Replay a journal file, returning the (int) payload of each record */
+static Array<int> replayJournal(const String& filename) {
+	Array<int> values;
+	LogJournal::replay(filename, [&](uint8 type, const uint8* data, uint32 size) {
+		EXPECT_EQ(1, (int)type);
+		ASSERT_EQ(sizeof(int), (size_t)size);
+		int v;
+		memcpy(&v, data, sizeof(v));
+		values.append(v);
+	});
+	return values;
+}
+
+TEST(LoggerJournal, ReplaysUncommittedRecords) {
+	const String filename = "test_journal.fpjournal";
+	{
+		shared_ptr<LogJournal> journal = LogJournal::create(filename, 4096);
+		ASSERT_TRUE(journal->valid());
+		for (int i = 0; i < 100; i++) {
+			ASSERT_TRUE(journal->append(1, (const uint8*)&i, sizeof(i)));
+			if (i == 49) journal->commit(journal->writePosition());
+		}
+		// No close() (as if the process crashed)
+	}
+	const Array<int> values = replayJournal(filename);
+	ASSERT_EQ(50, values.size());
+	for (int i = 0; i < values.size(); i++) { EXPECT_EQ(50 + i, values[i]); }
+	FileSystem::removeFile(filename);
+}
+
+TEST(LoggerJournal, WrapsAndSkipsWhenFull) {
+	const String filename = "test_journal_wrap.fpjournal";
+	{
+		// Small ring (w/ a size that isn't a multiple of the record size) so records wrap several times
+		shared_ptr<LogJournal> journal = LogJournal::create(filename, 100);
+		int i = 0;
+		for (; i < 1000; i++) {
+			ASSERT_TRUE(journal->append(1, (const uint8*)&i, sizeof(i)));
+			journal->commit(journal->writePosition());
+		}
+		// Without commits the ring fills up and further records are skipped
+		for (; i < 1100; i++) journal->append(1, (const uint8*)&i, sizeof(i));
+		EXPECT_LT(0, (int)journal->skippedCount());
+	}
+	const Array<int> values = replayJournal(filename);
+	ASSERT_LT(0, values.size());
+	for (int i = 0; i < values.size(); i++) { EXPECT_EQ(1000 + i, values[i]); }
+	FileSystem::removeFile(filename);
+}
+
+TEST(LoggerJournal, CloseRemovesCommittedJournal) {
+	const String filename = "test_journal_close.fpjournal";
+	shared_ptr<LogJournal> journal = LogJournal::create(filename, 4096);
+	const int v = 42;
+	journal->append(1, (const uint8*)&v, sizeof(v));
+	journal->commit(journal->writePosition());
+	journal->close();
+	EXPECT_FALSE(FileSystem::exists(filename));
+}
+
+TEST(HardwareEvents, ParsesEventLoggerLines) {
+	HardwareEventParser parser;
+	HardwareEvent event;
+	const FPSciTimestamp arrival = 1000000000;
+
+	// The first line soft syncs the device time to its arrival time
+	ASSERT_TRUE(parser.parseLine("1000000:M1", arrival, event));
+	EXPECT_EQ("M1", event.event);
+	EXPECT_EQ(arrival, event.time);
+	EXPECT_EQ(-1, event.clickTime);
+
+	// ADC samples, malformed lines, and bounces aren't events
+	EXPECT_FALSE(parser.parseLine("1001000:512", arrival, event));
+	EXPECT_FALSE(parser.parseLine("garbage", arrival, event));
+	EXPECT_FALSE(parser.parseLine("1002000:XX", arrival, event));
+	EXPECT_FALSE(parser.parseLine("1050000:M1", arrival, event));
+
+	// A photodetector event after the click gives its click-to-photon latency
+	ASSERT_TRUE(parser.parseLine("1020000:PD\r", arrival + 100000, event));
+	EXPECT_EQ("PD", event.event);
+	EXPECT_EQ(arrival + 20000, event.time);
+	EXPECT_EQ(arrival, event.clickTime);
+	EXPECT_FLOAT_EQ(20.0f, event.clickToPhotonMs());
+
+	// But one too long after a click doesn't
+	ASSERT_TRUE(parser.parseLine("2000000:M1", arrival + 1000000, event));
+	ASSERT_TRUE(parser.parseLine("2400000:PD", arrival + 1400000, event));
+	EXPECT_EQ(-1, event.clickTime);
+
+	// The device counter wraps after 2^32 us
+	ASSERT_TRUE(parser.parseLine("4294967000:SW", arrival, event));
+	const FPSciTimestamp beforeWrap = event.time;
+	ASSERT_TRUE(parser.parseLine("200000:SW", arrival, event));
+	EXPECT_EQ(beforeWrap + 200296, event.time);
+}
+
+TEST(HardwareEvents, HardSyncAlignsToSyncEvent) {
+	HardwareEventParser parser;
+	HardwareEvent event;
+	parser.hardSync(5000000);
+	ASSERT_TRUE(parser.parseLine("300:M2", 9000000, event));
+	ASSERT_TRUE(parser.parseLine("1000:SW", 9000000, event));
+	EXPECT_EQ(5000000, event.time);
+	ASSERT_TRUE(parser.parseLine("201000:M1", 1000, event));		// Arrival times are ignored once synced
+	EXPECT_EQ(5200000, event.time);
+}
+
+/** Write lines to a file standing in for the event logger (like event_logger_emulator.py) */
+static void emulateEvents(const String& filename, const Array<String>& lines) {
+	FILE* f = fopen(filename.c_str(), "ab");
+	for (const String& line : lines) fprintf(f, "%s\n", line.c_str());
+	fclose(f);
+}
+
+/** Wait (up to a few seconds) for the reader thread to receive count events */
+static void waitForEvents(std::mutex& mutex, const Array<HardwareEvent>& events, int count) {
+	for (int i = 0; i < 300; i++) {
+		{
+			std::lock_guard<std::mutex> lk(mutex);
+			if (events.size() >= count) return;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+
+TEST(HardwareEvents, ReadsEventsFromFileStandIn) {
+	const String filename = "test_event_logger.txt";
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+	emulateEvents(filename, {});
+
+	std::mutex mutex;
+	Array<HardwareEvent> events;
+	shared_ptr<HardwareEventLogger> eventLogger = HardwareEventLogger::create(filename);
+	ASSERT_TRUE(eventLogger->valid());
+	eventLogger->setCallback([&](const HardwareEvent& event) {
+		std::lock_guard<std::mutex> lk(mutex);
+		events.append(event);
+	});
+
+	emulateEvents(filename, { "1000000:M1", "1000500:100", "1015000:PD" });
+	emulateEvents(filename, { "3000000:M2" });
+	waitForEvents(mutex, events, 3);
+	eventLogger->setCallback(nullptr);
+
+	std::lock_guard<std::mutex> lk(mutex);
+	ASSERT_EQ(3, events.size());
+	EXPECT_EQ("M1", events[0].event);
+	EXPECT_EQ("PD", events[1].event);
+	EXPECT_FLOAT_EQ(15.0f, events[1].clickToPhotonMs());
+	EXPECT_EQ("M2", events[2].event);
+	EXPECT_EQ(2000000, events[2].time - events[0].time);
+	eventLogger.reset();
+	FileSystem::removeFile(filename);
+}
+
+#ifndef _WIN32
+TEST(HardwareEvents, ReadsEventsFromPseudoTerminal) {
+	const int master = posix_openpt(O_RDWR | O_NOCTTY);
+	ASSERT_LE(0, master);
+	ASSERT_EQ(0, grantpt(master));
+	ASSERT_EQ(0, unlockpt(master));
+
+	std::mutex mutex;
+	Array<HardwareEvent> events;
+	shared_ptr<HardwareEventLogger> eventLogger = HardwareEventLogger::create(ptsname(master));
+	ASSERT_TRUE(eventLogger->valid());
+	eventLogger->setCallback([&](const HardwareEvent& event) {
+		std::lock_guard<std::mutex> lk(mutex);
+		events.append(event);
+	});
+
+	// The reader turns off ADC reporting when it opens the port
+	char command[16] = {};
+	ASSERT_EQ(5, (int)read(master, command, 5));
+	EXPECT_EQ(String("aoff\n"), String(command));
+
+	// Lines can be split across reads
+	const String data = "500:SW\n700000:M1\n7";
+	ASSERT_EQ((ssize_t)data.size(), write(master, data.c_str(), data.size()));
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	ASSERT_EQ(5, (int)write(master, "30000", 5));
+	ASSERT_EQ(5, (int)write(master, ":PD\r\n", 5));
+	waitForEvents(mutex, events, 3);
+	eventLogger.reset();
+	close(master);
+
+	ASSERT_EQ(3, events.size());
+	EXPECT_EQ("SW", events[0].event);
+	EXPECT_EQ("M1", events[1].event);
+	EXPECT_EQ("PD", events[2].event);
+	EXPECT_FLOAT_EQ(30.0f, events[2].clickToPhotonMs());
+}
+#endif
+
+/** Write a (minimal) experiment config for the Experiments table of the results files the logger tests create */
+static ExperimentInfo createTestExperiment() {
+	const String filename = "test_logger_experimentconfig.Any";
+	writeWholeFile(filename, "{ description = \"Logger test\"; }");
+	return { filename, "Logger test", "0" };
+}
+
+static shared_ptr<SessionConfig> createTestSessionConfig(const String& id) {
+	shared_ptr<SessionConfig> sessConfig = createShared<SessionConfig>();
+	sessConfig->id = id;
+	return sessConfig;
+}
+
+static TrialValues createTestTrial(int trialIndex, FPSciTimestamp startTime, FPSciTimestamp endTime) {
+	TrialValues trial;
+	trial.trialIndex = trialIndex;
+	trial.block = 1;
+	trial.startTime = startTime;
+	trial.endTime = endTime;
+	return trial;
+}
+
+/** Remove a results file (and any files SQLite left alongside it) */
+static void removeResultsFile(const String& filename) {
+	for (const char* suffix : { "", "-journal", "-wal", "-shm" }) {
+		if (FileSystem::exists(filename + suffix)) FileSystem::removeFile(filename + suffix);
+	}
+}
+
+TEST(LoggerSessions, LogsSessionsWithOneLogger) {
+	const String filename = "test_logger_sessions.db";
+	removeResultsFile(filename);
+	shared_ptr<SessionConfig> sess1 = createTestSessionConfig("sess1");
+	shared_ptr<SessionConfig> sess2 = createTestSessionConfig("sess2");
+	{
+		shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "subject", createTestExperiment(), sess1, "First session");
+		FPSciTimestamp t = FPSciClock::now();
+		logger->logTrial(createTestTrial(0, t, t + 1000));
+		logger->logTrial(createTestTrial(1, t + 1000, t + 2000));
+
+		// The same file and logger settings reuse the logger
+		ASSERT_TRUE(logger->canLogSession(filename, sess2->logger));
+		logger->beginSession("subject", sess2, "Second session");
+		t = FPSciClock::now();
+		logger->logTrial(createTestTrial(0, t, t + 1000));
+		logger->endSession();
+
+		// But a different file or logger config needs a new logger
+		EXPECT_FALSE(logger->canLogSession("test_logger_other.db", sess2->logger));
+		LoggerConfig changed = sess2->logger;
+		changed.timestampFormat = "integer";
+		EXPECT_FALSE(logger->canLogSession(filename, changed));
+		changed = sess2->logger;
+		changed.queueCapacity *= 2;
+		EXPECT_FALSE(logger->canLogSession(filename, changed));
+	}
+
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	{
+		shared_ptr<PreparedQuery> sessions = PreparedQuery::create(db, "SELECT session_id FROM Sessions ORDER BY start_time;");
+		ASSERT_TRUE(sessions->step());
+		EXPECT_EQ("sess1", sessions->columnText(0));
+		ASSERT_TRUE(sessions->step());
+		EXPECT_EQ("sess2", sessions->columnText(0));
+		EXPECT_FALSE(sessions->step());
+
+		// Each trial is logged w/ the session it was logged in
+		shared_ptr<PreparedQuery> trials = PreparedQuery::create(db, "SELECT session_id, COUNT(*) FROM Trials GROUP BY session_id ORDER BY session_id;");
+		ASSERT_TRUE(trials->step());
+		EXPECT_EQ("sess1", trials->columnText(0));
+		EXPECT_EQ(2, trials->columnInt(1));
+		ASSERT_TRUE(trials->step());
+		EXPECT_EQ("sess2", trials->columnText(0));
+		EXPECT_EQ(1, trials->columnInt(1));
+		EXPECT_FALSE(trials->step());
+	}
+	sqlite3_close(db);
+	removeResultsFile(filename);
+}
+
+TEST(LoggerSessions, SummarizesTrials) {
+	const String filename = "test_logger_summary.db";
+	removeResultsFile(filename);
+	{
+		shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "subject", createTestExperiment(), createTestSessionConfig("summary"), "Summary session");
+		const FPSciTimestamp t = FPSciClock::now() + 1000;
+		const FPSciTimestamp ms = 1000;
+
+		// Trial 0: a target 45 degrees from the view direction, aimed at, missed, hit, then destroyed
+		logger->logTargetLocation(TargetLocation(t + 10 * ms, "target", PresentationState::trialTask, Point3(10.0f, 0.0f, -10.0f)));
+		logger->logPlayerAction(PlayerAction(t + 50 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialTask, PlayerActionType::Aim, ""));
+		logger->logPlayerAction(PlayerAction(t + 100 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialTask, PlayerActionType::Miss, ""));
+		logger->logPlayerAction(PlayerAction(t + 200 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialTask, PlayerActionType::Hit, "target"));
+		logger->logPlayerAction(PlayerAction(t + 300 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialTask, PlayerActionType::Destroy, "target"));
+		// An aim sample after the target is destroyed has nothing to measure the error to
+		logger->logPlayerAction(PlayerAction(t + 400 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialTask, PlayerActionType::Aim, ""));
+		logger->logTrial(createTestTrial(0, t, t + 1000 * ms));
+
+		// Trial 1: a single miss
+		logger->logPlayerAction(PlayerAction(t + 2500 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialTask, PlayerActionType::Miss, ""));
+		logger->logTrial(createTestTrial(1, t + 2000 * ms, t + 3000 * ms));
+
+		// Actions outside of a trial aren't counted
+		logger->logPlayerAction(PlayerAction(t + 1500 * ms, Point2(0.0f, 0.0f), Point3::zero(), PresentationState::trialFeedback, PlayerActionType::Miss, ""));
+		logger->endSession();
+	}
+
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	{
+		shared_ptr<PreparedQuery> summary = PreparedQuery::create(db,
+			"SELECT session_id, trial_index, shots, hits, time_to_first_hit, mean_aim_error, aim_samples FROM Trial_Summary ORDER BY trial_index;");
+		ASSERT_TRUE(summary->valid());
+		ASSERT_TRUE(summary->step());
+		EXPECT_EQ("summary", summary->columnText(0));
+		EXPECT_EQ(0, summary->columnInt(1));
+		EXPECT_EQ(3, summary->columnInt(2));
+		EXPECT_EQ(2, summary->columnInt(3));
+		EXPECT_NEAR(0.2, summary->columnReal(4), 1e-6);
+		EXPECT_NEAR(45.0, summary->columnReal(5), 1e-3);
+		EXPECT_EQ(1, summary->columnInt(6));
+
+		ASSERT_TRUE(summary->step());
+		EXPECT_EQ(1, summary->columnInt(1));
+		EXPECT_EQ(1, summary->columnInt(2));
+		EXPECT_EQ(0, summary->columnInt(3));
+		EXPECT_EQ(SQLITE_NULL, summary->columnType(4));
+		EXPECT_EQ(SQLITE_NULL, summary->columnType(5));
+		EXPECT_EQ(0, summary->columnInt(6));
+		EXPECT_FALSE(summary->step());
+	}
+	sqlite3_close(db);
+	removeResultsFile(filename);
+}
+
+/** Count the rows of a table in a (running) logger's results file (using a separate connection from the logger's) */
+static int64 countLoggedRows(const String& filename, const String& tableName) {
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	sqlite3_busy_timeout(db, 1000);
+	const int64 count = countRows(db, tableName);
+	sqlite3_close(db);
+	return count;
+}
+
+TEST(LoggerFlush, FlushFencesWaitForQueuedRecords) {
+	const String filename = "test_logger_flush.db";
+	removeResultsFile(filename);
+	{
+		shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "subject", createTestExperiment(), createTestSessionConfig("flush"), "Flush session");
+		const FPSciTimestamp t = FPSciClock::now();
+
+		// A blocking flush returns once everything logged before it is in the results file
+		for (int i = 0; i < 1000; i++) logger->logFrameInfo(FrameInfo(t + i, 0.001f));
+		logger->flush(true);
+		EXPECT_EQ(1000, countLoggedRows(filename, "Frame_Info"));
+
+		// Likewise for the future returned by an async flush (and any requested before it)
+		for (int i = 1000; i < 2000; i++) logger->logFrameInfo(FrameInfo(t + i, 0.001f));
+		std::future<void> first = logger->flushAsync();
+		for (int i = 2000; i < 3000; i++) logger->logFrameInfo(FrameInfo(t + i, 0.001f));
+		std::future<void> second = logger->flushAsync();
+		ASSERT_EQ(std::future_status::ready, second.wait_for(std::chrono::seconds(10)));
+		EXPECT_EQ(std::future_status::ready, first.wait_for(std::chrono::seconds(0)));
+		EXPECT_EQ(3000, countLoggedRows(filename, "Frame_Info"));
+		EXPECT_EQ(3000, logger->flushStats().rowCount);
+	}
+	removeResultsFile(filename);
+}
+
+// Replaying a journal whose records are already in the results file (i.e. left by a crash after a flush committed but before
+// the journal was marked committed) doesn't write them again
+TEST(LoggerJournal, ReplaySkipsRecordsInResultsFile) {
+	const String filename = "test_logger_journal.db";
+	const String journalFilename = "test_logger_journal.fpjournal";
+	removeResultsFile(filename);
+	shared_ptr<SessionConfig> sessConfig = createTestSessionConfig("journal");
+	sessConfig->logger.logRecoveryJournal = true;
+	sessConfig->logger.recoveryJournalSizeMB = 1;
+	String journal;
+	{
+		shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "subject", createTestExperiment(), sessConfig, "Journal session");
+		const FPSciTimestamp t = FPSciClock::now();
+		for (int i = 0; i < 100; i++) logger->logFrameInfo(FrameInfo(t + i, 0.001f));
+		logger->flush(true);
+		ASSERT_TRUE(FileSystem::exists(journalFilename));
+		journal = readWholeFile(journalFilename);
+	}
+	EXPECT_EQ(100, countLoggedRows(filename, "Frame_Info"));
+
+	// Restore the journal w/ nothing marked committed
+	ASSERT_GE(journal.size(), sizeof(LogJournal::Header));
+	const uint64 committedPos = 0;
+	memcpy(&journal[offsetof(LogJournal::Header, committedPos)], &committedPos, sizeof(committedPos));
+	writeWholeFile(journalFilename, journal);
+
+	// Opening the results file again replays the journal, then new records are journaled (and written) as usual
+	{
+		shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "subject", createTestExperiment(), sessConfig, "Journal session");
+		EXPECT_EQ(100, countLoggedRows(filename, "Frame_Info"));
+		logger->logFrameInfo(FrameInfo(FPSciClock::now(), 0.001f));
+	}
+	EXPECT_EQ(101, countLoggedRows(filename, "Frame_Info"));
+	EXPECT_FALSE(FileSystem::exists(journalFilename));
+	removeResultsFile(filename);
+}
+
+/** Read a column of a results file table as text (in time order) */
+static Array<String> readResultsColumn(const String& filename, const String& tableName, const String& column) {
+	Array<String> values;
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	{
+		shared_ptr<PreparedQuery> query = PreparedQuery::create(db, "SELECT " + column + " FROM " + tableName + " ORDER BY time;");
+		while (query->step()) values.append(query->columnText(0));
+	}
+	sqlite3_close(db);
+	return values;
+}
+
+TEST(LoggerSchema, IntegerTimestampViewsMatchTextTables) {
+	const Array<FPSciTimestamp> times = { 1600000000000042LL, 1600000000999999LL, 1600000001000000LL, 1600000059123456LL };
+	const String textFilename = "test_logger_text.db";
+	const String integerFilename = "test_logger_integer.db";
+	for (const String& filename : { textFilename, integerFilename }) {
+		removeResultsFile(filename);
+		shared_ptr<SessionConfig> sessConfig = createTestSessionConfig("schema");
+		sessConfig->logger.timestampFormat = (filename == integerFilename) ? "integer" : "text";
+		shared_ptr<FPSciLogger> logger = FPSciLogger::create(filename, "subject", createTestExperiment(), sessConfig, "Schema session");
+		for (const FPSciTimestamp t : times) {
+			logger->logFrameInfo(FrameInfo(t, 0.001f));
+			logger->logPlayerAction(PlayerAction(t, Point2(1.0f, 2.0f), Point3(3.0f, 4.0f, 5.0f), PresentationState::trialTask, PlayerActionType::Aim, ""));
+			logger->logTargetLocation(TargetLocation(t, "target", PresentationState::trialTask, Point3(6.0f, 7.0f, 8.0f)));
+		}
+	}
+
+	// The integer schema stores usec in the "_Raw" tables and formats them in a view w/ the original table name
+	for (const String& table : { "Frame_Info", "Player_Action", "Target_Trajectory" }) {
+		const Array<String> textTimes = readResultsColumn(textFilename, table, "time");
+		const Array<String> viewTimes = readResultsColumn(integerFilename, table, "time");
+		ASSERT_EQ(times.size(), textTimes.size());
+		ASSERT_EQ(times.size(), viewTimes.size());
+		for (int i = 0; i < times.size(); i++) {
+			EXPECT_EQ(FPSciClock::format(times[i]), textTimes[i]);
+			EXPECT_EQ(textTimes[i], viewTimes[i]);
+		}
+		EXPECT_EQ(times.size(), readResultsColumn(integerFilename, String(table) + "_Raw", "time").size());
+	}
+	const Array<String> textAz = readResultsColumn(textFilename, "Player_Action", "position_az");
+	const Array<String> viewAz = readResultsColumn(integerFilename, "Player_Action", "position_az");
+	ASSERT_EQ(textAz.size(), viewAz.size());
+	for (int i = 0; i < textAz.size(); i++) EXPECT_EQ(textAz[i], viewAz[i]);
+
+	removeResultsFile(textFilename);
+	removeResultsFile(integerFilename);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <RandomStream.h>
+
+TEST(RandomStream, IsDeterministic) {
+	RandomStream a(1234);
+	RandomStream b(1234);
+	RandomStream c(1235);
+	int matches = 0;
+	for (int i = 0; i < 1000; i++) {
+		const uint64 bits = a.bits();
+		EXPECT_EQ(bits, b.bits());
+		if (bits == c.bits()) matches++;
+	}
+	EXPECT_EQ(matches, 0);
+}
+
+TEST(RandomStream, ChildrenAreIndependent) {
+	const RandomStream parent(42);
+
+	// Children only depend on the parent's seed and the id (not on draws from the parent or other children)
+	RandomStream drawn(42);
+	for (int i = 0; i < 100; i++) drawn.bits();
+	RandomStream first = parent.child(3);
+	RandomStream second = drawn.child(3);
+	for (int i = 0; i < 100; i++) EXPECT_EQ(first.bits(), second.bits());
+
+	EXPECT_NE(parent.child(0).seed(), parent.child(1).seed());
+	EXPECT_NE(parent.child("motion").seed(), parent.child("spawn").seed());
+	EXPECT_EQ(parent.child("weapon").seed(), RandomStream(42).child("weapon").seed());
+	EXPECT_NE(parent.child(1).child(0).seed(), parent.child(0).child(1).seed());
+}
+
+TEST(RandomStream, DrawsInRange) {
+	RandomStream random(7);
+	const AABox box(Point3(-1, 2, -3), Point3(1, 4, 3));
+	float sum = 0.0f;
+	for (int i = 0; i < 10000; i++) {
+		const float u = random.uniform(-2.0f, 3.0f);
+		EXPECT_GE(u, -2.0f);
+		EXPECT_LT(u, 3.0f);
+		sum += u;
+
+		const int n = random.integer(2, 5);
+		EXPECT_GE(n, 2);
+		EXPECT_LE(n, 5);
+
+		const float s = random.sign();
+		EXPECT_TRUE(s == 1.0f || s == -1.0f);
+
+		EXPECT_NEAR(random.unitVector().length(), 1.0f, 1e-5f);
+
+		const Point3 p = random.interiorPoint(box);
+		EXPECT_TRUE(p.x >= -1 && p.x <= 1 && p.y >= 2 && p.y <= 4 && p.z >= -3 && p.z <= 3);
+	}
+	EXPECT_NEAR(sum / 10000.0f, 0.5f, 0.1f);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <sqlHelpers.h>
+#include <ResultsMerger.h>
+
+/** Create a (minimal) results file w/ an Experiments row and some sessions */
+static void createMergeInput(const String& filename, const String& hash, const Array<String>& sessionIds, bool extraColumn) {
+	if (FileSystem::exists(filename)) FileSystem::removeFile(filename);
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	createTableInDB(db, "Experiments", { { "description", "text" }, { "hash", "text" } });
+	insertRowIntoDB(db, "Experiments", { "'Merge test'", "'" + hash + "'" });
+	if (extraColumn) createTableInDB(db, "Sessions", { { "session_id", "text" }, { "trials_complete", "integer" }, { "'frameRate'", "text" } });
+	else createTableInDB(db, "Sessions", { { "session_id", "text" }, { "trials_complete", "integer" } });
+	for (const String& id : sessionIds) {
+		if (extraColumn) insertRowIntoDB(db, "Sessions", { "'" + id + "'", "3", "'240'" });
+		else insertRowIntoDB(db, "Sessions", { "'" + id + "'", "3" });
+	}
+	sqlite3_close(db);
+}
+
+/** Count the rows of a table in a results file */
+static int64 countResultsRows(const String& filename, const String& tableName) {
+	sqlite3* db = nullptr;
+	sqlite3_open(filename.c_str(), &db);
+	sqlite3_stmt* stmt = nullptr;
+	sqlite3_prepare_v2(db, ("SELECT COUNT(*) FROM " + tableName + ";").c_str(), -1, &stmt, nullptr);
+	sqlite3_step(stmt);
+	const int64 count = sqlite3_column_int64(stmt, 0);
+	sqlite3_finalize(stmt);
+	sqlite3_close(db);
+	return count;
+}
+
+TEST(ResultsMerge, DeduplicatesExperimentsAndAddsProvenance) {
+	const Array<String> inputs = { "test_merge_a.db", "test_merge_b.db", "test_merge_c.db" };
+	createMergeInput(inputs[0], "0x1", { "s1", "s2" }, false);
+	createMergeInput(inputs[1], "0x1", { "s3" }, true);
+	createMergeInput(inputs[2], "0x2", { "s4" }, false);
+
+	const String output = "test_merge_out.db";
+	ResultsMergeStats stats;
+	{
+		shared_ptr<ResultsMerger> merger = ResultsMerger::create(output, 2);
+		stats = merger->merge(inputs);
+	}
+	EXPECT_EQ(3, stats.filesMerged);
+	EXPECT_EQ(0, stats.filesFailed);
+	EXPECT_EQ(1, stats.duplicateExperiments);
+	EXPECT_EQ(2, countResultsRows(output, "Experiments"));
+	EXPECT_EQ(4, countResultsRows(output, "Sessions"));
+	EXPECT_EQ(3, countResultsRows(output, "Merged_Files"));
+
+	sqlite3* db = nullptr;
+	sqlite3_open(output.c_str(), &db);
+	{
+		shared_ptr<PreparedQuery> experiments = PreparedQuery::create(db, "SELECT hash, source_file FROM Experiments ORDER BY hash;");
+		ASSERT_TRUE(experiments->step());
+		EXPECT_EQ("0x1", experiments->columnText(0));
+		EXPECT_EQ(inputs[0], experiments->columnText(1));
+		ASSERT_TRUE(experiments->step());
+		EXPECT_EQ("0x2", experiments->columnText(0));
+		EXPECT_FALSE(experiments->step());
+
+		// Sessions from every input, w/ the union of their columns
+		shared_ptr<PreparedQuery> sessions = PreparedQuery::create(db, "SELECT session_id, frameRate, source_file FROM Sessions ORDER BY session_id;");
+		const Array<String> ids = { "s1", "s2", "s3", "s4" };
+		for (int i = 0; i < ids.size(); i++) {
+			ASSERT_TRUE(sessions->step());
+			EXPECT_EQ(ids[i], sessions->columnText(0));
+			EXPECT_EQ(i == 2, !sessions->columnIsNull(1));
+		}
+		EXPECT_FALSE(sessions->step());
+
+		// Each input's experiment is recorded in Merged_Files (even when its row was deduplicated)
+		shared_ptr<PreparedQuery> files = PreparedQuery::create(db, "SELECT source_file, experiment_hash, row_count FROM Merged_Files ORDER BY source_file;");
+		ASSERT_TRUE(files->step());
+		EXPECT_EQ(inputs[0], files->columnText(0));
+		EXPECT_EQ(3, files->columnInt(2));
+		ASSERT_TRUE(files->step());
+		EXPECT_EQ("0x1", files->columnText(1));
+		EXPECT_EQ(1, files->columnInt(2));
+	}
+	sqlite3_close(db);
+	for (const String& input : inputs) FileSystem::removeFile(input);
+	FileSystem::removeFile(output);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <G3D/G3D.h>
+#include <WaypointPath.h>
+
+/** A long recorded-style path (points on a circle every 10 ms) */
+static Array<Destination> circlePath(int count) {
+	Array<Destination> dests;
+	for (int i = 0; i < count; i++) {
+		const float angle = 0.01f * i;
+		dests.append(Destination(Point3(cosf(angle), 0.5f, sinf(angle)), 0.01 * i));
+	}
+	return dests;
+}
+
+TEST(WaypointPath, FindsSegments) {
+	const Array<Destination> dests = circlePath(20000);
+	WaypointPath path(dests);
+	EXPECT_EQ(path.findSegment(-1.0), -1);
+	EXPECT_EQ(path.findSegment(dests.last().time), dests.size() - 1);
+
+	// Sequential, backward, and random times all find the segment a scan would
+	Random rng(7, false);
+	for (int i = 0; i < 2000; i++) {
+		const SimTime time = (i < 1000) ? i * 0.0013 : rng.uniform(0.0f, (float)dests.last().time);
+		int expected = 0;
+		while (expected + 1 < dests.size() && dests[expected + 1].time <= time) expected++;
+		EXPECT_EQ(path.findSegment(time), expected);
+	}
+}
+
+TEST(WaypointPath, Interpolates) {
+	Array<Destination> dests;
+	dests.append(Destination(Point3(0, 0, 0), 0.0));
+	dests.append(Destination(Point3(1, 0, 0), 1.0));
+	dests.append(Destination(Point3(1, 2, 0), 2.0));
+	dests.append(Destination(Point3(1, 2, 0), 3.0));		// Stationary segment
+	dests.append(Destination(Point3(0, 2, 4), 4.0));
+
+	for (PathInterpolation interpolation : { PathInterpolation::Linear, PathInterpolation::CatmullRom, PathInterpolation::Hermite }) {
+		WaypointPath path(dests, interpolation);
+
+		// Passes through each destination (at its time)
+		for (int i = 0; i < dests.size() - 1; i++) {
+			EXPECT_LT((path.evaluate(dests[i].time) - dests[i].position).length(), 1e-4f);
+		}
+		// Holds still for stationary segments
+		EXPECT_LT((path.evaluate(2.5) - Point3(1, 2, 0)).length(), 1e-4f);
+		// Is continuous
+		for (SimTime t = 0.0; t < 4.0; t += 0.01) {
+			EXPECT_LT((path.evaluate(t + 0.001) - path.evaluate(t)).length(), 0.05f);
+		}
+	}
+
+	// Linear interpolation matches the previous (per-segment lerp) behavior
+	WaypointPath linear(dests);
+	EXPECT_LT((linear.evaluate(0.25) - Point3(0.25f, 0, 0)).length(), 1e-5f);
+	EXPECT_LT((linear.evaluate(3.5) - Point3(0.5f, 2, 2)).length(), 1e-5f);
+}
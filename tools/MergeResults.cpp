@@ -0,0 +1,53 @@
+/** FPSci results merger
+
+	Merges many FPSci results files (e.g. the per session, per user files written when "logToSingleDb" is false) into a
+	single database, reading the inputs in parallel. Experiments rows are deduplicated by hash and every row records the
+	file it came from (see docs/resultsFiles.md).
+
+	Usage: FPSci.merge [name=value ...] <results file or directory> ... where directories are searched (recursively) for
+	.db files and the (optional) parameters are:
+		out=merged.db		Merged results file to write (replaced if it exists)
+		threads=0			Number of threads reading input files (0 to use the hardware concurrency)
+*/
+#include <G3D/G3D.h>
+#include "ResultsMerger.h"
+
+G3D_START_AT_MAIN();
+
+int main(int argc, const char** argv) {
+	String outputFilename = "merged.db";
+	int threadCount = 0;
+	Array<String> paths;
+	for (int i = 1; i < argc; i++) {
+		const String arg = argv[i];
+		const size_t eq = arg.find('=');
+		if (eq == String::npos) {
+			paths.append(arg);
+			continue;
+		}
+		const String name = arg.substr(0, eq);
+		const String value = arg.substr(eq + 1);
+		if (name == "out") outputFilename = value;
+		else if (name == "threads") threadCount = std::stoi(value.c_str());
+		else consolePrintf("Ignoring unknown parameter \"%s\"\n", name.c_str());
+	}
+
+	// Don't merge a previous output into itself
+	Array<String> inputs = ResultsMerger::findResultsFiles(paths);
+	for (int i = inputs.size() - 1; i >= 0; i--) {
+		if (FilePath::canonicalize(inputs[i]) == FilePath::canonicalize(outputFilename)) inputs.remove(i);
+	}
+	if (inputs.size() == 0) {
+		consolePrintf("Usage: FPSci.merge [out=merged.db] [threads=0] <results file or directory> ...\n");
+		return 1;
+	}
+
+	consolePrintf("Merging %d results files into %s...\n", inputs.size(), outputFilename.c_str());
+	shared_ptr<ResultsMerger> merger = ResultsMerger::create(outputFilename, threadCount);
+	const ResultsMergeStats stats = merger->merge(inputs);
+
+	consolePrintf("Merged %d files (%d unreadable), %lld rows in %.3f s (%.0f rows/s)\n", stats.filesMerged, stats.filesFailed,
+		(long long)stats.rowCount, stats.totalSecs, stats.totalSecs > 0.0 ? stats.rowCount / stats.totalSecs : 0.0);
+	consolePrintf("Skipped %d duplicate Experiments rows\n", stats.duplicateExperiments);
+	return stats.filesFailed > 0 ? 2 : 0;
+}